@@ -57,6 +57,7 @@
 #include "globals.h"
 #include "maillist.h"
 #include "muttlib.h"
+#include "names.h"
 #include "reverse.h"
 
 struct AliasList Aliases = TAILQ_HEAD_INITIALIZER(Aliases); ///< List of all the user's email aliases
@@ -276,14 +277,8 @@ static bool string_is_address(const char *str, const char *user, const char *dom
  */
 struct AddressList *alias_lookup(const char *name)
 {
-  struct Alias *a = NULL;
-
-  TAILQ_FOREACH(a, &Aliases, entries)
-  {
-    if (mutt_istr_equal(name, a->name))
-      return &a->addr;
-  }
-  return NULL;
+  struct Alias *a = alias_names_lookup(name);
+  return a ? &a->addr : NULL;
 }
 
 /**
@@ -509,6 +504,7 @@ retry_name:
   }
 
   alias_reverse_add(alias);
+  alias_names_add(alias);
   TAILQ_INSERT_TAIL(&Aliases, alias, entries);
 
   const char *const c_alias_file = cs_subset_path(sub, "alias_file");
@@ -711,6 +707,7 @@ void aliaslist_clear(struct AliasList *al)
 void alias_init(void)
 {
   alias_reverse_init();
+  alias_names_init();
 }
 
 /**
@@ -725,4 +722,5 @@ void alias_cleanup(void)
   }
   aliaslist_clear(&Aliases);
   alias_reverse_shutdown();
+  alias_names_shutdown();
 }
@@ -94,6 +94,7 @@
 #include "functions.h"
 #include "gui.h"
 #include "mutt_logging.h"
+#include "names.h"
 
 /// Help Bar for the Alias dialog (address book)
 static const struct Mapping AliasHelp[] = {
@@ -343,24 +344,18 @@ int alias_complete(struct Buffer *buf, struct ConfigSubset *sub)
 
   if (buf_at(buf, 0) != '\0')
   {
-    TAILQ_FOREACH(np, &Aliases, entries)
+    /* The matches are sorted, so the first and last share the least */
+    size_t num = 0;
+    struct Alias **matches = alias_names_prefix(buf_string(buf), &num);
+    if (num > 0)
     {
-      if (np->name && mutt_strn_equal(np->name, buf_string(buf), buf_len(buf)))
-      {
-        if (bestname[0] == '\0') /* init */
-        {
-          mutt_str_copy(bestname, np->name,
-                        MIN(mutt_str_len(np->name) + 1, sizeof(bestname)));
-        }
-        else
-        {
-          int i;
-          for (i = 0; np->name[i] && (np->name[i] == bestname[i]); i++)
-            ; // do nothing
+      const char *first = matches[0]->name;
+      const char *last = matches[num - 1]->name;
+      size_t i;
+      for (i = 0; first[i] && (first[i] == last[i]) && (i < (sizeof(bestname) - 1)); i++)
+        bestname[i] = first[i];
 
-          bestname[i] = '\0';
-        }
-      }
+      bestname[i] = '\0';
     }
 
     if (bestname[0] == '\0')
@@ -441,6 +436,7 @@ done:
       continue;
 
     TAILQ_REMOVE(&Aliases, avp->alias, entries);
+    alias_names_delete(avp->alias);
     alias_free(&avp->alias);
   }
 
@@ -500,6 +496,7 @@ done:
     if (avp->is_deleted)
     {
       TAILQ_REMOVE(&Aliases, avp->alias, entries);
+      alias_names_delete(avp->alias);
       alias_free(&avp->alias);
     }
   }
@@ -0,0 +1,191 @@
+/**
+ * @file
+ * Manage alias name lookups
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page alias_names Alias name lookups
+ *
+ * Manage alias name lookups
+ *
+ * Two indexes of the Aliases are kept:
+ * - A Hash Table of names, for exact (case-insensitive) lookups
+ * - An Array of Aliases sorted by name, for prefix (completion) lookups
+ *
+ * The sorted Array is rebuilt from the Aliases list when it's next needed, if
+ * an Alias is deleted, or one is added out of order.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "names.h"
+#include "alias.h"
+
+ARRAY_HEAD(AliasPtrArray, struct Alias *);
+
+static struct HashTable *AliasNames = NULL; ///< Hash Table of aliases (name -> alias)
+static struct AliasPtrArray SortedAliases = ARRAY_HEAD_INITIALIZER; ///< Aliases sorted by name
+static bool SortedAliasesValid = false; ///< Does SortedAliases match the Aliases list?
+
+/**
+ * alias_sort_ptr_name - Compare two Aliases by their names - Implements ::sort_t - @ingroup sort_api
+ */
+static int alias_sort_ptr_name(const void *a, const void *b, void *sdata)
+{
+  const struct Alias *alias_a = *(struct Alias const *const *) a;
+  const struct Alias *alias_b = *(struct Alias const *const *) b;
+
+  return strcmp(alias_a->name, alias_b->name);
+}
+
+/**
+ * sorted_aliases_rebuild - Rebuild the sorted Array from the Aliases list
+ */
+static void sorted_aliases_rebuild(void)
+{
+  ARRAY_SHRINK(&SortedAliases, ARRAY_SIZE(&SortedAliases));
+
+  struct Alias *np = NULL;
+  TAILQ_FOREACH(np, &Aliases, entries)
+  {
+    if (np->name)
+      ARRAY_ADD(&SortedAliases, np);
+  }
+
+  ARRAY_SORT(&SortedAliases, alias_sort_ptr_name, NULL);
+  SortedAliasesValid = true;
+}
+
+/**
+ * alias_names_init - Set up the Alias name indexes
+ */
+void alias_names_init(void)
+{
+  AliasNames = mutt_hash_new(1031, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+  SortedAliasesValid = true;
+}
+
+/**
+ * alias_names_shutdown - Clear up the Alias name indexes
+ */
+void alias_names_shutdown(void)
+{
+  mutt_hash_free(&AliasNames);
+  ARRAY_FREE(&SortedAliases);
+  SortedAliasesValid = false;
+}
+
+/**
+ * alias_names_add - Add a name lookup for an Alias
+ * @param alias Alias to use
+ */
+void alias_names_add(struct Alias *alias)
+{
+  if (!alias || !alias->name)
+    return;
+
+  mutt_hash_insert(AliasNames, alias->name, alias);
+
+  if (!SortedAliasesValid)
+    return;
+
+  /* Alias files are often sorted, so appending keeps the Array in order */
+  struct Alias **last = ARRAY_LAST(&SortedAliases);
+  if (!last || (strcmp((*last)->name, alias->name) <= 0))
+    ARRAY_ADD(&SortedAliases, alias);
+  else
+    SortedAliasesValid = false;
+}
+
+/**
+ * alias_names_delete - Remove a name lookup for an Alias
+ * @param alias Alias to use
+ */
+void alias_names_delete(struct Alias *alias)
+{
+  if (!alias || !alias->name)
+    return;
+
+  mutt_hash_delete(AliasNames, alias->name, alias);
+  SortedAliasesValid = false;
+}
+
+/**
+ * alias_names_lookup - Find an Alias by name
+ * @param name Alias name to find
+ * @retval ptr  Matching Alias
+ * @retval NULL No such Alias
+ *
+ * @note The search is case-insensitive
+ */
+struct Alias *alias_names_lookup(const char *name)
+{
+  if (!name)
+    return NULL;
+
+  return mutt_hash_find(AliasNames, name);
+}
+
+/**
+ * alias_names_prefix - Find the Aliases whose names start with a string
+ * @param[in]  prefix Start of the Alias name
+ * @param[out] num    Number of matching Aliases
+ * @retval ptr  First matching Alias, the rest follow in name order
+ * @retval NULL No matching Aliases
+ *
+ * @note The search is case-sensitive
+ * @note The result is valid until the next Alias is added or deleted
+ */
+struct Alias **alias_names_prefix(const char *prefix, size_t *num)
+{
+  *num = 0;
+  if (!prefix)
+    return NULL;
+
+  if (!SortedAliasesValid)
+    sorted_aliases_rebuild();
+
+  const size_t len = strlen(prefix);
+
+  /* find the first name that's not less than the prefix */
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&SortedAliases);
+  while (lo < hi)
+  {
+    const size_t mid = lo + ((hi - lo) / 2);
+    if (strcmp((*ARRAY_GET(&SortedAliases, mid))->name, prefix) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  size_t end = lo;
+  while ((end < ARRAY_SIZE(&SortedAliases)) &&
+         (strncmp((*ARRAY_GET(&SortedAliases, end))->name, prefix, len) == 0))
+  {
+    end++;
+  }
+
+  *num = end - lo;
+  return (*num > 0) ? ARRAY_GET(&SortedAliases, lo) : NULL;
+}
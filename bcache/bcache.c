@@ -25,14 +25,37 @@
  * @page bcache_bcache Body Cache functions
  *
  * Body Caching (Local copies of email bodies)
+ *
+ * ## Compression
+ *
+ * If `$message_cache_compress_method` is set, mutt_bcache_commit() compresses
+ * the message.  A compressed file begins with a small header:
+ * - The magic bytes #BcacheMagic
+ * - The name of the compression method, NUL-terminated
+ * - The uncompressed length, 8 bytes, little-endian
+ *
+ * mutt_bcache_get() checks for the header and returns a temporary file
+ * containing the uncompressed message.  Files without the header are returned
+ * as-is, so existing caches keep working.
+ *
+ * ## Size limit
+ *
+ * If `$message_cache_size` is set, the oldest entries are deleted when the
+ * cache grows too large.  mutt_bcache_get() updates the access time of each
+ * file it opens, so the entries that haven't been read for the longest time
+ * are deleted first.  Only the files in the account directories, e.g.
+ * `imaps:mail.example.com`, are counted or deleted.
  */
 
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -41,6 +64,9 @@
 #include "conn/lib.h"
 #include "lib.h"
 #include "muttlib.h"
+#ifdef USE_HCACHE_COMPRESSION
+#include "compress/lib.h"
+#endif
 
 /**
  * struct BodyCache - Local cache of email bodies
@@ -50,6 +76,330 @@ struct BodyCache
   char *path; ///< On-disk path to the file
 };
 
+/**
+ * struct BcacheEntry - A file in the message cache
+ */
+struct BcacheEntry
+{
+  char *path;   ///< Path to the file
+  time_t atime; ///< Time of last access
+  off_t size;   ///< Size of the file
+};
+ARRAY_HEAD(BcacheEntryArray, struct BcacheEntry);
+
+/// Start of a compressed file in the Body Cache
+static const char BcacheMagic[4] = { '\211', 'N', 'B', 'C' };
+
+/// Prefixes of the account directories in `$message_cache_dir`, see bcache_path()
+static const char *const BcacheSchemes[] = {
+  "imap:", "imaps:", "pop:", "pops:", "news:", "snews:",
+};
+
+/// Estimated size of `$message_cache_dir` in bytes, -1 if unknown
+static long long BcacheSize = -1;
+
+/**
+ * bcache_entry_sort - Compare two BcacheEntry by access time - Implements ::sort_t - @ingroup sort_api
+ */
+static int bcache_entry_sort(const void *a, const void *b, void *sdata)
+{
+  const struct BcacheEntry *ea = a;
+  const struct BcacheEntry *eb = b;
+
+  if (ea->atime != eb->atime)
+    return (ea->atime < eb->atime) ? -1 : 1;
+  return mutt_str_cmp(ea->path, eb->path);
+}
+
+/**
+ * bcache_is_tmp - Is this a temporary file?
+ * @param name Filename
+ * @retval true The file is a temporary file, see mutt_bcache_put()
+ */
+static bool bcache_is_tmp(const char *name)
+{
+  const size_t len = mutt_str_len(name);
+  return ((len > 4) && mutt_str_equal(name + len - 4, ".tmp")) ||
+         ((len > 5) && mutt_str_equal(name + len - 5, ".ztmp"));
+}
+
+/**
+ * bcache_is_account - Is this a Body Cache account directory?
+ * @param name Directory name, e.g. `imaps:user@example.com`
+ * @retval true The directory was created by bcache_path()
+ */
+static bool bcache_is_account(const char *name)
+{
+  for (size_t i = 0; i < mutt_array_size(BcacheSchemes); i++)
+  {
+    if (mutt_str_startswith(name, BcacheSchemes[i]))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * bcache_scan - Find all the files in the message cache
+ * @param[in]  dir   Directory to scan
+ * @param[in]  top   If true, this is `$message_cache_dir` itself
+ * @param[out] bea   Array for the files
+ * @param[out] total Total size of the files
+ *
+ * Only the account directories that bcache_path() creates are searched, so
+ * anything else the user keeps in `$message_cache_dir` is left alone.
+ * Temporary files, which may still be being written, and symlinks are ignored.
+ */
+static void bcache_scan(const char *dir, bool top, struct BcacheEntryArray *bea,
+                        long long *total)
+{
+  DIR *dh = mutt_file_opendir(dir, MUTT_OPENDIR_NONE);
+  if (!dh)
+    return;
+
+  struct Buffer *path = buf_pool_get();
+  struct dirent *de = NULL;
+  while ((de = readdir(dh)))
+  {
+    if ((de->d_name[0] == '.') || bcache_is_tmp(de->d_name))
+      continue;
+
+    buf_concat_path(path, dir, de->d_name);
+
+    struct stat st = { 0 };
+    if (lstat(buf_string(path), &st) < 0)
+      continue;
+
+    if (S_ISDIR(st.st_mode))
+    {
+      if (!top || bcache_is_account(de->d_name))
+        bcache_scan(buf_string(path), false, bea, total);
+    }
+    else if (S_ISREG(st.st_mode) && !top)
+    {
+      struct BcacheEntry be = { buf_strdup(path), st.st_atime, st.st_size };
+      ARRAY_ADD(bea, be);
+      *total += st.st_size;
+    }
+  }
+
+  closedir(dh);
+  buf_pool_release(&path);
+}
+
+/**
+ * bcache_evict - Keep the message cache within its size limit
+ * @param limit Maximum size of the cache in bytes
+ *
+ * If the cache is too big, the least recently used files are deleted until it
+ * is 10% below the limit.  This leaves room for new messages, so the cache
+ * isn't rescanned after every one.
+ */
+static void bcache_evict(long long limit)
+{
+  const char *const c_message_cache_dir = cs_subset_path(NeoMutt->sub, "message_cache_dir");
+  if (!c_message_cache_dir)
+    return;
+
+  struct BcacheEntryArray bea = ARRAY_HEAD_INITIALIZER;
+  long long total = 0;
+  bcache_scan(c_message_cache_dir, true, &bea, &total);
+
+  if (total > limit)
+  {
+    const long long target = limit - (limit / 10);
+    int count = 0;
+    ARRAY_SORT(&bea, bcache_entry_sort, NULL);
+
+    struct BcacheEntry *be = NULL;
+    ARRAY_FOREACH(be, &bea)
+    {
+      if (total <= target)
+        break;
+      if (unlink(be->path) == 0)
+      {
+        total -= be->size;
+        count++;
+      }
+    }
+
+    mutt_debug(LL_DEBUG1, "bcache: evicted %d files, %lld bytes remain\n", count, total);
+  }
+
+  struct BcacheEntry *be = NULL;
+  ARRAY_FOREACH(be, &bea)
+  {
+    FREE(&be->path);
+  }
+  ARRAY_FREE(&bea);
+
+  BcacheSize = total;
+}
+
+/**
+ * bcache_account - Record the addition of a file to the message cache
+ * @param size Size of the new file
+ *
+ * The size of the cache is scanned once, then tracked.  If it exceeds
+ * `$message_cache_size`, old files are evicted.
+ */
+static void bcache_account(off_t size)
+{
+  const long c_message_cache_size = cs_subset_long(NeoMutt->sub, "message_cache_size");
+  if (c_message_cache_size <= 0)
+    return;
+
+  const long long limit = (long long) c_message_cache_size * 1024 * 1024;
+
+  if (BcacheSize < 0)
+    bcache_evict(limit);
+  else
+    BcacheSize += size;
+
+  if (BcacheSize > limit)
+    bcache_evict(limit);
+}
+
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * bcache_compress - Compress a file for the message cache
+ * @param src  File to compress
+ * @param dst  File for the compressed data
+ * @retval true  Success
+ * @retval false Compression is disabled, or failed
+ */
+static bool bcache_compress(const char *src, const char *dst)
+{
+  const char *const c_message_cache_compress_method = cs_subset_string(NeoMutt->sub, "message_cache_compress_method");
+  const struct ComprOps *cops = compress_get_ops(c_message_cache_compress_method);
+  if (!c_message_cache_compress_method || !cops)
+    return false;
+
+  FILE *fp_in = mutt_file_fopen(src, "r");
+  if (!fp_in)
+    return false;
+
+  bool rc = false;
+  char *data = NULL;
+  ComprHandle *handle = NULL;
+  FILE *fp_out = NULL;
+  struct stat st = { 0 };
+  size_t dlen = 0;
+  size_t clen = 0;
+  void *cdata = NULL;
+
+  if ((fstat(fileno(fp_in), &st) < 0) || (st.st_size == 0))
+    goto done;
+
+  dlen = st.st_size;
+  data = mutt_mem_malloc(dlen);
+  if (fread(data, 1, dlen, fp_in) != dlen)
+    goto done;
+
+  const short c_message_cache_compress_level = cs_subset_number(NeoMutt->sub, "message_cache_compress_level");
+  handle = cops->open(c_message_cache_compress_level);
+  if (handle)
+    cdata = cops->compress(handle, data, dlen, &clen);
+  if (!cdata)
+    goto done;
+
+  fp_out = mutt_file_fopen(dst, "w");
+  if (!fp_out)
+    goto done;
+
+  unsigned char len[8] = { 0 };
+  for (size_t i = 0; i < sizeof(len); i++)
+    len[i] = ((uint64_t) dlen >> (8 * i)) & 0xff;
+
+  fwrite(BcacheMagic, 1, sizeof(BcacheMagic), fp_out);
+  fwrite(cops->name, 1, strlen(cops->name) + 1, fp_out);
+  fwrite(len, 1, sizeof(len), fp_out);
+  fwrite(cdata, 1, clen, fp_out);
+
+  rc = (mutt_file_fclose(&fp_out) == 0);
+  if (!rc)
+    unlink(dst);
+
+done:
+  if (handle)
+    cops->close(&handle);
+  mutt_file_fclose(&fp_out);
+  mutt_file_fclose(&fp_in);
+  FREE(&data);
+  return rc;
+}
+#endif
+
+/**
+ * bcache_decompress - Decompress a file from the message cache
+ * @param fp File, positioned after the magic bytes
+ * @retval ptr  Temporary file of uncompressed data
+ * @retval NULL Error
+ */
+static FILE *bcache_decompress(FILE *fp)
+{
+#ifdef USE_HCACHE_COMPRESSION
+  char name[16] = { 0 };
+  unsigned char len[8] = { 0 };
+
+  size_t n = 0;
+  for (int c; (n < (sizeof(name) - 1)) && ((c = fgetc(fp)) > 0); n++)
+    name[n] = c;
+
+  const struct ComprOps *cops = compress_get_ops(name);
+  if (!cops || (fread(len, 1, sizeof(len), fp) != sizeof(len)))
+  {
+    mutt_debug(LL_DEBUG1, "bcache: unknown compression '%s'\n", name);
+    return NULL;
+  }
+
+  uint64_t dlen = 0;
+  for (size_t i = 0; i < sizeof(len); i++)
+    dlen |= (uint64_t) len[i] << (8 * i);
+
+  struct stat st = { 0 };
+  if (fstat(fileno(fp), &st) < 0)
+    return NULL;
+
+  const long pos = ftell(fp);
+  if ((pos < 0) || (st.st_size <= pos))
+    return NULL;
+
+  const size_t clen = st.st_size - pos;
+  char *cdata = mutt_mem_malloc(clen);
+  FILE *fp_out = NULL;
+  ComprHandle *handle = NULL;
+
+  if (fread(cdata, 1, clen, fp) == clen)
+  {
+    handle = cops->open(cops->min_level);
+    size_t ulen = 0;
+    void *data = handle ? cops->decompress(handle, cdata, clen, &ulen) : NULL;
+    if (data && (ulen != dlen))
+    {
+      mutt_debug(LL_DEBUG1, "bcache: corrupt entry, expected %llu bytes, got %zu\n",
+                 (unsigned long long) dlen, ulen);
+      data = NULL;
+    }
+    if (data)
+    {
+      fp_out = mutt_file_mkstemp();
+      if (fp_out && ((fwrite(data, 1, dlen, fp_out) != dlen) || (fflush(fp_out) != 0)))
+        mutt_file_fclose(&fp_out);
+      if (fp_out)
+        rewind(fp_out);
+    }
+  }
+
+  if (handle)
+    cops->close(&handle);
+  FREE(&cdata);
+  return fp_out;
+#else
+  mutt_debug(LL_DEBUG1, "bcache: compression isn't supported\n");
+  return NULL;
+#endif
+}
+
 /**
  * bcache_path - Create the cache path for a given account/mailbox
  * @param account Account info
@@ -195,6 +545,25 @@ FILE *mutt_bcache_get(struct BodyCache *bcache, const char *id)
 
   mutt_debug(LL_DEBUG3, "bcache: get: '%s': %s\n", buf_string(path), fp ? "yes" : "no");
 
+  if (fp)
+  {
+    // Used by the LRU eviction
+    mutt_file_touch_atime(fileno(fp));
+
+    char magic[sizeof(BcacheMagic)] = { 0 };
+    if ((fread(magic, 1, sizeof(magic), fp) == sizeof(magic)) &&
+        (memcmp(magic, BcacheMagic, sizeof(magic)) == 0))
+    {
+      FILE *fp_plain = bcache_decompress(fp);
+      mutt_file_fclose(&fp);
+      fp = fp_plain;
+    }
+    else
+    {
+      rewind(fp);
+    }
+  }
+
   buf_pool_release(&path);
   return fp;
 }
@@ -248,13 +617,55 @@ FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id)
  * @param id     Per-mailbox unique identifier for the message
  * @retval  0 Success
  * @retval -1 Failure
+ *
+ * The file from mutt_bcache_put() must have been flushed.
+ * If `$message_cache_compress_method` is set, the file is compressed.
  */
 int mutt_bcache_commit(struct BodyCache *bcache, const char *id)
 {
+  if (!bcache || !id || (*id == '\0'))
+    return -1;
+
   struct Buffer *tmpid = buf_pool_get();
   buf_printf(tmpid, "%s.tmp", id);
 
-  int rc = mutt_bcache_move(bcache, buf_string(tmpid), id);
+  int rc = -1;
+#ifdef USE_HCACHE_COMPRESSION
+  struct Buffer *tmppath = buf_pool_get();
+  struct Buffer *zpath = buf_pool_get();
+  struct Buffer *path = buf_pool_get();
+  buf_printf(tmppath, "%s%s", bcache->path, buf_string(tmpid));
+  buf_printf(zpath, "%s%s.ztmp", bcache->path, id);
+  buf_printf(path, "%s%s", bcache->path, id);
+
+  // The caller may still be reading the uncompressed file
+  if (bcache_compress(buf_string(tmppath), buf_string(zpath)))
+  {
+    rc = rename(buf_string(zpath), buf_string(path));
+    if (rc == 0)
+      unlink(buf_string(tmppath));
+    else
+      unlink(buf_string(zpath));
+  }
+
+  buf_pool_release(&tmppath);
+  buf_pool_release(&zpath);
+  buf_pool_release(&path);
+#endif
+
+  if (rc != 0)
+    rc = mutt_bcache_move(bcache, buf_string(tmpid), id);
+
+  if (rc == 0)
+  {
+    struct Buffer *path = buf_pool_get();
+    buf_printf(path, "%s%s", bcache->path, id);
+    struct stat st = { 0 };
+    if (stat(buf_string(path), &st) == 0)
+      bcache_account(st.st_size);
+    buf_pool_release(&path);
+  }
+
   buf_pool_release(&tmpid);
   return rc;
 }
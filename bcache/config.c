@@ -0,0 +1,136 @@
+/**
+ * @file
+ * Config used by libbcache
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page bcache_config Config used by Body Cache
+ *
+ * Config used by libbcache
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#ifdef USE_HCACHE_COMPRESSION
+#include "compress/lib.h"
+#endif
+
+#if defined(USE_HCACHE_COMPRESSION)
+/**
+ * compress_method_validator - Validate the "message_cache_compress_method" config variable - Implements ConfigDef::validator() - @ingroup cfg_def_validator
+ */
+static int compress_method_validator(const struct ConfigDef *cdef,
+                                     intptr_t value, struct Buffer *err)
+{
+  if (value == 0)
+    return CSR_SUCCESS;
+
+  const char *str = (const char *) value;
+
+  if (compress_get_ops(str))
+    return CSR_SUCCESS;
+
+  buf_printf(err, _("Invalid value for option %s: %s"), cdef->name, str);
+  return CSR_ERR_INVALID;
+}
+
+/**
+ * compress_level_validator - Validate the "message_cache_compress_level" config variable - Implements ConfigDef::validator() - @ingroup cfg_def_validator
+ */
+static int compress_level_validator(const struct ConfigDef *cdef,
+                                    intptr_t value, struct Buffer *err)
+{
+  const char *const c_message_cache_compress_method = cs_subset_string(NeoMutt->sub, "message_cache_compress_method");
+  if (!c_message_cache_compress_method)
+  {
+    buf_printf(err, _("Set option %s before setting %s"),
+               "message_cache_compress_method", cdef->name);
+    return CSR_ERR_INVALID;
+  }
+
+  const struct ComprOps *cops = compress_get_ops(c_message_cache_compress_method);
+  if (!cops)
+  {
+    buf_printf(err, _("Invalid value for option %s: %s"),
+               "message_cache_compress_method", c_message_cache_compress_method);
+    return CSR_ERR_INVALID;
+  }
+
+  if ((value < cops->min_level) || (value > cops->max_level))
+  {
+    // L10N: This applies to the "$message_cache_compress_level" config variable.
+    //       It shows the minimum and maximum values, e.g. 'between 1 and 22'
+    buf_printf(err, _("Option %s must be between %d and %d inclusive"),
+               cdef->name, cops->min_level, cops->max_level);
+    return CSR_ERR_INVALID;
+  }
+
+  return CSR_SUCCESS;
+}
+#endif
+
+/**
+ * BcacheVars - Config definitions for the Body Cache
+ */
+static struct ConfigDef BcacheVars[] = {
+  // clang-format off
+  { "message_cache_size", DT_LONG|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(imap/pop/nntp) Maximum size of the message cache, in megabytes"
+  },
+  { NULL },
+  // clang-format on
+};
+
+#if defined(USE_HCACHE_COMPRESSION)
+/**
+ * BcacheVarsComp - Config definitions for the Body Cache Compression
+ */
+static struct ConfigDef BcacheVarsComp[] = {
+  // clang-format off
+  // These two are not in alphabetical order because `level`s validator depends on `method`
+  { "message_cache_compress_method", DT_STRING, 0, 0, compress_method_validator,
+    "(imap/pop/nntp) Compress the messages in the message cache"
+  },
+  { "message_cache_compress_level", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 1, 0, compress_level_validator,
+    "(imap/pop/nntp) Level of compression for method"
+  },
+  { NULL },
+  // clang-format on
+};
+#endif
+
+/**
+ * config_init_bcache - Register bcache config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
+ */
+bool config_init_bcache(struct ConfigSet *cs)
+{
+  bool rc = cs_register_variables(cs, BcacheVars);
+
+#if defined(USE_HCACHE_COMPRESSION)
+  rc |= cs_register_variables(cs, BcacheVarsComp);
+#endif
+
+  return rc;
+}
@@ -28,6 +28,7 @@
  * | File                | Description                |
  * | :------------------ | :------------------------- |
  * | bcache/bcache.c     | @subpage bcache_bcache     |
+ * | bcache/config.c     | @subpage bcache_config     |
  */
 
 #ifndef MUTT_BCACHE_LIB_H
@@ -135,7 +135,8 @@ static void *compr_lz4_compress(ComprHandle *handle, const char *data,
 /**
  * compr_lz4_decompress - Decompress header cache data - Implements ComprOps::decompress() - @ingroup compress_decompress
  */
-static void *compr_lz4_decompress(ComprHandle *handle, const char *cbuf, size_t clen)
+static void *compr_lz4_decompress(ComprHandle *handle, const char *cbuf,
+                                  size_t clen, size_t *dlen)
 {
   if (!handle)
     return NULL;
@@ -151,7 +152,10 @@ static void *compr_lz4_decompress(ComprHandle *handle, const char *cbuf, size_t
   if (ulen > INT_MAX)
     return NULL; // LCOV_EXCL_LINE
   if (ulen == 0)
+  {
+    *dlen = 0;
     return (void *) cbuf;
+  }
 
   mutt_mem_realloc(&cdata->buf, ulen);
   void *ubuf = cdata->buf;
@@ -160,6 +164,8 @@ static void *compr_lz4_decompress(ComprHandle *handle, const char *cbuf, size_t
   if (rc < 0)
     return NULL;
 
+  *dlen = rc;
+
   return ubuf;
 }
 
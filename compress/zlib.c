@@ -132,7 +132,8 @@ static void *compr_zlib_compress(ComprHandle *handle, const char *data,
 /**
  * compr_zlib_decompress - Decompress header cache data - Implements ComprOps::decompress() - @ingroup compress_decompress
  */
-static void *compr_zlib_decompress(ComprHandle *handle, const char *cbuf, size_t clen)
+static void *compr_zlib_decompress(ComprHandle *handle, const char *cbuf,
+                                   size_t clen, size_t *dlen)
 {
   if (!handle)
     return NULL;
@@ -155,6 +156,8 @@ static void *compr_zlib_decompress(ComprHandle *handle, const char *cbuf, size_t
   if (rc != Z_OK)
     return NULL;
 
+  *dlen = ulen;
+
   return ubuf;
 }
 
@@ -190,6 +190,38 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
   return -1;
 }
 
+/**
+ * socket_fill - Refill the input buffer of a Connection, if it's empty
+ * @param conn Connection to a server
+ * @retval >0 Number of bytes waiting in the buffer
+ * @retval -1 Error, the Connection has been closed
+ */
+static int socket_fill(struct Connection *conn)
+{
+  if (conn->bufpos < conn->available)
+    return conn->available - conn->bufpos;
+
+  if (conn->fd < 0)
+  {
+    mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
+    return -1;
+  }
+
+  conn->available = conn->read(conn, conn->inbuf, sizeof(conn->inbuf));
+  conn->bufpos = 0;
+  if (conn->available == 0)
+  {
+    mutt_error(_("Connection to %s closed"), conn->account.host);
+  }
+  if (conn->available <= 0)
+  {
+    mutt_socket_close(conn);
+    return -1;
+  }
+
+  return conn->available;
+}
+
 /**
  * mutt_socket_readchar - Simple read buffering to speed things up
  * @param[in]  conn Connection to a server
@@ -199,33 +231,54 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
  */
 int mutt_socket_readchar(struct Connection *conn, char *c)
 {
-  if (conn->bufpos >= conn->available)
-  {
-    if (conn->fd >= 0)
-    {
-      conn->available = conn->read(conn, conn->inbuf, sizeof(conn->inbuf));
-    }
-    else
-    {
-      mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
-      return -1;
-    }
-    conn->bufpos = 0;
-    if (conn->available == 0)
-    {
-      mutt_error(_("Connection to %s closed"), conn->account.host);
-    }
-    if (conn->available <= 0)
-    {
-      mutt_socket_close(conn);
-      return -1;
-    }
-  }
+  if (socket_fill(conn) < 0)
+    return -1;
+
   *c = conn->inbuf[conn->bufpos];
   conn->bufpos++;
   return 1;
 }
 
+/**
+ * mutt_socket_readln_span - Read the next piece of a line from a socket
+ * @param[in]  conn Connection to a server
+ * @param[in]  max  Maximum length of the piece
+ * @param[out] span Start of the piece
+ * @param[out] eol  Set to true if the piece ends the line
+ * @retval >=0 Length of the piece, excluding the '\n'
+ * @retval  -1 Error
+ *
+ * Rather than reading a character at a time, the input buffer is searched for
+ * the end of the line.  The piece is everything up to the '\n', or the end of
+ * the buffer, whichever comes first.  The '\n' itself is consumed, but isn't
+ * part of the piece.  Any '\r' is left for the caller.
+ *
+ * @note The piece points into the Connection's input buffer.
+ *       It's only valid until the next read.
+ */
+int mutt_socket_readln_span(struct Connection *conn, size_t max,
+                            const char **span, bool *eol)
+{
+  if (socket_fill(conn) < 0)
+    return -1;
+
+  const char *start = conn->inbuf + conn->bufpos;
+  const size_t len = MIN(max, (size_t) (conn->available - conn->bufpos));
+  const char *nl = memchr(start, '\n', len);
+
+  *span = start;
+  *eol = (nl != NULL);
+
+  if (!nl)
+  {
+    conn->bufpos += len;
+    return len;
+  }
+
+  conn->bufpos += (nl - start) + 1;
+  return nl - start;
+}
+
 /**
  * mutt_socket_readln_d - Read a line from a socket
  * @param buf    Buffer to store the line
@@ -237,20 +290,21 @@ int mutt_socket_readchar(struct Connection *conn, char *c)
  */
 int mutt_socket_readln_d(char *buf, size_t buflen, struct Connection *conn, int dbg)
 {
-  char ch;
-  int i;
+  size_t i = 0;
+  bool eol = false;
 
-  for (i = 0; i < buflen - 1; i++)
+  while (!eol && (i < (buflen - 1)))
   {
-    if (mutt_socket_readchar(conn, &ch) != 1)
+    const char *span = NULL;
+    const int len = mutt_socket_readln_span(conn, buflen - 1 - i, &span, &eol);
+    if (len < 0)
     {
       buf[i] = '\0';
       return -1;
     }
 
-    if (ch == '\n')
-      break;
-    buf[i] = ch;
+    memcpy(buf + i, span, len);
+    i += len;
   }
 
   /* strip \r from \r\n termination */
@@ -327,29 +381,26 @@ void mutt_socket_empty(struct Connection *conn)
  */
 int mutt_socket_buffer_readln_d(struct Buffer *buf, struct Connection *conn, int dbg)
 {
-  char ch;
-  bool has_cr = false;
+  bool eol = false;
 
   buf_reset(buf);
 
-  while (true)
+  while (!eol)
   {
-    if (mutt_socket_readchar(conn, &ch) != 1)
+    const char *span = NULL;
+    const int len = mutt_socket_readln_span(conn, sizeof(conn->inbuf), &span, &eol);
+    if (len < 0)
       return -1;
 
-    if (ch == '\n')
-      break;
-
-    if (has_cr)
-    {
-      buf_addch(buf, '\r');
-      has_cr = false;
-    }
+    buf_addstr_n(buf, span, len);
+  }
 
-    if (ch == '\r')
-      has_cr = true;
-    else
-      buf_addch(buf, ch);
+  /* strip \r from \r\n termination */
+  const size_t len = buf_len(buf);
+  if ((len > 0) && (buf->data[len - 1] == '\r'))
+  {
+    buf_seek(buf, len - 1);
+    buf->dptr[0] = '\0';
   }
 
   mutt_debug(dbg, "%d< %s\n", conn->fd, buf_string(buf));
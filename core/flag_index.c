@@ -0,0 +1,165 @@
+/**
+ * @file
+ * Bitmaps of the Email flags in a Mailbox
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page core_flag_index Bitmaps of the Email flags in a Mailbox
+ *
+ * A FlagIndex packs the flags of every Email in a Mailbox into bitmaps, one
+ * per flag.  Flag-only patterns, such as `~N` or `~F !~D`, can then be
+ * answered a word at a time, without visiting each Email.
+ *
+ * The index is built on demand, by flag_index_get().  mutt_set_flag() keeps it
+ * up to date, a bit at a time.  Anything that adds, removes or reorders the
+ * Emails, or that changes their flags behind mutt_set_flag()'s back, simply
+ * throws the index away, with flag_index_invalidate().
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "flag_index.h"
+#include "mailbox.h"
+
+/**
+ * flag_index_set - Copy an Email's flags into the index
+ * @param fi Flag Index
+ * @param i  Index of the Email in the Mailbox
+ * @param e  Email
+ */
+static void flag_index_set(struct FlagIndex *fi, int i, const struct Email *e)
+{
+  const bool flags[FIB_MAX] = {
+    [FIB_READ] = e->read,       [FIB_OLD] = e->old,
+    [FIB_FLAGGED] = e->flagged, [FIB_DELETED] = e->deleted,
+    [FIB_TAGGED] = e->tagged,   [FIB_REPLIED] = e->replied,
+  };
+
+  const size_t word = i / 64;
+  const uint64_t mask = (uint64_t) 1 << (i % 64);
+
+  for (enum FlagIndexBit bit = 0; bit < FIB_MAX; bit++)
+  {
+    uint64_t *bitmap = flag_index_bitmap(fi, bit);
+    if (flags[bit])
+      bitmap[word] |= mask;
+    else
+      bitmap[word] &= ~mask;
+  }
+}
+
+/**
+ * flag_index_new - Build a FlagIndex for a Mailbox
+ * @param m Mailbox
+ * @retval ptr New FlagIndex
+ */
+static struct FlagIndex *flag_index_new(struct Mailbox *m)
+{
+  struct FlagIndex *fi = MUTT_MEM_CALLOC(1, struct FlagIndex);
+
+  fi->count = m->msg_count;
+  fi->words = (fi->count + 63) / 64;
+  fi->bits = MUTT_MEM_CALLOC(fi->words * FIB_MAX, uint64_t);
+
+  for (int i = 0; i < fi->count; i++)
+  {
+    const struct Email *e = m->emails[i];
+    if (e)
+      flag_index_set(fi, i, e);
+  }
+
+  return fi;
+}
+
+/**
+ * flag_index_free - Free a FlagIndex
+ * @param[out] ptr FlagIndex to free
+ */
+void flag_index_free(struct FlagIndex **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct FlagIndex *fi = *ptr;
+  FREE(&fi->bits);
+  FREE(ptr);
+}
+
+/**
+ * flag_index_get - Get the FlagIndex of a Mailbox
+ * @param m Mailbox
+ * @retval ptr  FlagIndex, valid until the Mailbox changes
+ * @retval NULL Error
+ *
+ * If the Mailbox doesn't have an index, or it's out of date, one is built.
+ */
+struct FlagIndex *flag_index_get(struct Mailbox *m)
+{
+  if (!m)
+    return NULL;
+
+  if (m->flag_index && (m->flag_index->count != m->msg_count))
+    flag_index_free(&m->flag_index);
+
+  if (!m->flag_index)
+    m->flag_index = flag_index_new(m);
+
+  return m->flag_index;
+}
+
+/**
+ * flag_index_invalidate - Throw away the FlagIndex of a Mailbox
+ * @param m Mailbox
+ *
+ * The index will be rebuilt the next time it's needed.
+ */
+void flag_index_invalidate(struct Mailbox *m)
+{
+  if (!m)
+    return;
+
+  flag_index_free(&m->flag_index);
+}
+
+/**
+ * flag_index_update - Update the FlagIndex after an Email's flags have changed
+ * @param m Mailbox
+ * @param e Email
+ *
+ * If the Email isn't where the index expects it, the index is thrown away.
+ */
+void flag_index_update(struct Mailbox *m, const struct Email *e)
+{
+  if (!m || !e || !m->flag_index)
+    return;
+
+  struct FlagIndex *fi = m->flag_index;
+  const int i = e->msgno;
+  if ((i < 0) || (i >= fi->count) || (m->emails[i] != e))
+  {
+    flag_index_invalidate(m);
+    return;
+  }
+
+  flag_index_set(fi, i, e);
+}
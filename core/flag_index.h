@@ -0,0 +1,75 @@
+/**
+ * @file
+ * Bitmaps of the Email flags in a Mailbox
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_CORE_FLAG_INDEX_H
+#define MUTT_CORE_FLAG_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Email;
+struct Mailbox;
+
+/**
+ * enum FlagIndexBit - Email flags kept in a FlagIndex
+ */
+enum FlagIndexBit
+{
+  FIB_READ,    ///< Email.read
+  FIB_OLD,     ///< Email.old
+  FIB_FLAGGED, ///< Email.flagged
+  FIB_DELETED, ///< Email.deleted
+  FIB_TAGGED,  ///< Email.tagged
+  FIB_REPLIED, ///< Email.replied
+  FIB_MAX,
+};
+
+/**
+ * struct FlagIndex - Bitmaps of the Email flags in a Mailbox
+ *
+ * Bit `i` of each bitmap describes `Mailbox.emails[i]`.
+ * Any bits past `count` are zero.
+ */
+struct FlagIndex
+{
+  int count;      ///< Number of Emails in the index
+  size_t words;   ///< Length of each bitmap, in words
+  uint64_t *bits; ///< Bitmaps, #FIB_MAX of them, each `words` long
+};
+
+/**
+ * flag_index_bitmap - Get one of the bitmaps of a FlagIndex
+ * @param fi  Flag Index
+ * @param bit Flag, e.g. #FIB_READ
+ * @retval ptr Bitmap
+ */
+static inline uint64_t *flag_index_bitmap(const struct FlagIndex *fi, enum FlagIndexBit bit)
+{
+  return fi->bits + (bit * fi->words);
+}
+
+void              flag_index_free      (struct FlagIndex **ptr);
+struct FlagIndex *flag_index_get       (struct Mailbox *m);
+void              flag_index_invalidate(struct Mailbox *m);
+void              flag_index_update    (struct Mailbox *m, const struct Email *e);
+
+#endif /* MUTT_CORE_FLAG_INDEX_H */
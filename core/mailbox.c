@@ -32,6 +32,7 @@
 #include <sys/stat.h>
 #include "config/lib.h"
 #include "email/lib.h"
+#include "flag_index.h"
 #include "mailbox.h"
 #include "neomutt.h"
 
@@ -123,6 +124,7 @@ void mailbox_free(struct Mailbox **ptr)
   m->msg_new = 0;
   m->msg_tagged = 0;
   m->msg_unread = 0;
+  flag_index_free(&m->flag_index);
 
   if (m->mdata_free && m->mdata)
     m->mdata_free(&m->mdata);
@@ -235,6 +237,15 @@ void mailbox_changed(struct Mailbox *m, enum NotifyMailbox action)
   if (!m)
     return;
 
+  m->view_gen++;
+
+  // The Emails may be about to be added, removed or reordered
+  if ((action == NT_MAILBOX_INVALID) || (action == NT_MAILBOX_RESORT) ||
+      (action == NT_MAILBOX_UPDATE))
+  {
+    flag_index_invalidate(m);
+  }
+
   mutt_debug(LL_NOTIFY, "NT_MAILBOX_CHANGE: %s %p\n",
              mailbox_get_type_name(m->type), (void *) m);
   struct EventMailbox ev_m = { m };
@@ -33,6 +33,7 @@
 
 struct ConfigSubset;
 struct Email;
+struct FlagIndex;
 
 /**
  * enum MailboxType - Supported mailbox formats
@@ -123,6 +124,7 @@ struct Mailbox
   struct HashTable *id_hash;          ///< Hash Table: "message-id" -> Email
   struct HashTable *subj_hash;        ///< Hash Table: "subject" -> Email
   struct HashTable *label_hash;       ///< Hash Table: "x-labels" -> Email
+  struct FlagIndex *flag_index;       ///< Bitmaps of the Email flags, built on demand
 
   struct Account *account;            ///< Account that owns this Mailbox
   int opened;                         ///< Number of times mailbox is opened
@@ -145,6 +147,7 @@ struct Mailbox
   struct Notify *notify;              ///< Notifications: #NotifyMailbox, #EventMailbox
 
   int gen;                            ///< Generation number, for sorting
+  unsigned int view_gen;              ///< Bumped when the Emails' Index rows may change
 };
 
 /**
@@ -2038,6 +2038,18 @@
 ** This variable defaults to the value of $$imap_user.
 */
 
+{ "imap_notify", DT_BOOL, false },
+/*
+** .pp
+** When \fIset\fP, and the server supports the NOTIFY extension (RFC5465),
+** NeoMutt will ask the server to report changes to the mailboxes it is
+** watching, instead of sending a STATUS command for each of them on
+** every mail check.
+** .pp
+** The changes are delivered over the connection of the open mailbox, so
+** this works best with $$imap_idle.
+*/
+
 { "imap_oauth_refresh_command", D_STRING_COMMAND, 0 },
 /*
 ** .pp
@@ -2087,6 +2099,9 @@
 ** more responsive. But not all servers correctly handle pipelined commands,
 ** so if you have problems you might want to try setting this variable to 0.
 ** .pp
+** When headers are downloaded in chunks (see $$imap_fetch_chunk_size), this
+** also limits the number of chunks that are requested at once.
+** .pp
 ** \fBNote:\fP Changes to this variable have no effect on open connections.
 */
 
@@ -2099,6 +2114,30 @@
 ** to 0 to disable timing out.
 */
 
+{ "imap_pool_size", DT_NUMBER, 0 },
+/*
+** .pp
+** The number of extra connections NeoMutt may open to each IMAP server, in
+** addition to the one used by the open mailbox.  Background work, like
+** checking other mailboxes for new mail, uses these connections, so it
+** doesn't delay the commands of the open mailbox.
+** .pp
+** Each connection counts against the server's limit of connections per
+** user.  Set to 0 to do everything on a single connection.
+*/
+
+{ "imap_prefetch", DT_NUMBER, 0 },
+/*
+** .pp
+** While you are idle in the index or pager, NeoMutt can fetch the messages
+** that follow the current one into the $$message_cache_dir.  This variable
+** sets how many messages ahead to look.  Reading the next message is then
+** fast, even over a slow connection.
+** .pp
+** One message is fetched each time the screen is idle for a second, and
+** messages aren't marked as read.  Set to 0 to disable prefetching.
+*/
+
 { "imap_qresync", DT_BOOL, false },
 /*
 ** .pp
@@ -2467,6 +2506,20 @@
 */
 #endif
 
+{ "maildir_readahead_threads", DT_NUMBER, 4 },
+/*
+** .pp
+** This variable controls how many threads NeoMutt uses to read ahead
+** messages when opening a Maildir folder.  Only messages that aren't in the
+** header cache are affected.  The threads read the headers of the files
+** into the operating system's cache.  The headers are then parsed, and
+** stored in the header cache, one at a time, by the main thread.  This only
+** helps when the files aren't already cached, e.g. on a slow or network
+** disk.  If they are, opening the folder takes as long as with one thread.
+** .pp
+** Setting this variable to 0 or 1 will read the messages one at a time.
+*/
+
 { "maildir_trash", DT_BOOL, false },
 /*
 ** .pp
@@ -2520,6 +2573,17 @@
 ** Also see the $$move variable.
 */
 
+{ "mbox_mmap", DT_BOOL, true },
+/*
+** .pp
+** When this variable is \fIset\fP, NeoMutt will map mbox and mmdf folders
+** into memory when reading them.  Message separators are then found by
+** searching the mapping, rather than reading the folder line by line, which
+** makes opening very large folders much faster.
+** .pp
+** If the folder can't be mapped, NeoMutt falls back to reading it normally.
+*/
+
 { "mbox_type", DT_ENUM, MUTT_MBOX },
 /*
 ** .pp
@@ -2569,6 +2633,23 @@
 ** (especially for large folders).
 */
 
+#ifdef USE_HCACHE_COMPRESSION
+{ "message_cache_compress_level", DT_NUMBER, 1 },
+/*
+** .pp
+** When NeoMutt is compiled with lz4, zstd or zlib, this option can be used
+** to setup the compression level of the message cache.
+*/
+
+{ "message_cache_compress_method", DT_STRING, 0 },
+/*
+** .pp
+** When NeoMutt is compiled with lz4, zstd or zlib, the messages in the
+** $$message_cache_dir can be compressed using one of these methods.
+** Messages that were cached before this was set will still be read.
+*/
+#endif
+
 { "message_cache_dir", DT_PATH, 0 },
 /*
 ** .pp
@@ -2580,7 +2661,17 @@
 ** remote message only once and can perform regular expression searches
 ** as fast as for local folders.
 ** .pp
-** Also see the $$message_cache_clean variable.
+** Also see the $$message_cache_clean and $$message_cache_size variables.
+*/
+
+{ "message_cache_size", DT_LONG, 0 },
+/*
+** .pp
+** The maximum size of the $$message_cache_dir, in megabytes.  When the cache
+** grows larger, the messages that were read least recently are deleted.  Other
+** files in the directory aren't counted or deleted.
+** .pp
+** If this is 0, the size isn't limited.
 */
 
 { "message_format", DT_STRING, "%s" },
@@ -2810,6 +2901,18 @@
 ** modifying tags. All other NeoMutt commands use standard (e.g. maildir) flags.
 */
 
+{ "nm_open_batch", DT_NUMBER, 0 },
+/*
+** .pp
+** When this is set, opening a notmuch mailbox only reads this many messages
+** before showing the index.  The rest of the query's results are read in
+** batches of this size while you are idle in the index.  A large query is
+** then usable straight away.
+** .pp
+** Until all the results have been read, the mailbox isn't checked for new
+** mail.  Set to 0 to read all the results when the mailbox is opened.
+*/
+
 { "nm_open_timeout", DT_NUMBER, 5 },
 /*
 ** .pp
@@ -3318,6 +3421,34 @@
 ** (PGP only)
 */
 
+{ "pgp_keyring_cache", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, NeoMutt lists the whole keyring once, using
+** $$pgp_list_pubring_command or $$pgp_list_secring_command, and keeps the
+** parsed keys in memory.  Looking up the keys of a recipient no longer runs
+** a command.
+** .pp
+** The cache is refreshed when the keyring files in the GnuPG home directory,
+** \fC$$$GNUPGHOME\fP or \fC~/.gnupg\fP, change, or after an hour.
+** This includes the keyboxd database, \fCpublic-keys.d/pubring.db\fP.
+** If those files can't be found, e.g. when not using GnuPG, this variable
+** has no effect.
+** .pp
+** Email addresses are matched exactly; parts of names are matched against
+** the user ids, as GnuPG does.
+** (PGP only)
+*/
+
+{ "pgp_keyring_cache_file", DT_PATH, 0 },
+/*
+** .pp
+** If $$pgp_keyring_cache is \fIset\fP, the keyring listing is saved in this
+** file, so that it can be reused the next time NeoMutt starts.  A suffix of
+** \fC.pub\fP or \fC.sec\fP is added for the public and secret keyrings.
+** (PGP only)
+*/
+
 { "pgp_list_pubring_command", D_STRING_COMMAND, 0 },
 /*
 ** .pp
@@ -4244,6 +4375,25 @@
 ** before search results. By default, search results will be top-aligned.
 */
 
+{ "search_read_threads", DT_NUMBER, 4 },
+/*
+** .pp
+** This variable controls how many threads NeoMutt uses for a limit, tag or
+** delete pattern that searches the text of the messages, e.g. \fC~b\fP.
+** Only Maildir and MH folders are affected.
+** .pp
+** If $$thorough_search is unset, and the pattern only uses simple tests,
+** the messages are split between the threads and matched in parallel.
+** .pp
+** Otherwise, including the default, where $$thorough_search is set, the
+** messages are decoded and matched one at a time by the main thread.  The
+** threads only read the message files ahead of the search, so this helps
+** when the files aren't cached yet.  Messages that the pattern won't open,
+** e.g. the old messages for \fC~N ~b foo\fP, aren't read.
+** .pp
+** Setting this variable to 0 or 1 will read the messages one at a time.
+*/
+
 { "send_charset", DT_SLIST, "us-ascii:iso-8859-1:utf-8" },
 /*
 ** .pp
@@ -60,6 +60,7 @@ void email_free(struct Email **ptr)
   mutt_env_free(&e->env);
   mutt_body_free(&e->body);
   FREE(&e->tree);
+  FREE(&e->index_row);
   FREE(&e->path);
 #ifdef USE_NOTMUCH
   nm_edata_free(&e->nm_edata);
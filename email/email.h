@@ -123,6 +123,12 @@ struct Email
   size_t num_hidden;           ///< Number of hidden messages in this view
                                ///< (only valid when collapsed is set)
   char *tree;                  ///< Character string to print thread tree
+
+  // Cache of the Email's row in the Index, see index_make_entry()
+  char *index_row;             ///< Rendered $index_format, including colour markers
+  unsigned int index_row_gen;  ///< Mailbox::view_gen when index_row was rendered
+  int index_row_key;           ///< Width and format flags used to render index_row
+  int index_row_cols;          ///< Screen columns used by index_row
 };
 ARRAY_HEAD(EmailArray, struct Email *);
 
@@ -32,7 +32,10 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "config/lib.h"
@@ -347,6 +350,251 @@ int mutt_compare_emails(const struct Email *a, const struct Email *b,
   return rc;
 }
 
+/**
+ * struct SortKey - Precomputed sort keys of an Email
+ *
+ * Each sort method is reduced to a number and an optional lowercase string,
+ * which compare the same way as the sort_email_t function would.
+ */
+struct SortKey
+{
+  uint64_t num[2];     ///< Numeric keys for the primary and secondary sort
+  size_t str[2];       ///< String keys, offset into the arena plus one, or 0
+  struct Email *email; ///< Email the keys belong to
+};
+
+/**
+ * struct SortKeyContext - Context for sort_key_cmp()
+ */
+struct SortKeyContext
+{
+  const char *arena; ///< Storage for the string keys
+  bool reverse[2];   ///< Reverse the primary and secondary sort
+};
+
+/**
+ * sort_key_signed - Map a signed number to an unsigned key with the same order
+ * @param num Number
+ * @retval num Sort key
+ */
+static uint64_t sort_key_signed(int64_t num)
+{
+  return (uint64_t) num ^ (UINT64_C(1) << 63);
+}
+
+/**
+ * sort_key_supported - Can a sort method use precomputed keys?
+ * @param method Sort type, see #EmailSortType
+ * @param type   The Mailbox type
+ * @retval true The keys can be computed by sort_key_fill()
+ */
+static bool sort_key_supported(enum EmailSortType method, enum MailboxType type)
+{
+  switch (method)
+  {
+    case EMAIL_SORT_DATE:
+    case EMAIL_SORT_DATE_RECEIVED:
+    case EMAIL_SORT_FROM:
+    case EMAIL_SORT_LABEL:
+    case EMAIL_SORT_SCORE:
+    case EMAIL_SORT_SIZE:
+    case EMAIL_SORT_SUBJECT:
+    case EMAIL_SORT_TO:
+      return true;
+    case EMAIL_SORT_UNSORTED:
+      return (type != MUTT_NNTP);
+    default:
+      return false;
+  }
+}
+
+/**
+ * sort_key_numeric - Is a sort method purely numeric?
+ * @param method Sort type, see #EmailSortType
+ * @retval true The keys have no string part
+ */
+static bool sort_key_numeric(enum EmailSortType method)
+{
+  return (method == EMAIL_SORT_DATE) || (method == EMAIL_SORT_DATE_RECEIVED) ||
+         (method == EMAIL_SORT_SCORE) || (method == EMAIL_SORT_SIZE) ||
+         (method == EMAIL_SORT_UNSORTED);
+}
+
+/**
+ * sort_key_fill - Compute one sort key for each Email
+ * @param keys   Sort keys
+ * @param num    Number of keys
+ * @param part   Which key to fill, 0 (primary) or 1 (secondary)
+ * @param method Sort type, see #EmailSortType
+ * @param arena  Storage for the string keys
+ *
+ * The strings are lowercased copies, so they can be compared with strcmp().
+ * The arena moves as it grows, so only their offsets are stored.
+ */
+static void sort_key_fill(struct SortKey *keys, int num, int part,
+                          enum EmailSortType method, struct Buffer *arena)
+{
+  for (int i = 0; i < num; i++)
+  {
+    struct SortKey *key = &keys[i];
+    const struct Email *e = key->email;
+    const char *str = NULL;
+    size_t max = SIZE_MAX;
+
+    switch (method)
+    {
+      case EMAIL_SORT_DATE:
+        key->num[part] = sort_key_signed(e->date_sent);
+        break;
+      case EMAIL_SORT_DATE_RECEIVED:
+        key->num[part] = sort_key_signed(e->received);
+        break;
+      case EMAIL_SORT_SCORE:
+        // Highest score first, see email_sort_score()
+        key->num[part] = sort_key_signed(-(int64_t) e->score);
+        break;
+      case EMAIL_SORT_SIZE:
+        key->num[part] = sort_key_signed(e->body->length);
+        break;
+      case EMAIL_SORT_UNSORTED:
+        key->num[part] = sort_key_signed(e->index);
+        break;
+      case EMAIL_SORT_SUBJECT:
+        // Emails without a subject come first, ordered by date
+        str = e->env->real_subj;
+        key->num[part] = str ? UINT64_MAX : sort_key_signed(e->date_sent);
+        break;
+      case EMAIL_SORT_LABEL:
+        // Emails with a label come first
+        str = e->env->x_label;
+        if (str && (*str == '\0'))
+          str = NULL;
+        key->num[part] = str ? 0 : 1;
+        break;
+      case EMAIL_SORT_FROM:
+        str = mutt_get_name(TAILQ_FIRST(&e->env->from));
+        max = 127; // See email_sort_from()
+        break;
+      case EMAIL_SORT_TO:
+        str = mutt_get_name(TAILQ_FIRST(&e->env->to));
+        max = 127; // See email_sort_to()
+        break;
+      default:
+        break;
+    }
+
+    key->str[part] = 0;
+    if (!str)
+      continue;
+
+    const size_t len = MIN(mutt_str_len(str), max);
+    const size_t off = buf_len(arena);
+    if ((off + len + 1) > arena->dsize)
+      buf_alloc(arena, (arena->dsize * 2) + len + 1);
+
+    buf_addstr_n(arena, str, len);
+    buf_addch(arena, '\0');
+    mutt_str_lower(arena->data + off);
+    key->str[part] = off + 1;
+  }
+}
+
+/**
+ * sort_key_cmp_part - Compare one part of two sort keys
+ * @param a       First key
+ * @param b       Second key
+ * @param part    Which key to compare, 0 (primary) or 1 (secondary)
+ * @param ctx     Sort context
+ * @retval num Result of the comparison, as strcmp()
+ */
+static int sort_key_cmp_part(const struct SortKey *a, const struct SortKey *b,
+                             int part, const struct SortKeyContext *ctx)
+{
+  int rc = mutt_numeric_cmp(a->num[part], b->num[part]);
+  if ((rc == 0) && (a->str[part] != 0) && (b->str[part] != 0))
+    rc = strcmp(ctx->arena + a->str[part] - 1, ctx->arena + b->str[part] - 1);
+  return ctx->reverse[part] ? -rc : rc;
+}
+
+/**
+ * sort_key_cmp - Compare two sort keys - Implements ::sort_t - @ingroup sort_api
+ *
+ * This matches mutt_compare_emails() for the same sort methods.
+ */
+static int sort_key_cmp(const void *a, const void *b, void *sdata)
+{
+  const struct SortKey *ka = a;
+  const struct SortKey *kb = b;
+  const struct SortKeyContext *ctx = sdata;
+
+  int rc = sort_key_cmp_part(ka, kb, 0, ctx);
+  if (rc == 0)
+    rc = sort_key_cmp_part(ka, kb, 1, ctx);
+  if (rc == 0)
+    rc = mutt_numeric_cmp(ka->email->index, kb->email->index);
+  return rc;
+}
+
+/**
+ * sort_emails_by_key - Sort the Emails using precomputed keys
+ * @param m   Mailbox
+ * @param cmp Sort methods
+ * @retval true  Emails have been sorted
+ * @retval false The sort methods need mutt_compare_emails()
+ *
+ * Computing the keys once avoids deriving them, e.g. with mutt_get_name(), on
+ * every comparison.  Numeric sorts use a radix sort, ties are then resolved by
+ * the secondary sort.
+ */
+static bool sort_emails_by_key(struct Mailbox *m, const struct EmailCompare *cmp)
+{
+  const enum EmailSortType method = cmp->sort & SORT_MASK;
+  const enum EmailSortType method_aux = cmp->sort_aux & SORT_MASK;
+  if (!sort_key_supported(method, cmp->type) || !sort_key_supported(method_aux, cmp->type))
+    return false;
+
+  const int num = m->msg_count;
+  struct SortKey *keys = MUTT_MEM_CALLOC(num, struct SortKey);
+  for (int i = 0; i < num; i++)
+    keys[i].email = m->emails[i];
+
+  struct Buffer *arena = buf_new(NULL);
+  sort_key_fill(keys, num, 0, method, arena);
+  sort_key_fill(keys, num, 1, method_aux, arena);
+
+  struct SortKeyContext ctx = { 0 };
+  ctx.arena = buf_string(arena);
+  ctx.reverse[0] = (cmp->sort & SORT_REVERSE) != 0;
+  ctx.reverse[1] = (cmp->sort_aux & SORT_REVERSE) != 0;
+
+  if (sort_key_numeric(method))
+  {
+    mutt_radix_sort(keys, num, sizeof(struct SortKey),
+                    offsetof(struct SortKey, num), ctx.reverse[0]);
+
+    // Sort each run of equal keys by the secondary sort
+    for (int i = 0, j; i < num; i = j)
+    {
+      for (j = i + 1; (j < num) && (keys[j].num[0] == keys[i].num[0]); j++)
+        ; // do nothing
+
+      if ((j - i) > 1)
+        mutt_qsort_r(&keys[i], j - i, sizeof(struct SortKey), sort_key_cmp, &ctx);
+    }
+  }
+  else
+  {
+    mutt_qsort_r(keys, num, sizeof(struct SortKey), sort_key_cmp, &ctx);
+  }
+
+  for (int i = 0; i < num; i++)
+    m->emails[i] = keys[i].email;
+
+  buf_free(&arena);
+  FREE(&keys);
+  return true;
+}
+
 /**
  * mutt_sort_headers - Sort emails by their headers
  * @param mv    Mailbox View
@@ -410,8 +658,12 @@ void mutt_sort_headers(struct MailboxView *mv, bool init)
     cmp.type = mx_type(m);
     cmp.sort = cs_subset_sort(NeoMutt->sub, "sort");
     cmp.sort_aux = cs_subset_sort(NeoMutt->sub, "sort_aux");
-    mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
-                 email_sort_shim, &cmp);
+    if (!sort_emails_by_key(m, &cmp))
+    {
+      mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
+                   email_sort_shim, &cmp);
+    }
+    flag_index_invalidate(m);
   }
 
   /* adjust the virtual message numbers */
@@ -431,6 +683,8 @@ void mutt_sort_headers(struct MailboxView *mv, bool init)
     e_cur->msgno = i;
   }
 
+  m->view_gen++;
+
   /* re-collapse threads marked as collapsed */
   if (threaded)
   {
@@ -61,7 +61,7 @@ bool is_descendant(const struct MuttThread *a, const struct MuttThread *b)
  *
  * Remove cur and its descendants from their current location.  Also make sure
  * ancestors of cur no longer are sorted by the fact that cur is their
- * descendant.
+ * descendant, and mark them for re-sorting.
  */
 void unlink_message(struct MuttThread **old, struct MuttThread *cur)
 {
@@ -78,6 +78,9 @@ void unlink_message(struct MuttThread **old, struct MuttThread *cur)
   if (cur->next)
     cur->next->prev = cur->prev;
 
+  for (tmp = cur->parent; tmp && !tmp->sort_dirty; tmp = tmp->parent)
+    tmp->sort_dirty = true;
+
   if (cur->sort_thread_key)
   {
     for (tmp = cur->parent;
@@ -99,7 +102,8 @@ void unlink_message(struct MuttThread **old, struct MuttThread *cur)
  * @param[in]     parent Parent of new thread
  * @param[in]     cur    Current thread to add after
  *
- * add cur as a prior sibling of *add, with parent parent
+ * add cur as a prior sibling of *add, with parent parent.
+ * cur and its new ancestors are marked for re-sorting.
  */
 void insert_message(struct MuttThread **add, struct MuttThread *parent, struct MuttThread *cur)
 {
@@ -113,6 +117,10 @@ void insert_message(struct MuttThread **add, struct MuttThread *parent, struct M
   cur->next = *add;
   cur->prev = NULL;
   *add = cur;
+
+  cur->sort_dirty = true;
+  for (; parent && !parent->sort_dirty; parent = parent->parent)
+    parent->sort_dirty = true;
 }
 
 /**
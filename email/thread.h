@@ -38,6 +38,7 @@ struct MuttThread
   bool         fake_thread          : 1;  ///< Emails grouped by Subject
   bool         next_subtree_visible : 1;  ///< Is the next Thread subtree visible?
   bool         sort_children        : 1;  ///< Sort the children
+  bool         sort_dirty           : 1;  ///< Thread has changed since it was last sorted
   unsigned int subtree_visible      : 2;  ///< Is this Thread subtree visible?
   bool         visible              : 1;  ///< Is this Thread visible?
 
@@ -37,6 +37,7 @@
 #include "node_padding.h"
 #include "node_text.h"
 #include "parse.h"
+#include "program.h"
 #include "render.h"
 
 struct ExpandoDefinition;
@@ -66,6 +67,7 @@ void expando_free(struct Expando **ptr)
   struct Expando *exp = *ptr;
 
   node_free(&exp->node);
+  program_free(&exp->program);
   FREE(&exp->string);
 
   FREE(ptr);
@@ -102,6 +104,9 @@ struct Expando *expando_parse(const char *str, const struct ExpandoDefinition *d
   node_padding_repad(&exp->node);
   node_container_collapse_all(&exp->node);
 
+  // The tree won't change now, so it can be compiled when it's first rendered
+  exp->program = program_new();
+
   return exp;
 }
 
@@ -125,7 +130,17 @@ int expando_render(const struct Expando *exp, const struct ExpandoRenderCallback
   if (max_cols == -1)
     max_cols = 8192;
 
-  return node_render(exp->node, erc, buf, max_cols, data, flags);
+  struct ExpandoProgram *prog = exp->program;
+  if (!prog)
+    return node_render(exp->node, erc, buf, max_cols, data, flags);
+
+  if (prog->erc != erc)
+    program_compile(prog, exp->node, erc);
+
+  if (ARRAY_EMPTY(&prog->ops))
+    return node_render(exp->node, erc, buf, max_cols, data, flags);
+
+  return program_render(prog, buf, max_cols, data, flags);
 }
 
 /**
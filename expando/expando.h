@@ -29,6 +29,7 @@
 
 struct Buffer;
 struct ExpandoDefinition;
+struct ExpandoProgram;
 
 /**
  * struct Expando - Parsed Expando trees
@@ -39,8 +40,9 @@ struct ExpandoDefinition;
  */
 struct Expando
 {
-  const char         *string;  ///< Pointer to the parsed string
-  struct ExpandoNode *node;    ///< Parsed tree
+  const char            *string;   ///< Pointer to the parsed string
+  struct ExpandoNode    *node;     ///< Parsed tree
+  struct ExpandoProgram *program;  ///< Compiled tree, built on first render
 };
 
 void            expando_free(struct Expando **ptr);
@@ -28,6 +28,7 @@
  */
 
 #include "config.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include "mutt/lib.h"
 #include "node.h"
@@ -118,3 +119,27 @@ struct ExpandoNode *node_last(struct ExpandoNode *node)
 
   return node;
 }
+
+/**
+ * node_find_type - Does a tree contain a Node of a given type?
+ * @param node Root Node
+ * @param type Type of Node to look for, e.g. #ENT_CONDDATE
+ * @retval true The tree contains a matching Node
+ */
+bool node_find_type(const struct ExpandoNode *node, enum ExpandoNodeType type)
+{
+  if (!node)
+    return false;
+
+  if (node->type == type)
+    return true;
+
+  struct ExpandoNode **np = NULL;
+  ARRAY_FOREACH(np, &node->children)
+  {
+    if (node_find_type(*np, type))
+      return true;
+  }
+
+  return false;
+}
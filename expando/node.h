@@ -99,5 +99,6 @@ void                node_add_child(struct ExpandoNode *node, struct ExpandoNode
 struct ExpandoNode *node_get_child(const struct ExpandoNode *node, int index);
 
 struct ExpandoNode *node_last (struct ExpandoNode *node);
+bool                node_find_type(const struct ExpandoNode *node, enum ExpandoNodeType type);
 
 #endif /* MUTT_EXPANDO_NODE_H */
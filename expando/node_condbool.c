@@ -44,23 +44,53 @@ int node_condbool_render(const struct ExpandoNode *node,
 {
   ASSERT(node->type == ENT_CONDBOOL);
 
+  return node_condbool_test(node, node_condbool_find(node, erc), data, flags);
+}
+
+/**
+ * node_condbool_find - Find the callback for a CondBool Node
+ * @param node CondBool Node
+ * @param erc  Render callbacks to search
+ * @retval ptr Matching Render data
+ *
+ * Numbers are preferred to strings.
+ */
+const struct ExpandoRenderCallback *node_condbool_find(const struct ExpandoNode *node,
+                                                       const struct ExpandoRenderCallback *erc)
+{
   const struct ExpandoRenderCallback *erc_match = find_get_number(erc, node->did, node->uid);
   if (erc_match)
+    return erc_match;
+
+  return find_get_string(erc, node->did, node->uid);
+}
+
+/**
+ * node_condbool_test - Test a CondBool Node using a known callback
+ * @param node      CondBool Node
+ * @param erc_match Callback from node_condbool_find()
+ * @param data      Private data
+ * @param flags     Flags, see #MuttFormatFlags
+ * @retval 1 The data is non-zero, or a non-empty string
+ * @retval 0 Otherwise
+ */
+int node_condbool_test(const struct ExpandoNode *node,
+                       const struct ExpandoRenderCallback *erc_match, void *data,
+                       MuttFormatFlags flags)
+{
+  if (!erc_match)
+    return 0;
+
+  if (erc_match->get_number)
   {
     const long num = erc_match->get_number(node, data, flags);
     return (num != 0); // bool-ify
   }
 
-  erc_match = find_get_string(erc, node->did, node->uid);
-  if (erc_match)
-  {
-    struct Buffer *buf_str = buf_pool_get();
-    erc_match->get_string(node, data, flags, buf_str);
-    const size_t len = buf_len(buf_str);
-    buf_pool_release(&buf_str);
-
-    return (len > 0); // bool-ify
-  }
+  struct Buffer *buf_str = buf_pool_get();
+  erc_match->get_string(node, data, flags, buf_str);
+  const size_t len = buf_len(buf_str);
+  buf_pool_release(&buf_str);
 
-  return 0;
+  return (len > 0); // bool-ify
 }
@@ -33,4 +33,7 @@ int node_condbool_render(const struct ExpandoNode *node,
                          const struct ExpandoRenderCallback *erc, struct Buffer *buf,
                          int max_cols, void *data, MuttFormatFlags flags);
 
+const struct ExpandoRenderCallback *node_condbool_find(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc);
+int node_condbool_test(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc_match, void *data, MuttFormatFlags flags);
+
 #endif /* MUTT_EXPANDO_NODE_CONDBOOL_H */
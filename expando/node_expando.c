@@ -398,6 +398,25 @@ void add_color(struct Buffer *buf, enum ColorId cid)
   buf_addch(buf, cid);
 }
 
+/**
+ * node_expando_find - Find the callback for an Expando Node
+ * @param node Expando Node
+ * @param erc  Render callbacks to search
+ * @retval ptr Matching Render data
+ *
+ * Numbers and strings get treated slightly differently. We prefer strings.
+ * This allows dates to be stored as 1729850182, but displayed as "2024-10-25".
+ */
+const struct ExpandoRenderCallback *node_expando_find(const struct ExpandoNode *node,
+                                                      const struct ExpandoRenderCallback *erc)
+{
+  const struct ExpandoRenderCallback *erc_match = find_get_string(erc, node->did, node->uid);
+  if (erc_match)
+    return erc_match;
+
+  return find_get_number(erc, node->did, node->uid);
+}
+
 /**
  * node_expando_render - Render an Expando Node - Implements ExpandoNode::render() - @ingroup expando_render
  */
@@ -407,18 +426,34 @@ int node_expando_render(const struct ExpandoNode *node,
 {
   ASSERT(node->type == ENT_EXPANDO);
 
+  return node_expando_render_callback(node, node_expando_find(node, erc), buf,
+                                      max_cols, data, flags);
+}
+
+/**
+ * node_expando_render_callback - Render an Expando Node using a known callback
+ * @param node      Expando Node
+ * @param erc_match Callback from node_expando_find()
+ * @param buf       Buffer for the result
+ * @param max_cols  Maximum number of screen columns to use
+ * @param data      Private data
+ * @param flags     Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
+ */
+int node_expando_render_callback(const struct ExpandoNode *node,
+                                 const struct ExpandoRenderCallback *erc_match,
+                                 struct Buffer *buf, int max_cols, void *data,
+                                 MuttFormatFlags flags)
+{
+  ASSERT(erc_match && "Unknown UID");
+
   struct Buffer *buf_expando = buf_pool_get();
   struct Buffer *buf_format = buf_pool_get();
 
   const struct ExpandoFormat *fmt = node->format;
   const struct NodeExpandoPrivate *priv = node->ndata;
 
-  // ---------------------------------------------------------------------------
-  // Numbers and strings get treated slightly differently. We prefer strings.
-  // This allows dates to be stored as 1729850182, but displayed as "2024-10-25".
-
-  const struct ExpandoRenderCallback *erc_match = find_get_string(erc, node->did, node->uid);
-  if (erc_match)
+  if (erc_match->get_string)
   {
     erc_match->get_string(node, data, flags, buf_expando);
 
@@ -427,9 +462,6 @@ int node_expando_render(const struct ExpandoNode *node,
   }
   else
   {
-    erc_match = find_get_number(erc, node->did, node->uid);
-    ASSERT(erc_match && "Unknown UID");
-
     const long num = erc_match->get_number(node, data, flags);
 
     int precision = 1;
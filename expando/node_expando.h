@@ -51,6 +51,8 @@ struct ExpandoFormat *parse_format(const char *str, const char **parsed_until, s
 struct ExpandoNode *parse_short_name(const char *str, const struct ExpandoDefinition *defs, ExpandoParserFlags flags, struct ExpandoFormat *fmt, const char **parsed_until, struct ExpandoParseError *err);
 struct ExpandoNode *node_expando_parse(const char *str, const struct ExpandoDefinition *defs, ExpandoParserFlags flags, const char **parsed_until, struct ExpandoParseError *err);
 int node_expando_render(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+int node_expando_render_callback(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc_match, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+const struct ExpandoRenderCallback *node_expando_find(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc);
 
 struct ExpandoNode *node_expando_parse_enclosure(const char *str, int did, int uid, char terminator, struct ExpandoFormat *fmt, const char **parsed_until, struct ExpandoParseError *err);
 
@@ -77,13 +77,28 @@ int pad_string(const struct ExpandoNode *node, struct Buffer *buf, int max_cols)
 {
   const int pad_len = mutt_str_len(node->text);
   const int pad_cols = mutt_strnwidth(node->text, pad_len);
+
+  return pad_string_n(node->text, pad_len, pad_cols, buf, max_cols);
+}
+
+/**
+ * pad_string_n - Pad a buffer with a measured character
+ * @param pad      Padding character(s)
+ * @param pad_len  Length of pad in bytes
+ * @param pad_cols Width of pad in screen columns
+ * @param buf      Buffer to populate
+ * @param max_cols Number of screen columns available
+ * @retval num Number of screen columns used
+ */
+int pad_string_n(const char *pad, int pad_len, int pad_cols, struct Buffer *buf, int max_cols)
+{
   int total_cols = 0;
 
   if (pad_len != 0)
   {
     while (pad_cols <= max_cols)
     {
-      buf_addstr_n(buf, node->text, pad_len);
+      buf_addstr_n(buf, pad, pad_len);
 
       max_cols -= pad_cols;
       total_cols += pad_cols;
@@ -26,6 +26,7 @@
 
 #include "definition.h"
 
+struct Buffer;
 struct ExpandoFormat;
 struct ExpandoNode;
 struct ExpandoParseError;
@@ -69,5 +70,6 @@ struct NodePaddingPrivate
 struct ExpandoNode *node_padding_parse(const char *str, struct ExpandoFormat *fmt, int did, int uid, ExpandoParserFlags flags, const char **parsed_until, struct ExpandoParseError *err);
 
 void node_padding_repad(struct ExpandoNode **parent);
+int  pad_string_n(const char *pad, int pad_len, int pad_cols, struct Buffer *buf, int max_cols);
 
 #endif /* MUTT_EXPANDO_NODE_PADDING_H */
@@ -0,0 +1,542 @@
+/**
+ * @file
+ * Compiled Expando Program
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page expando_program Compiled Expando Program
+ *
+ * Rendering an Expando tree means a recursive walk of the Nodes, and a search
+ * of the callbacks for every Expando.  The formats, like $index_format, are
+ * rendered for every line of the screen, so the tree is compiled into a flat
+ * list of instructions, once.
+ *
+ * - The callback of each Expando and CondBool is found at compile time
+ * - Literal text is rendered and measured at compile time
+ * - The padding character is measured at compile time
+ *
+ * Containers, Conditions and Padding become a pair of Start/End instructions.
+ * The renderer keeps a stack of frames, one per open Node, holding its output
+ * and its column budget.  The output is identical to node_render().
+ */
+
+#include "config.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "gui/lib.h"
+#include "program.h"
+#include "format.h"
+#include "helpers.h"
+#include "node.h"
+#include "node_condbool.h"
+#include "node_condition.h"
+#include "node_expando.h"
+#include "node_padding.h"
+#include "render.h"
+
+/**
+ * struct ExpandoFrame - Render state of an open Container, Condition or Padding
+ */
+struct ExpandoFrame
+{
+  struct Buffer *buf;   ///< Output of the current Node
+  struct Buffer *tmp;   ///< Temporary Buffer owned by the frame
+  struct Buffer *first; ///< Padding: Output of the first side
+  int max_cols;         ///< Number of screen columns available to the Node
+  int cols;             ///< Number of screen columns used so far
+};
+
+/**
+ * program_new - Create a new, empty, Program
+ * @retval ptr New Program
+ */
+struct ExpandoProgram *program_new(void)
+{
+  return MUTT_MEM_CALLOC(1, struct ExpandoProgram);
+}
+
+/**
+ * program_clear - Empty a Program
+ * @param prog Program to empty
+ */
+static void program_clear(struct ExpandoProgram *prog)
+{
+  struct ExpandoOp *op = NULL;
+  ARRAY_FOREACH(op, &prog->ops)
+  {
+    FREE(&op->text);
+  }
+  ARRAY_FREE(&prog->ops);
+  prog->erc = NULL;
+}
+
+/**
+ * program_free - Free a Program
+ * @param ptr Program to free
+ */
+void program_free(struct ExpandoProgram **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  program_clear(*ptr);
+  FREE(ptr);
+}
+
+/**
+ * op_add - Add an instruction to a Program
+ * @param prog         Program
+ * @param type         Type of instruction, e.g. #EOP_TEXT
+ * @param node         Node being rendered
+ * @param in_container True if the Node is the child of a Container
+ * @retval num Index of the new instruction
+ */
+static int op_add(struct ExpandoProgram *prog, enum ExpandoOpType type,
+                  const struct ExpandoNode *node, bool in_container)
+{
+  struct ExpandoOp op = { 0 };
+  op.type = type;
+  op.node = node;
+  op.in_container = in_container;
+
+  ARRAY_ADD(&prog->ops, op);
+
+  const int idx = ARRAY_SIZE(&prog->ops) - 1;
+  ARRAY_GET(&prog->ops, idx)->skip = idx + 1;
+  return idx;
+}
+
+/**
+ * compile_node - Compile a Node and its children
+ * @param prog         Program
+ * @param node         Node to compile
+ * @param in_container True if the Node is the child of a Container
+ * @param depth        Nesting depth of the Node
+ * @retval true  Success
+ * @retval false The tree is too deep
+ */
+static bool compile_node(struct ExpandoProgram *prog, const struct ExpandoNode *node,
+                         bool in_container, int depth)
+{
+  if (!node)
+    return true;
+
+  if (depth >= EXPANDO_PROGRAM_MAX_DEPTH)
+    return false;
+
+  int idx = 0;
+  bool rc = true;
+
+  switch (node->type)
+  {
+    case ENT_TEXT:
+    {
+      idx = op_add(prog, EOP_TEXT, node, in_container);
+
+      struct Buffer *buf = buf_pool_get();
+      const int cols = format_string(buf, 0, INT_MAX, JUSTIFY_LEFT, ' ', node->text,
+                                     mutt_str_len(node->text), false);
+      struct ExpandoOp *op = ARRAY_GET(&prog->ops, idx);
+      op->text = buf_strdup(buf);
+      op->len = buf_len(buf);
+      op->cols = cols;
+      buf_pool_release(&buf);
+      break;
+    }
+
+    case ENT_EXPANDO:
+    {
+      const struct ExpandoRenderCallback *erc = node_expando_find(node, prog->erc);
+      if ((node->render != node_expando_render) || !erc)
+      {
+        op_add(prog, EOP_NODE, node, in_container);
+        break;
+      }
+
+      idx = op_add(prog, EOP_EXPANDO, node, in_container);
+      ARRAY_GET(&prog->ops, idx)->erc = erc;
+      break;
+    }
+
+    case ENT_CONTAINER:
+    {
+      idx = op_add(prog, EOP_CONTAINER, node, in_container);
+
+      struct ExpandoNode **np = NULL;
+      ARRAY_FOREACH(np, &node->children)
+      {
+        rc = rc && compile_node(prog, *np, true, depth + 1);
+      }
+
+      const int end = op_add(prog, EOP_END, node, false);
+      ARRAY_GET(&prog->ops, idx)->skip = end + 1;
+      break;
+    }
+
+    case ENT_CONDITION:
+    {
+      idx = op_add(prog, EOP_CONDITION, node, in_container);
+
+      const struct ExpandoNode *node_cond = node_get_child(node, ENC_CONDITION);
+      if ((node_cond->type == ENT_CONDBOOL) && (node_cond->render == node_condbool_render))
+        ARRAY_GET(&prog->ops, idx)->erc = node_condbool_find(node_cond, prog->erc);
+
+      rc = compile_node(prog, node_get_child(node, ENC_TRUE), false, depth + 1);
+      const int jump = op_add(prog, EOP_JUMP, node, false);
+      ARRAY_GET(&prog->ops, idx)->jump = jump + 1;
+
+      rc = rc && compile_node(prog, node_get_child(node, ENC_FALSE), false, depth + 1);
+      const int end = op_add(prog, EOP_END, node, false);
+      ARRAY_GET(&prog->ops, jump)->jump = end;
+      ARRAY_GET(&prog->ops, idx)->skip = end + 1;
+      break;
+    }
+
+    case ENT_PADDING:
+    {
+      idx = op_add(prog, EOP_PADDING, node, in_container);
+
+      const int pad_len = mutt_str_len(node->text);
+      const int pad_cols = mutt_strnwidth(node->text, pad_len);
+
+      const struct NodePaddingPrivate *priv = node->ndata;
+      const struct ExpandoNode *left = node_get_child(node, ENP_LEFT);
+      const struct ExpandoNode *right = node_get_child(node, ENP_RIGHT);
+
+      // Soft padding renders the right-hand side first
+      if (priv->pad_type == EPT_SOFT_FILL)
+      {
+        rc = compile_node(prog, right, false, depth + 1);
+        op_add(prog, EOP_SWITCH, node, false);
+        rc = rc && compile_node(prog, left, false, depth + 1);
+      }
+      else if (priv->pad_type == EPT_HARD_FILL)
+      {
+        rc = compile_node(prog, left, false, depth + 1);
+        op_add(prog, EOP_SWITCH, node, false);
+        rc = rc && compile_node(prog, right, false, depth + 1);
+      }
+      else
+      {
+        rc = compile_node(prog, left, false, depth + 1);
+      }
+
+      // The padding is added by the End instruction
+      const int end = op_add(prog, EOP_END, node, false);
+      ARRAY_GET(&prog->ops, idx)->skip = end + 1;
+      ARRAY_GET(&prog->ops, end)->len = pad_len;
+      ARRAY_GET(&prog->ops, end)->cols = pad_cols;
+      break;
+    }
+
+    default:
+    {
+      op_add(prog, EOP_NODE, node, in_container);
+      break;
+    }
+  }
+
+  return rc;
+}
+
+/**
+ * program_compile - Compile an Expando tree
+ * @param prog Program to fill
+ * @param root Root of the Expando tree
+ * @param erc  Render callbacks to resolve
+ *
+ * Any previous contents of the Program are discarded.
+ * If the tree can't be compiled, the Program will be empty.
+ */
+void program_compile(struct ExpandoProgram *prog, const struct ExpandoNode *root,
+                     const struct ExpandoRenderCallback *erc)
+{
+  if (!prog)
+    return;
+
+  program_clear(prog);
+  prog->erc = erc;
+
+  if (!compile_node(prog, root, false, 0))
+  {
+    mutt_debug(LL_DEBUG1, "Expando is too deep to compile\n");
+    program_clear(prog);
+    prog->erc = erc;
+  }
+}
+
+/**
+ * frame_finish - Finish rendering a Container, Condition or Padding
+ * @param op     End instruction
+ * @param frame  Frame of the Node
+ * @param parent Frame of the Node's parent
+ */
+static void frame_finish(const struct ExpandoOp *op, struct ExpandoFrame *frame,
+                         struct ExpandoFrame *parent)
+{
+  const struct ExpandoNode *node = op->node;
+  const struct ExpandoFormat *fmt = node->format;
+
+  switch (node->type)
+  {
+    case ENT_CONTAINER:
+    {
+      struct Buffer *tmp = buf_pool_get();
+      int cols = 0;
+      if (fmt)
+      {
+        int max = frame->max_cols;
+        if (fmt->max_cols >= 0)
+          max = MIN(max, fmt->max_cols);
+        int min = MIN(fmt->min_cols, max);
+
+        cols = format_string(tmp, min, max, fmt->justification, ' ',
+                             buf_string(frame->buf), buf_len(frame->buf), true);
+
+        if (fmt->lower)
+          buf_lower_special(tmp);
+      }
+      else
+      {
+        cols = format_string(tmp, 0, frame->max_cols, JUSTIFY_LEFT, ' ',
+                             buf_string(frame->buf), buf_len(frame->buf), true);
+      }
+      buf_addstr(parent->buf, buf_string(tmp));
+      parent->cols += cols;
+      buf_pool_release(&tmp);
+      break;
+    }
+
+    case ENT_CONDITION:
+    {
+      if (!fmt)
+      {
+        // The branch was rendered directly into the parent
+        parent->cols += frame->cols;
+        break;
+      }
+
+      struct Buffer *tmp = buf_pool_get();
+      int min_cols = MAX(fmt->min_cols, fmt->max_cols);
+      min_cols = MIN(min_cols, frame->max_cols);
+      int max_cols = frame->max_cols;
+      if (fmt->max_cols >= 0)
+        max_cols = MIN(max_cols, fmt->max_cols);
+
+      parent->cols += format_string(tmp, min_cols, max_cols, fmt->justification, ' ',
+                                    buf_string(frame->buf), buf_len(frame->buf), true);
+      if (fmt->lower)
+        buf_lower_special(tmp);
+
+      buf_addstr(parent->buf, buf_string(tmp));
+      buf_pool_release(&tmp);
+      break;
+    }
+
+    case ENT_PADDING:
+    {
+      const struct NodePaddingPrivate *priv = node->ndata;
+      int cols = frame->cols;
+
+      if (priv->pad_type == EPT_FILL_EOL)
+      {
+        // The left-hand side was rendered directly into the parent
+        cols += pad_string_n(node->text, op->len, op->cols, parent->buf,
+                             frame->max_cols - cols);
+        parent->cols += cols;
+        break;
+      }
+
+      struct Buffer *left = frame->first;
+      struct Buffer *right = frame->tmp;
+      if (priv->pad_type == EPT_SOFT_FILL)
+      {
+        left = frame->tmp;
+        right = frame->first;
+      }
+
+      buf_addstr(parent->buf, buf_string(left));
+      if (frame->max_cols > cols)
+        cols += pad_string_n(node->text, op->len, op->cols, parent->buf,
+                             frame->max_cols - cols);
+      buf_addstr(parent->buf, buf_string(right));
+      parent->cols += cols;
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  buf_pool_release(&frame->tmp);
+  buf_pool_release(&frame->first);
+}
+
+/**
+ * program_render - Render a Program into a string
+ * @param prog     Compiled Program
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags to control behaviour
+ * @retval num Number of screen columns used
+ */
+int program_render(const struct ExpandoProgram *prog, struct Buffer *buf,
+                   int max_cols, void *data, MuttFormatFlags flags)
+{
+  if (!prog)
+    return 0;
+
+  struct ExpandoFrame frames[EXPANDO_PROGRAM_MAX_DEPTH + 1];
+  int depth = 0;
+  frames[0] = (struct ExpandoFrame) { buf, NULL, NULL, max_cols, 0 };
+
+  const int count = ARRAY_SIZE(&prog->ops);
+  int pc = 0;
+  while (pc < count)
+  {
+    const struct ExpandoOp *op = ARRAY_GET(&prog->ops, pc);
+    struct ExpandoFrame *frame = &frames[depth];
+
+    // A full Container doesn't render any more of its children
+    if (op->in_container && (frame->cols >= frame->max_cols))
+    {
+      pc = op->skip;
+      continue;
+    }
+
+    const int avail = frame->max_cols - frame->cols;
+
+    switch (op->type)
+    {
+      case EOP_TEXT:
+      {
+        if ((op->cols > 0) && (op->cols <= avail))
+        {
+          buf_addstr_n(frame->buf, op->text, op->len);
+          frame->cols += op->cols;
+        }
+        else
+        {
+          frame->cols += format_string(frame->buf, 0, avail, JUSTIFY_LEFT, ' ',
+                                       op->node->text, mutt_str_len(op->node->text), false);
+        }
+        break;
+      }
+
+      case EOP_EXPANDO:
+      {
+        frame->cols += node_expando_render_callback(op->node, op->erc, frame->buf,
+                                                    avail, data, flags);
+        break;
+      }
+
+      case EOP_NODE:
+      {
+        frame->cols += node_render(op->node, prog->erc, frame->buf, avail, data, flags);
+        break;
+      }
+
+      case EOP_CONTAINER:
+      {
+        const struct ExpandoFormat *fmt = op->node->format;
+        struct ExpandoFrame *child = &frames[++depth];
+        *child = (struct ExpandoFrame) { NULL, buf_pool_get(), NULL, avail, 0 };
+        child->buf = child->tmp;
+        if (fmt && (fmt->max_cols != -1))
+          child->max_cols = MIN(avail, fmt->max_cols);
+        break;
+      }
+
+      case EOP_CONDITION:
+      {
+        const struct ExpandoNode *node_cond = node_get_child(op->node, ENC_CONDITION);
+
+        int rc_cond = 0;
+        if (op->erc)
+        {
+          rc_cond = node_condbool_test(node_cond, op->erc, data, flags);
+        }
+        else
+        {
+          // Discard any text returned, just use the return value as a bool
+          struct Buffer *buf_cond = buf_pool_get();
+          rc_cond = node_cond->render(node_cond, prog->erc, buf_cond, avail, data, flags);
+          buf_pool_release(&buf_cond);
+        }
+
+        struct ExpandoFrame *child = &frames[++depth];
+        *child = (struct ExpandoFrame) { frame->buf, NULL, NULL, avail, 0 };
+        if (op->node->format)
+        {
+          child->tmp = buf_pool_get();
+          child->buf = child->tmp;
+        }
+
+        if (rc_cond != true)
+        {
+          pc = op->jump;
+          continue;
+        }
+        break;
+      }
+
+      case EOP_PADDING:
+      {
+        const struct NodePaddingPrivate *priv = op->node->ndata;
+        struct ExpandoFrame *child = &frames[++depth];
+        *child = (struct ExpandoFrame) { frame->buf, NULL, NULL, avail, 0 };
+        if (priv->pad_type != EPT_FILL_EOL)
+        {
+          child->first = buf_pool_get();
+          child->buf = child->first;
+        }
+        break;
+      }
+
+      case EOP_SWITCH:
+      {
+        frame->tmp = buf_pool_get();
+        frame->buf = frame->tmp;
+        break;
+      }
+
+      case EOP_JUMP:
+      {
+        pc = op->jump;
+        continue;
+      }
+
+      case EOP_END:
+      {
+        ASSERT(depth > 0);
+        frame_finish(op, frame, &frames[depth - 1]);
+        depth--;
+        break;
+      }
+    }
+
+    pc++;
+  }
+
+  return frames[0].cols;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * Compiled Expando Program
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_EXPANDO_PROGRAM_H
+#define MUTT_EXPANDO_PROGRAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "render.h"
+
+struct Buffer;
+struct ExpandoNode;
+
+/// Deepest nesting of Containers, Conditions and Padding that can be compiled
+#define EXPANDO_PROGRAM_MAX_DEPTH 32
+
+/**
+ * enum ExpandoOpType - Type of Program instruction
+ */
+enum ExpandoOpType
+{
+  EOP_TEXT = 1,   ///< Literal text
+  EOP_EXPANDO,    ///< Expando, using a resolved callback
+  EOP_NODE,       ///< Any other Node, rendered by its own callback
+  EOP_CONTAINER,  ///< Start of a Container
+  EOP_CONDITION,  ///< Start of a Condition, jump to the false branch if it fails
+  EOP_PADDING,    ///< Start of Padding
+  EOP_SWITCH,     ///< Padding: start rendering the second side
+  EOP_JUMP,       ///< Jump to the end of a Condition
+  EOP_END,        ///< End of a Container, Condition or Padding
+};
+
+/**
+ * struct ExpandoOp - A Program instruction
+ */
+struct ExpandoOp
+{
+  enum ExpandoOpType type;                 ///< Type of instruction
+  const struct ExpandoNode *node;          ///< Node being rendered
+  const struct ExpandoRenderCallback *erc; ///< Resolved callback, for #EOP_EXPANDO and #EOP_CONDITION
+  bool in_container;                       ///< Skip this Node if its Container is full
+  int skip;                                ///< Index of the first instruction after this Node
+  int jump;                                ///< Index of the false branch, or the end of the Condition
+  char *text;                              ///< Rendered text, for #EOP_TEXT
+  int len;                                 ///< Length in bytes of the text, or of Padding's character
+  int cols;                                ///< Width in screen columns of the text, or of Padding's character
+};
+ARRAY_HEAD(ExpandoOpArray, struct ExpandoOp);
+
+/**
+ * struct ExpandoProgram - An Expando tree, compiled into a list of instructions
+ *
+ * The callbacks are resolved when the Program is compiled, so a Program is
+ * specific to one set of ExpandoRenderCallback.
+ */
+struct ExpandoProgram
+{
+  struct ExpandoOpArray ops;                ///< Instructions
+  const struct ExpandoRenderCallback *erc;  ///< Callbacks the Program was compiled for
+};
+
+struct ExpandoProgram *program_new    (void);
+void                   program_free   (struct ExpandoProgram **ptr);
+void                   program_compile(struct ExpandoProgram *prog, const struct ExpandoNode *root, const struct ExpandoRenderCallback *erc);
+int                    program_render (const struct ExpandoProgram *prog, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+
+#endif /* MUTT_EXPANDO_PROGRAM_H */
@@ -0,0 +1,260 @@
+#include "config.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mutt.h"
+#include "globals.h"
+#include "handler.h"
+#include "protos.h"
+
+/**
+ * Compare the block decoders in handler.c against the original, byte at a
+ * time, decoders.  The first byte of the input chooses the encoding and
+ * whether the part is text.  The rest of the input is decoded by both.
+ * The output, and where the input is left, must match.
+ */
+
+bool StartupComplete = true;
+
+/**
+ * log_disp_null - Discard log lines - Implements ::log_dispatcher_t - @ingroup logging_api
+ */
+static int log_disp_null(time_t stamp, const char *file, int line, const char *function,
+                         enum LogLevel level, const char *format, ...)
+{
+  return 0;
+}
+
+/**
+ * ref_put - Write a decoded character, converting CRLF to LF for text
+ * @param fp     File to write to
+ * @param ch     Decoded character
+ * @param istext Mime part is plain text
+ * @param cr     Pending '\r'
+ */
+static void ref_put(FILE *fp, int ch, bool istext, bool *cr)
+{
+  if (*cr && (ch != '\n'))
+    fputc('\r', fp);
+
+  *cr = false;
+
+  if (istext && (ch == '\r'))
+    *cr = true;
+  else
+    fputc((char) ch, fp);
+}
+
+/**
+ * ref_decode_base64 - Decode base64, a byte at a time
+ * @param fp_in  File to read
+ * @param fp_out File to write
+ * @param len    Length of text to decode
+ * @param istext Mime part is plain text
+ */
+static void ref_decode_base64(FILE *fp_in, FILE *fp_out, size_t len, bool istext)
+{
+  char buf[4] = { 0 };
+  int ch, i;
+  bool cr = false;
+
+  while (len > 0)
+  {
+    for (i = 0; (i < 4) && (len > 0); len--)
+    {
+      ch = fgetc(fp_in);
+      if (ch == EOF)
+        break;
+      if ((ch >= 0) && (ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
+        buf[i++] = ch;
+    }
+    if (i != 4)
+      break;
+
+    const int c1 = base64val(buf[0]);
+    const int c2 = base64val(buf[1]);
+    ref_put(fp_out, (c1 << 2) | (c2 >> 4), istext, &cr);
+
+    if (buf[2] == '=')
+      break;
+    const int c3 = base64val(buf[2]);
+    ref_put(fp_out, ((c2 & 0xf) << 4) | (c3 >> 2), istext, &cr);
+
+    if (buf[3] == '=')
+      break;
+    const int c4 = base64val(buf[3]);
+    ref_put(fp_out, ((c3 & 0x3) << 6) | c4, istext, &cr);
+  }
+
+  if (cr)
+    fputc('\r', fp_out);
+}
+
+/**
+ * ref_qp_decode_line - Decode a line of quoted-printable, a byte at a time
+ * @param dest Buffer for result
+ * @param src  Text to decode
+ * @param l    Bytes written to buffer
+ * @param last Last character of the line
+ */
+static void ref_qp_decode_line(char *dest, char *src, size_t *l, int last)
+{
+  char *d = dest;
+  char *s = src;
+  char c = 0;
+  int kind = -1;
+  bool soft = false;
+
+  while (*s)
+  {
+    if ((s[0] == '=') && (s[1] == '\0'))
+    {
+      kind = 1;
+      soft = true;
+      s++;
+    }
+    else if ((s[0] == '=') && isxdigit((unsigned char) s[1]) &&
+             isxdigit((unsigned char) s[2]))
+    {
+      kind = 0;
+      c = (hexval(s[1]) << 4) | hexval(s[2]);
+      *d++ = c;
+      s += 3;
+    }
+    else
+    {
+      kind = -1;
+      *d++ = *s++;
+    }
+  }
+
+  if (!soft && (last == '\n'))
+  {
+    if ((kind == 0) && (c == '\r'))
+      *(d - 1) = '\n';
+    else
+      *d++ = '\n';
+  }
+
+  *d = '\0';
+  *l = d - dest;
+}
+
+/**
+ * ref_decode_quoted - Decode quoted-printable, a byte at a time
+ * @param fp_in  File to read
+ * @param fp_out File to write
+ * @param len    Length of text to decode
+ */
+static void ref_decode_quoted(FILE *fp_in, FILE *fp_out, long len)
+{
+  char line[256] = { 0 };
+  char decline[512] = { 0 };
+  size_t l = 0;
+
+  while (len > 0)
+  {
+    if (!fgets(line, MIN((ssize_t) sizeof(line), len + 1), fp_in))
+      break;
+
+    size_t linelen = strlen(line);
+    len -= linelen;
+
+    const int last = (linelen != 0) ? line[linelen - 1] : 0;
+    if (last == '\n')
+    {
+      while ((linelen > 0) && isspace(line[linelen - 1]))
+        linelen--;
+      line[linelen] = '\0';
+    }
+
+    ref_qp_decode_line(decline, line, &l, last);
+    fwrite(decline, l, 1, fp_out);
+  }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if ((size < 1) || (size > 65536))
+    return -1;
+
+  MuttLogger = log_disp_null;
+  struct ConfigSet *cs = cs_new(16);
+  NeoMutt = neomutt_new(cs);
+  init_config(cs);
+  OptNoCurses = true;
+
+  const bool base64 = data[0] & 1;
+  const bool istext = data[0] & 2;
+  data++;
+  size--;
+
+  FILE *fp_in = tmpfile();
+  FILE *fp_ref = tmpfile();
+  FILE *fp_out = tmpfile();
+  if (!fp_in || !fp_ref || !fp_out)
+    abort();
+
+  fwrite(data, 1, size, fp_in);
+
+  // The original decoders
+  rewind(fp_in);
+  if (base64)
+    ref_decode_base64(fp_in, fp_ref, size, istext);
+  else
+    ref_decode_quoted(fp_in, fp_ref, size);
+  const long pos_ref = ftell(fp_in);
+
+  // The block decoders
+  struct Body *b = mutt_body_new();
+  b->type = istext ? TYPE_TEXT : TYPE_APPLICATION;
+  b->subtype = mutt_str_dup(istext ? "plain" : "octet-stream");
+  b->disposition = istext ? DISP_INLINE : DISP_ATTACH;
+  b->encoding = base64 ? ENC_BASE64 : ENC_QUOTED_PRINTABLE;
+  b->offset = 0;
+  b->length = size;
+
+  struct State state = { 0 };
+  state.fp_in = fp_in;
+  state.fp_out = fp_out;
+  mutt_decode_attachment(b, &state);
+  const long pos_out = ftell(fp_in);
+  mutt_body_free(&b);
+
+  // Compare the results
+  if (pos_ref != pos_out)
+    abort();
+
+  const long len_ref = ftell(fp_ref);
+  const long len_out = ftell(fp_out);
+  if (len_ref != len_out)
+    abort();
+
+  char *buf_ref = MUTT_MEM_MALLOC(len_ref + 1, char);
+  char *buf_out = MUTT_MEM_MALLOC(len_out + 1, char);
+  rewind(fp_ref);
+  rewind(fp_out);
+  if ((fread(buf_ref, 1, len_ref, fp_ref) != len_ref) ||
+      (fread(buf_out, 1, len_out, fp_out) != len_out) ||
+      (memcmp(buf_ref, buf_out, len_ref) != 0))
+  {
+    abort();
+  }
+
+  FREE(&buf_ref);
+  FREE(&buf_out);
+  fclose(fp_in);
+  fclose(fp_ref);
+  fclose(fp_out);
+  neomutt_free(&NeoMutt);
+  cs_free(&cs);
+  return 0;
+}
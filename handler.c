@@ -67,6 +67,7 @@
 
 #define BUFI_SIZE 1000
 #define BUFO_SIZE 2000
+#define BUFB_SIZE 8192
 
 #define TXT_HTML 1
 #define TXT_PLAIN 2
@@ -251,6 +252,17 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
 
   for (d = dest, s = src; *s;)
   {
+    /* copy the plain text up to the next '=' in one go */
+    const size_t span = strcspn(s, "=");
+    if (span > 0)
+    {
+      memcpy(d, s, span);
+      d += span;
+      s += span;
+      kind = -1;
+      continue;
+    }
+
     switch ((kind = qp_decode_triple(s, &c)))
     {
       case 0:
@@ -294,9 +306,10 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
  * means that we always can store the result in a buffer of at most the _same_
  * size.
  *
- * Now, we don't special-case if the line we read with fgets() isn't
- * terminated. We don't care about this, since 256 > 78, so corrupted input
- * will just be corrupted a bit more. That implies that 256+1 bytes are
+ * The input is read with fread() a block at a time, then split into lines of
+ * at most 255 bytes.  We don't special-case a line that isn't terminated.
+ * We don't care about this, since 256 > 78, so corrupted input will just be
+ * corrupted a bit more. That implies that 256+1 bytes are
  * always sufficient to store the result of qp_decode_line.
  *
  * Finally, at soft line breaks, some part of a multibyte character may have
@@ -309,6 +322,9 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
  */
 static void decode_quoted(struct State *state, long len, bool istext, iconv_t cd)
 {
+  char block[BUFB_SIZE];
+  size_t blen = 0;
+  size_t bpos = 0;
   char line[256] = { 0 };
   char decline[512] = { 0 };
   size_t l = 0;
@@ -323,10 +339,28 @@ static void decode_quoted(struct State *state, long len, bool istext, iconv_t cd
      * out to be longer than this.  Just process the line in chunks.  This
      * really shouldn't happen according the MIME spec, since Q-P encoded
      * lines are at most 76 characters, but we should be liberal about what
-     * we accept.  */
-    if (!fgets(line, MIN((ssize_t) sizeof(line), len + 1), state->fp_in))
+     * we accept.
+     *
+     * The lines are split out of a block of input, just as fgets() would. */
+    const size_t max = MIN(sizeof(line) - 1, (size_t) len);
+    char *nl = memchr(block + bpos, '\n', MIN(blen - bpos, max));
+    if (!nl && ((blen - bpos) < max))
+    {
+      memmove(block, block + bpos, blen - bpos);
+      blen -= bpos;
+      bpos = 0;
+      blen += fread(block + blen, 1, sizeof(block) - blen, state->fp_in);
+      nl = memchr(block, '\n', MIN(blen, max));
+    }
+
+    const size_t n = nl ? (nl - (block + bpos) + 1) : MIN(blen - bpos, max);
+    if (n == 0)
       break;
 
+    memcpy(line, block + bpos, n);
+    line[n] = '\0';
+    bpos += n;
+
     size_t linelen = strlen(line);
     len -= linelen;
 
@@ -348,6 +382,10 @@ static void decode_quoted(struct State *state, long len, bool istext, iconv_t cd
     convert_to_state(cd, decline, &l, state);
   }
 
+  /* leave the file just after the last line that was decoded */
+  if (bpos < blen)
+    fseeko(state->fp_in, -(LOFF_T) (blen - bpos), SEEK_CUR);
+
   convert_to_state(cd, 0, 0, state);
   state_reset_prefix(state);
 }
@@ -1530,11 +1568,17 @@ static int malformed_pgp_encrypted_handler(struct Body *b_email, struct State *s
  * @param len    Length of text to decode
  * @param istext Mime part is plain text
  * @param cd     Iconv conversion descriptor
+ *
+ * The input is read a block at a time, then split into groups of four valid
+ * characters.  Anything else, e.g. whitespace, is skipped.
  */
 void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd)
 {
+  unsigned char block[BUFB_SIZE];
+  size_t blen = 0;
+  size_t bpos = 0;
   char buf[5] = { 0 };
-  int ch, i;
+  int ch, i = 0;
   bool cr = false;
   char bufi[BUFI_SIZE] = { 0 };
   size_t l = 0;
@@ -1544,24 +1588,60 @@ void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd
   if (istext)
     state_set_prefix(state);
 
-  while (len > 0)
+  while (true)
   {
-    for (i = 0; (i < 4) && (len > 0); len--)
+    if (bpos == blen)
     {
-      ch = fgetc(state->fp_in);
-      if (ch == EOF)
+      if (len == 0)
         break;
-      if ((ch >= 0) && (ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
-        buf[i++] = ch;
+
+      blen = fread(block, 1, MIN(sizeof(block), len), state->fp_in);
+      if (blen == 0)
+        break;
+      len -= blen;
+      bpos = 0;
     }
-    if (i != 4)
+
+    /* Most of the input is unbroken runs of base64, decode them four at a time.
+     * Leave padding, line breaks and carriage returns to the loop below. */
+    while ((i == 0) && ((blen - bpos) >= 4))
     {
-      /* "i" may be zero if there is trailing whitespace, which is not an error */
-      if (i != 0)
-        mutt_debug(LL_DEBUG2, "didn't get a multiple of 4 chars\n");
-      break;
+      const unsigned char *p = block + bpos;
+      if ((p[0] | p[1] | p[2] | p[3]) & 0x80)
+        break;
+
+      const int c1 = base64val(p[0]);
+      const int c2 = base64val(p[1]);
+      const int c3 = base64val(p[2]);
+      const int c4 = base64val(p[3]);
+      if ((c1 | c2 | c3 | c4) < 0)
+        break;
+
+      const char o1 = (c1 << 2) | (c2 >> 4);
+      const char o2 = ((c2 & 0xf) << 4) | (c3 >> 2);
+      const char o3 = ((c3 & 0x3) << 6) | c4;
+      if (istext && (cr || (o1 == '\r') || (o2 == '\r') || (o3 == '\r')))
+        break;
+
+      bufi[l++] = o1;
+      bufi[l++] = o2;
+      bufi[l++] = o3;
+      bpos += 4;
+
+      if ((l + 8) >= sizeof(bufi))
+        convert_to_state(cd, bufi, &l, state);
     }
 
+    for (; (i < 4) && (bpos < blen); bpos++)
+    {
+      ch = block[bpos];
+      if ((ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
+        buf[i++] = ch;
+    }
+    if (i != 4)
+      continue;
+    i = 0;
+
     const int c1 = base64val(buf[0]);
     const int c2 = base64val(buf[1]);
 
@@ -1614,6 +1694,14 @@ void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd
       convert_to_state(cd, bufi, &l, state);
   }
 
+  /* "i" may be zero if there is trailing whitespace, which is not an error */
+  if (i != 0)
+    mutt_debug(LL_DEBUG2, "didn't get a multiple of 4 chars\n");
+
+  /* leave the file just after the last character that was decoded */
+  if (bpos < blen)
+    fseeko(state->fp_in, -(LOFF_T) (blen - bpos), SEEK_CUR);
+
   if (cr)
     bufi[l++] = '\r';
 
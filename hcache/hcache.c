@@ -546,6 +546,12 @@ void hcache_close(struct HeaderCache **ptr)
 
   struct HeaderCache *hc = *ptr;
 
+  if (hc->batch_depth > 0)
+  {
+    hc->batch_depth = 1;
+    hcache_commit_batch(hc);
+  }
+
 #ifdef USE_HCACHE_COMPRESSION
   if (hc->compr_ops)
     hc->compr_ops->close(&hc->compr_handle);
@@ -556,6 +562,45 @@ void hcache_close(struct HeaderCache **ptr)
   hcache_free(ptr);
 }
 
+/**
+ * hcache_begin_batch - Multiplexor for StoreOps::begin_batch
+ */
+int hcache_begin_batch(struct HeaderCache *hc)
+{
+  if (!hc)
+    return -1;
+
+  if (hc->batch_depth++ > 0)
+    return 0;
+
+  int rc = hc->store_ops->begin_batch(hc->store_handle);
+  if (rc != 0)
+  {
+    mutt_debug(LL_DEBUG1, "%s: begin_batch failed: %d\n", hc->store_ops->name, rc);
+    hc->batch_depth = 0;
+  }
+
+  return rc;
+}
+
+/**
+ * hcache_commit_batch - Multiplexor for StoreOps::commit_batch
+ */
+int hcache_commit_batch(struct HeaderCache *hc)
+{
+  if (!hc || (hc->batch_depth == 0))
+    return -1;
+
+  if (--hc->batch_depth > 0)
+    return 0;
+
+  int rc = hc->store_ops->commit_batch(hc->store_handle);
+  if (rc != 0)
+    mutt_debug(LL_DEBUG1, "%s: commit_batch failed: %d\n", hc->store_ops->name, rc);
+
+  return rc;
+}
+
 /**
  * hcache_fetch_email - Multiplexor for StoreOps::fetch
  */
@@ -593,8 +638,9 @@ struct HCacheEntry hcache_fetch_email(struct HeaderCache *hc, const char *key,
 #ifdef USE_HCACHE_COMPRESSION
   if (hc->compr_ops)
   {
-    void *dblob = hc->compr_ops->decompress(hc->compr_handle,
-                                            (char *) data + hlen, dlen - hlen);
+    size_t ulen = 0;
+    void *dblob = hc->compr_ops->decompress(hc->compr_handle, (char *) data + hlen,
+                                            dlen - hlen, &ulen);
     if (!dblob)
     {
       goto end;
@@ -90,6 +90,7 @@ struct HeaderCache
   StoreHandle *store_handle;          ///< Store handle
   const struct ComprOps *compr_ops;   ///< Compression backend
   ComprHandle *compr_handle;          ///< Compression handle
+  int batch_depth;                    ///< Nesting level of hcache_begin_batch()
 };
 
 /**
@@ -157,6 +158,28 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen, s
  */
 struct HCacheEntry hcache_fetch_email(struct HeaderCache *hc, const char *key, size_t keylen, uint32_t uidvalidity);
 
+/**
+ * hcache_begin_batch - Start a batch of writes to the header cache
+ * @param hc Pointer to the struct HeaderCache structure got by hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * Until hcache_commit_batch() is called, hcache_store_email() and friends may
+ * be grouped into a single transaction by the Store backend.
+ * Batches may be nested; only the outermost commit is passed to the backend.
+ */
+int hcache_begin_batch(struct HeaderCache *hc);
+
+/**
+ * hcache_commit_batch - Commit a batch of writes to the header cache
+ * @param hc Pointer to the struct HeaderCache structure got by hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * @note hcache_close() will commit any open batch
+ */
+int hcache_commit_batch(struct HeaderCache *hc);
+
 char *hcache_fetch_raw_str(struct HeaderCache *hc, const char *key, size_t keylen);
 bool  hcache_fetch_raw_obj_full(struct HeaderCache *hc, const char *key, size_t keylen, void *dst, size_t dstlen);
 #define hcache_fetch_raw_obj(hc, key, keylen, dst) hcache_fetch_raw_obj_full(hc, key, keylen, dst, sizeof(*dst))
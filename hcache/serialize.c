@@ -258,6 +258,36 @@ unsigned char *serial_dump_address(const struct AddressList *al,
   return d;
 }
 
+/**
+ * restore_address_part - Unpack an optional Address field from a binary blob
+ * @param[in]     d       Binary blob to read from
+ * @param[in,out] off     Offset into the blob
+ * @param[in]     convert If true, the strings will be converted from utf-8
+ * @retval ptr  New Buffer holding the field
+ * @retval NULL The field was empty
+ *
+ * Most Addresses have no personal name, so check for an empty field before
+ * allocating a Buffer for it.
+ */
+static struct Buffer *restore_address_part(const unsigned char *d, int *off, bool convert)
+{
+  unsigned int used = 0;
+  int peek = *off;
+  serial_restore_int(&used, d, &peek);
+  if (used == 0)
+  {
+    *off = peek;
+    return NULL;
+  }
+
+  struct Buffer *buf = buf_new(NULL);
+  serial_restore_buffer(buf, d, off, convert);
+  if (buf_is_empty(buf))
+    buf_free(&buf);
+
+  return buf;
+}
+
 /**
  * serial_restore_address - Unpack an Address from a binary blob
  * @param[out]    al      Store the unpacked AddressList here
@@ -277,19 +307,8 @@ void serial_restore_address(struct AddressList *al, const unsigned char *d,
   {
     struct Address *a = mutt_addr_new();
 
-    a->personal = buf_new(NULL);
-    serial_restore_buffer(a->personal, d, off, convert);
-    if (buf_is_empty(a->personal))
-    {
-      buf_free(&a->personal);
-    }
-
-    a->mailbox = buf_new(NULL);
-    serial_restore_buffer(a->mailbox, d, off, false);
-    if (buf_is_empty(a->mailbox))
-    {
-      buf_free(&a->mailbox);
-    }
+    a->personal = restore_address_part(d, off, convert);
+    a->mailbox = restore_address_part(d, off, false);
 
     serial_restore_int(&g, d, off);
     a->group = !!g;
@@ -388,11 +407,29 @@ void serial_restore_buffer(struct Buffer *buf, const unsigned char *d, int *off,
   if (used == 0)
     return;
 
-  char *str = NULL;
-  serial_restore_char(&str, d, off, convert);
+  unsigned int size = 0;
+  serial_restore_int(&size, d, off);
+  if (size == 0)
+    return;
+
+  // Copy the string straight from the blob, unless it needs converting
+  const char *str = (const char *) d + *off;
+  *off += size;
+
+  if (convert && !mutt_str_is_ascii(str, size - 1))
+  {
+    char *tmp = mutt_str_dup(str);
+    if (mutt_ch_convert_string(&tmp, "utf-8", cc_charset(), MUTT_ICONV_NO_FLAGS) == 0)
+    {
+      buf_addstr(buf, tmp);
+      FREE(&tmp);
+      return;
+    }
+    FREE(&tmp);
+  }
 
+  buf_alloc(buf, size);
   buf_addstr(buf, str);
-  FREE(&str);
 }
 
 /**
@@ -59,6 +59,8 @@ static int imap_timeout_observer(struct NotifyCallback *nc)
     imap_check_mailbox(adata->mailbox, true);
   }
 
+  imap_pool_poll(adata);
+
   mutt_debug(LL_DEBUG5, "imap timeout done\n");
   return 0;
 }
@@ -75,7 +77,10 @@ void imap_adata_free(void **ptr)
 
   notify_observer_remove(NeoMutt->notify_timeout, imap_timeout_observer, adata);
 
+  imap_pool_free(adata);
+
   FREE(&adata->capstr);
+  FREE(&adata->notify_list);
   buf_dealloc(&adata->cmdbuf);
   FREE(&adata->buf);
   FREE(&adata->cmds);
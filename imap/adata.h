@@ -31,6 +31,8 @@
 struct Account;
 struct Mailbox;
 
+ARRAY_HEAD(ImapAccountDataArray, struct ImapAccountData *);
+
 /**
  * struct ImapAccountData - IMAP-specific Account data - @extends Account
  *
@@ -76,6 +78,11 @@ struct ImapAccountData
   struct Mailbox *mailbox;      ///< Current selected mailbox
   struct Mailbox *prev_mailbox; ///< Previously selected mailbox
   struct Account *account;      ///< Parent Account
+
+  struct ImapAccountDataArray pool; ///< Secondary connections, see imap_pool_get()
+  bool pool_failed;                 ///< A pool connection couldn't be opened, don't retry
+
+  char *notify_list; ///< Mailboxes registered with NOTIFY, NULL if none
 };
 
 void                    imap_adata_free(void **ptr);
@@ -86,6 +86,7 @@ static const char *const Capabilities[] = {
   "COMPRESS=DEFLATE",
   "X-GM-EXT-1",
   "ID",
+  "NOTIFY",
   NULL,
 };
 
@@ -1144,35 +1145,38 @@ int imap_cmd_step(struct ImapAccountData *adata)
 
   /* read into buffer, expanding buffer as necessary until we have a full
    * line */
+  bool eol = false;
   do
   {
-    if (len == adata->blen)
-    {
-      MUTT_MEM_REALLOC(&adata->buf, adata->blen + IMAP_CMD_BUFSIZE, char);
-      adata->blen = adata->blen + IMAP_CMD_BUFSIZE;
-      mutt_debug(LL_DEBUG3, "grew buffer to %zu bytes\n", adata->blen);
-    }
-
-    /* back up over '\0' */
-    if (len)
-      len--;
-    c = mutt_socket_readln_d(adata->buf + len, adata->blen - len, adata->conn, MUTT_SOCK_LOG_FULL);
-    if (c <= 0)
+    const char *span = NULL;
+    c = mutt_socket_readln_span(adata->conn, SIZE_MAX, &span, &eol);
+    if (c < 0)
     {
       mutt_debug(LL_DEBUG1, "Error reading server response\n");
       cmd_handle_fatal(adata);
       return IMAP_RES_BAD;
     }
 
+    if ((len + c + 1) > adata->blen)
+    {
+      adata->blen = ((len + c) / IMAP_CMD_BUFSIZE + 1) * IMAP_CMD_BUFSIZE;
+      MUTT_MEM_REALLOC(&adata->buf, adata->blen, char);
+      mutt_debug(LL_DEBUG3, "grew buffer to %zu bytes\n", adata->blen);
+    }
+
+    memcpy(adata->buf + len, span, c);
     len += c;
-  }
-  /* if we've read all the way to the end of the buffer, we haven't read a
-   * full line (mutt_socket_readln strips the \r, so we always have at least
-   * one character free when we've read a full line) */
-  while (len == adata->blen);
+  } while (!eol);
+
+  /* strip \r from \r\n termination */
+  if (len && (adata->buf[len - 1] == '\r'))
+    len--;
+  adata->buf[len] = '\0';
+
+  mutt_debug(MUTT_SOCK_LOG_FULL, "%d< %s\n", adata->conn->fd, adata->buf);
 
   /* don't let one large string make cmd->buf hog memory forever */
-  if ((adata->blen > IMAP_CMD_BUFSIZE) && (len <= IMAP_CMD_BUFSIZE))
+  if ((adata->blen > IMAP_CMD_BUFSIZE) && (len < IMAP_CMD_BUFSIZE))
   {
     MUTT_MEM_REALLOC(&adata->buf, IMAP_CMD_BUFSIZE, char);
     adata->blen = IMAP_CMD_BUFSIZE;
@@ -93,6 +93,9 @@ static struct ConfigDef ImapVars[] = {
   { "imap_login", DT_STRING|D_SENSITIVE, 0, 0, NULL,
     "(imap) Login name for the IMAP server (defaults to `$imap_user`)"
   },
+  { "imap_notify", DT_BOOL, false, 0, NULL,
+    "(imap) Let the server push mailbox changes, using the IMAP NOTIFY extension"
+  },
   { "imap_oauth_refresh_command", DT_STRING|D_STRING_COMMAND|D_SENSITIVE, 0, 0, NULL,
     "(imap) External command to generate OAUTH refresh token"
   },
@@ -123,6 +126,12 @@ static struct ConfigDef ImapVars[] = {
   { "imap_poll_timeout", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 15, 0, NULL,
     "(imap) Maximum time to wait for a server response"
   },
+  { "imap_pool_size", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(imap) Number of extra connections to use for background work"
+  },
+  { "imap_prefetch", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(imap) Number of messages to fetch in advance while idle"
+  },
   { "imap_qresync", DT_BOOL, false, 0, NULL,
     "(imap) Enable the QRESYNC extension"
   },
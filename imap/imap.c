@@ -571,6 +571,11 @@ void imap_logout_all(void)
       continue;
 
     mutt_message(_("Closing connection to %s..."), conn->account.host);
+    struct ImapAccountData **pp = NULL;
+    ARRAY_FOREACH(pp, &adata->pool)
+    {
+      imap_logout(*pp);
+    }
     imap_logout(np->adata);
     mutt_clear_error();
   }
@@ -860,6 +865,7 @@ void imap_close_connection(struct ImapAccountData *adata)
   adata->nextcmd = 0;
   adata->lastcmd = 0;
   adata->status = 0;
+  FREE(&adata->notify_list);
   memset(adata->cmds, 0, sizeof(struct ImapCommand) * adata->cmdslots);
 }
 
@@ -1081,6 +1087,8 @@ enum MxStatus imap_check_mailbox(struct Mailbox *m, bool force)
    * changes to process, since we can reopen here. */
   imap_cmd_finish(adata);
 
+  imap_pool_poll(adata);
+
   enum MxStatus check = MX_STATUS_OK;
   if (mdata->check_status & IMAP_EXPUNGE_PENDING)
     check = MX_STATUS_REOPENED;
@@ -1143,6 +1151,24 @@ static int imap_status(struct ImapAccountData *adata, struct ImapMboxData *mdata
   snprintf(cmd, sizeof(cmd), "STATUS %s (UIDNEXT %s UNSEEN RECENT MESSAGES)",
            mdata->munge_name, uidvalidity_flag);
 
+  /* Keep STATUS polling off the connection of the selected Mailbox.
+   * Queued commands are sent at once, and the responses are processed as
+   * they arrive, by imap_pool_poll(). */
+  struct ImapAccountData *pdata = imap_pool_get(adata);
+  if (pdata)
+  {
+    imap_pool_poll(adata);
+    int rc = imap_exec(pdata, cmd, queue ? IMAP_CMD_QUEUE : IMAP_CMD_POLL);
+    if (queue && (rc == IMAP_EXEC_SUCCESS) && (imap_cmd_start(pdata, NULL) < 0))
+      rc = IMAP_EXEC_ERROR;
+    if (rc != IMAP_EXEC_SUCCESS)
+    {
+      mutt_debug(LL_DEBUG1, "Error sending command on pool connection\n");
+      return rc;
+    }
+    return mdata->messages;
+  }
+
   int rc = imap_exec(adata, cmd, queue ? IMAP_CMD_QUEUE : IMAP_CMD_POLL);
   if (rc != IMAP_EXEC_SUCCESS)
   {
@@ -1152,13 +1178,113 @@ static int imap_status(struct ImapAccountData *adata, struct ImapMboxData *mdata
   return mdata->messages;
 }
 
+/**
+ * imap_notify_set - Ask the server to push changes to the watched Mailboxes
+ * @param adata Imap Account data
+ * @retval true  The server will send STATUS updates, see RFC5465
+ * @retval false NOTIFY isn't available, poll the Mailboxes with STATUS
+ *
+ * The NOTIFY command is only sent again if the set of watched Mailboxes
+ * changes, or after a reconnect.  The server replies with the current STATUS
+ * of every Mailbox in the list.
+ */
+static bool imap_notify_set(struct ImapAccountData *adata)
+{
+  const bool c_imap_notify = cs_subset_bool(NeoMutt->sub, "imap_notify");
+  if (!c_imap_notify || !(adata->capabilities & IMAP_CAP_NOTIFY) ||
+      (adata->state < IMAP_AUTHENTICATED))
+  {
+    return false;
+  }
+
+  int count = 0;
+  struct Buffer *list = buf_pool_get();
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &adata->account->mailboxes, entries)
+  {
+    struct ImapMboxData *mdata = imap_mdata_get(np->mailbox);
+    if (!mdata || !np->mailbox->visible || !np->mailbox->poll_new_mail)
+      continue;
+    if (count > 0)
+      buf_addch(list, ' ');
+    buf_addstr(list, mdata->munge_name);
+    count++;
+  }
+
+  bool rc = true;
+  if (count == 0)
+  {
+    rc = false;
+    goto done;
+  }
+  if (mutt_str_equal(buf_string(list), adata->notify_list))
+    goto done;
+
+  /* Use SELECTED-DELAYED, so that the server doesn't send EXPUNGE responses
+   * for the selected Mailbox between commands, see RFC5465 5.1 */
+  struct Buffer *cmd = buf_pool_get();
+  buf_printf(cmd, "NOTIFY SET STATUS (SELECTED-DELAYED (MessageNew MessageExpunge FlagChange)) "
+                  "(MAILBOXES (%s) (MessageNew MessageExpunge FlagChange))",
+             buf_string(list));
+
+  const int rc_exec = imap_exec(adata, buf_string(cmd), IMAP_CMD_NO_FLAGS);
+  buf_pool_release(&cmd);
+  if (rc_exec != IMAP_EXEC_SUCCESS)
+  {
+    mutt_debug(LL_DEBUG1, "NOTIFY failed, falling back to STATUS\n");
+    adata->capabilities &= ~IMAP_CAP_NOTIFY; // Clear the flag
+    FREE(&adata->notify_list);
+    rc = false;
+    goto done;
+  }
+
+  mutt_debug(LL_DEBUG2, "NOTIFY set for %d mailboxes\n", count);
+  mutt_str_replace(&adata->notify_list, buf_string(list));
+
+done:
+  buf_pool_release(&list);
+  return rc;
+}
+
+/**
+ * imap_notify_poll - Process any updates the server has pushed
+ * @param adata Imap Account data
+ *
+ * This doesn't wait for the server, it only handles data that has already
+ * arrived.
+ */
+static void imap_notify_poll(struct ImapAccountData *adata)
+{
+  while (mutt_socket_poll(adata->conn, 0) > 0)
+  {
+    if (imap_cmd_step(adata) == IMAP_RES_BAD)
+      break;
+  }
+}
+
 /**
  * imap_mbox_check_stats - Check the Mailbox statistics - Implements MxOps::mbox_check_stats() - @ingroup mx_mbox_check_stats
  */
 static enum MxStatus imap_mbox_check_stats(struct Mailbox *m, uint8_t flags)
 {
   const bool queue = (flags & MUTT_MAILBOX_CHECK_IMMEDIATE) == 0;
-  const int new_msgs = imap_mailbox_status(m, queue);
+  struct ImapAccountData *adata = imap_adata_get(m);
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+
+  /* With NOTIFY, the server sends the STATUS of the watched Mailboxes when
+   * they change, so a routine check only needs to read what's arrived. */
+  int new_msgs;
+  if (queue && adata && mdata && (adata->mailbox != m) && m->visible &&
+      m->poll_new_mail && imap_notify_set(adata))
+  {
+    imap_notify_poll(adata);
+    new_msgs = mdata->messages;
+  }
+  else
+  {
+    new_msgs = imap_mailbox_status(m, queue);
+  }
+
   if (new_msgs == -1)
     return MX_STATUS_ERROR;
   if (new_msgs == 0)
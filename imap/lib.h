@@ -47,6 +47,7 @@
  * | imap/message.c    | @subpage imap_message    |
  * | imap/msg_set.c    | @subpage imap_msg_set    |
  * | imap/msn.c        | @subpage imap_msn        |
+ * | imap/pool.c       | @subpage imap_pool       |
  * | imap/search.c     | @subpage imap_search     |
  * | imap/utf7.c       | @subpage imap_utf7       |
  * | imap/util.c       | @subpage imap_util       |
@@ -94,6 +95,7 @@ int imap_mailbox_rename(const char *path);
 
 /* message.c */
 int imap_copy_messages(struct Mailbox *m, struct EmailArray *ea, const char *dest, enum MessageSaveOpt save_opt);
+void imap_prefetch(struct Mailbox *m, struct Email *e);
 
 /* socket.c */
 void imap_logout_all(void);
@@ -119,6 +119,26 @@ static FILE *msg_cache_get(struct Mailbox *m, struct Email *e)
   return mutt_bcache_get(mdata->bcache, id);
 }
 
+/**
+ * msg_cache_exists - Is an email in the message cache?
+ * @param m     Selected Imap Mailbox
+ * @param e     Email
+ * @retval true The email is in the cache
+ */
+static bool msg_cache_exists(struct Mailbox *m, struct Email *e)
+{
+  struct ImapAccountData *adata = imap_adata_get(m);
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+
+  if (!e || !adata || (adata->mailbox != m))
+    return false;
+
+  mdata->bcache = imap_bcache_open(m);
+  char id[64] = { 0 };
+  snprintf(id, sizeof(id), "%u-%u", mdata->uidvalidity, imap_edata_get(e)->uid);
+  return (mutt_bcache_exists(mdata->bcache, id) == 0);
+}
+
 /**
  * msg_cache_put - Put an email into the message cache
  * @param m     Selected Imap Mailbox
@@ -162,6 +182,118 @@ static int msg_cache_commit(struct Mailbox *m, struct Email *e)
   return mutt_bcache_commit(mdata->bcache, id);
 }
 
+/**
+ * msg_fetch_body - Fetch a whole message from the server
+ * @param m    Selected Imap Mailbox
+ * @param e    Email to fetch
+ * @param fp   File for the message
+ * @param peek If true, don't mark the message as read on the server
+ * @retval true Success
+ */
+static bool msg_fetch_body(struct Mailbox *m, struct Email *e, FILE *fp, bool peek)
+{
+  struct ImapAccountData *adata = imap_adata_get(m);
+  char buf[1024] = { 0 };
+  char *pc = NULL;
+  unsigned int bytes;
+  unsigned int uid;
+  int rc;
+
+  /* Sam's weird courier server returns an OK response even when FETCH
+   * fails. Thanks Sam. */
+  bool fetched = false;
+
+  /* mark this header as currently inactive so the command handler won't
+   * also try to update it. HACK until all this code can be moved into the
+   * command handler */
+  e->active = false;
+
+  snprintf(buf, sizeof(buf), "UID FETCH %u %s", imap_edata_get(e)->uid,
+           ((adata->capabilities & IMAP_CAP_IMAP4REV1) ?
+                (peek ? "BODY.PEEK[]" : "BODY[]") :
+                "RFC822"));
+
+  imap_cmd_start(adata, buf);
+  do
+  {
+    rc = imap_cmd_step(adata);
+    if (rc != IMAP_RES_CONTINUE)
+      break;
+
+    pc = adata->buf;
+    pc = imap_next_word(pc);
+    pc = imap_next_word(pc);
+
+    if (mutt_istr_startswith(pc, "FETCH"))
+    {
+      while (*pc)
+      {
+        pc = imap_next_word(pc);
+        if (pc[0] == '(')
+          pc++;
+        if (mutt_istr_startswith(pc, "UID"))
+        {
+          pc = imap_next_word(pc);
+          if (!mutt_str_atoui(pc, &uid))
+            goto bail;
+          if (uid != imap_edata_get(e)->uid)
+          {
+            mutt_error(_("The message index is incorrect. Try reopening the mailbox."));
+          }
+        }
+        else if (mutt_istr_startswith(pc, "RFC822") || mutt_istr_startswith(pc, "BODY[]"))
+        {
+          pc = imap_next_word(pc);
+          if (imap_get_literal_count(pc, &bytes) < 0)
+          {
+            imap_error("imap_msg_open()", buf);
+            goto bail;
+          }
+
+          const int res = imap_read_literal(fp, adata, bytes, NULL);
+          if (res < 0)
+          {
+            goto bail;
+          }
+          /* pick up trailing line */
+          rc = imap_cmd_step(adata);
+          if (rc != IMAP_RES_CONTINUE)
+            goto bail;
+          pc = adata->buf;
+
+          fetched = true;
+        }
+        else if (!e->changed && mutt_istr_startswith(pc, "FLAGS"))
+        {
+          /* UW-IMAP will provide a FLAGS update here if the FETCH causes a
+           * change (eg from \Unseen to \Seen).
+           * Uncommitted changes in neomutt take precedence. If we decide to
+           * incrementally update flags later, this won't stop us syncing */
+          pc = imap_set_flags(m, e, pc, NULL);
+          if (!pc)
+            goto bail;
+        }
+      }
+    }
+  } while (rc == IMAP_RES_CONTINUE);
+
+  /* see comment before command start. */
+  e->active = true;
+
+  fflush(fp);
+  if (ferror(fp))
+    return false;
+
+  if (rc != IMAP_RES_OK)
+    return false;
+
+  return fetched && imap_code(adata->buf);
+
+bail:
+  e->active = true;
+  return false;
+}
+
 /**
  * imap_bcache_delete - Delete an entry from the message cache - Implements ::bcache_list_t - @ingroup bcache_list_api
  * @retval 0 Always
@@ -1172,20 +1304,54 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
    *
    *   I believe the new chunking imap_fetch_msn_seqset()
    *   implementation and "msn_begin = fetch_msn_end + 1" assignment
-   *   at the end of the loop makes the comparison unneeded, but to be
+   *   after queuing each chunk makes the comparison unneeded, but to be
    *   cautious I'm keeping it.
+   *
+   *   Up to $imap_pipeline_depth chunks are sent together, so a slow link
+   *   costs one round trip per batch, rather than one per chunk.  The batch
+   *   must fit in the free command slots, otherwise cmd_queue() would drain
+   *   the queue, and our FETCH responses, behind our back.
    */
+  const short c_imap_pipeline_depth = cs_subset_number(NeoMutt->sub, "imap_pipeline_depth");
+  const int queued = (adata->nextcmd - adata->lastcmd + adata->cmdslots) % adata->cmdslots;
+  const int depth = MAX(MIN(c_imap_pipeline_depth, adata->cmdslots - 1 - queued), 1);
+
   edata = imap_edata_new();
-  while ((fetch_msn_end < msn_end) &&
-         imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end, &fetch_msn_end))
+  while (fetch_msn_end < msn_end)
   {
-    char *cmd = NULL;
-    mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
-                      buf_string(buf), hdrreq);
-    imap_cmd_start(adata, cmd);
-    FREE(&cmd);
-
+    const uint64_t start_ms = mutt_date_now_ms();
     int msgno = msn_begin;
+    int chunks = 0;
+    const int first_cmd = adata->nextcmd;
+
+    while ((chunks < depth) && (fetch_msn_end < msn_end) &&
+           imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end, &fetch_msn_end))
+    {
+      char *cmd = NULL;
+      mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
+                        buf_string(buf), hdrreq);
+      const int rc_queue = imap_exec(adata, cmd, IMAP_CMD_QUEUE);
+      FREE(&cmd);
+      if (rc_queue != IMAP_EXEC_SUCCESS)
+        goto bail;
+      chunks++;
+
+      /* Note: RFC3501 section 7.4.1 and RFC7162 section 3.2.10.2 say we
+       * must not get any EXPUNGE/VANISHED responses in the middle of a
+       * FETCH, nor when no command is in progress (e.g. between the
+       * chunked FETCH commands).  We previously tried to be robust by
+       * setting:
+       *   msn_begin = mdata->max_msn + 1;
+       * but with chunking and header cache holes this
+       * may not be correct.  So here we must assume the msn values have
+       * not been altered during or after the fetch.  */
+      msn_begin = fetch_msn_end + 1;
+    }
+
+    if (chunks == 0)
+      break;
+
+    imap_cmd_start(adata, NULL);
 
     while (true)
     {
@@ -1288,6 +1454,19 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
 #endif /* USE_HCACHE */
     }
 
+    /* imap_cmd_step() only reports the status of the last command to
+     * finish.  If any chunk failed, its headers are missing, so give up
+     * rather than record a UIDNEXT past them. */
+    for (int i = 0; i < chunks; i++)
+    {
+      const struct ImapCommand *cmd = &adata->cmds[(first_cmd + i) % adata->cmdslots];
+      if (cmd->state != IMAP_RES_OK)
+      {
+        mutt_debug(LL_DEBUG1, "header FETCH %s failed\n", cmd->seq);
+        goto bail;
+      }
+    }
+
     /* In case we get new mail while fetching the headers. */
     if (mdata->reopen & IMAP_NEWMAIL_PENDING)
     {
@@ -1298,16 +1477,8 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
       mdata->new_mail_count = 0;
     }
 
-    /* Note: RFC3501 section 7.4.1 and RFC7162 section 3.2.10.2 say we
-     * must not get any EXPUNGE/VANISHED responses in the middle of a
-     * FETCH, nor when no command is in progress (e.g. between the
-     * chunked FETCH commands).  We previously tried to be robust by
-     * setting:
-     *   msn_begin = mdata->max_msn + 1;
-     * but with chunking and header cache holes this
-     * may not be correct.  So here we must assume the msn values have
-     * not been altered during or after the fetch.  */
-    msn_begin = fetch_msn_end + 1;
+    mutt_debug(LL_DEBUG2, "fetched %d header chunks (pipeline depth %d) in %llu ms\n",
+               chunks, depth, (unsigned long long) (mutt_date_now_ms() - start_ms));
   }
 
   rc = 0;
@@ -1375,6 +1546,7 @@ retry:
 
 #ifdef USE_HCACHE
   imap_hcache_open(adata, mdata, true);
+  hcache_begin_batch(mdata->hcache);
 
   if (mdata->hcache && initial_download)
   {
@@ -1978,16 +2150,8 @@ bool imap_msg_open(struct Mailbox *m, struct Message *msg, struct Email *e)
 {
   struct Envelope *newenv = NULL;
   char buf[1024] = { 0 };
-  char *pc = NULL;
-  unsigned int bytes;
-  unsigned int uid;
   bool retried = false;
   bool read;
-  int rc;
-
-  /* Sam's weird courier server returns an OK response even when FETCH
-   * fails. Thanks Sam. */
-  bool fetched = false;
 
   struct ImapAccountData *adata = imap_adata_get(m);
 
@@ -2021,92 +2185,8 @@ bool imap_msg_open(struct Mailbox *m, struct Message *msg, struct Email *e)
       return false;
   }
 
-  /* mark this header as currently inactive so the command handler won't
-   * also try to update it. HACK until all this code can be moved into the
-   * command handler */
-  e->active = false;
-
   const bool c_imap_peek = cs_subset_bool(NeoMutt->sub, "imap_peek");
-  snprintf(buf, sizeof(buf), "UID FETCH %u %s", imap_edata_get(e)->uid,
-           ((adata->capabilities & IMAP_CAP_IMAP4REV1) ?
-                (c_imap_peek ? "BODY.PEEK[]" : "BODY[]") :
-                "RFC822"));
-
-  imap_cmd_start(adata, buf);
-  do
-  {
-    rc = imap_cmd_step(adata);
-    if (rc != IMAP_RES_CONTINUE)
-      break;
-
-    pc = adata->buf;
-    pc = imap_next_word(pc);
-    pc = imap_next_word(pc);
-
-    if (mutt_istr_startswith(pc, "FETCH"))
-    {
-      while (*pc)
-      {
-        pc = imap_next_word(pc);
-        if (pc[0] == '(')
-          pc++;
-        if (mutt_istr_startswith(pc, "UID"))
-        {
-          pc = imap_next_word(pc);
-          if (!mutt_str_atoui(pc, &uid))
-            goto bail;
-          if (uid != imap_edata_get(e)->uid)
-          {
-            mutt_error(_("The message index is incorrect. Try reopening the mailbox."));
-          }
-        }
-        else if (mutt_istr_startswith(pc, "RFC822") || mutt_istr_startswith(pc, "BODY[]"))
-        {
-          pc = imap_next_word(pc);
-          if (imap_get_literal_count(pc, &bytes) < 0)
-          {
-            imap_error("imap_msg_open()", buf);
-            goto bail;
-          }
-
-          const int res = imap_read_literal(msg->fp, adata, bytes, NULL);
-          if (res < 0)
-          {
-            goto bail;
-          }
-          /* pick up trailing line */
-          rc = imap_cmd_step(adata);
-          if (rc != IMAP_RES_CONTINUE)
-            goto bail;
-          pc = adata->buf;
-
-          fetched = true;
-        }
-        else if (!e->changed && mutt_istr_startswith(pc, "FLAGS"))
-        {
-          /* UW-IMAP will provide a FLAGS update here if the FETCH causes a
-           * change (eg from \Unseen to \Seen).
-           * Uncommitted changes in neomutt take precedence. If we decide to
-           * incrementally update flags later, this won't stop us syncing */
-          pc = imap_set_flags(m, e, pc, NULL);
-          if (!pc)
-            goto bail;
-        }
-      }
-    }
-  } while (rc == IMAP_RES_CONTINUE);
-
-  /* see comment before command start. */
-  e->active = true;
-
-  fflush(msg->fp);
-  if (ferror(msg->fp))
-    goto bail;
-
-  if (rc != IMAP_RES_OK)
-    goto bail;
-
-  if (!fetched || !imap_code(adata->buf))
+  if (!msg_fetch_body(m, e, msg->fp, c_imap_peek))
     goto bail;
 
   if (msg_cache_commit(m, e) < 0)
@@ -2162,6 +2242,58 @@ bail:
   return false;
 }
 
+/**
+ * imap_prefetch - Fetch the next messages into the message cache
+ * @param m Mailbox
+ * @param e Current Email
+ *
+ * This is called when the user is idle in the Index or Pager.  It looks at the
+ * `$imap_prefetch` messages following the current one, in display order, and
+ * fetches the first one that isn't in the message cache.
+ *
+ * Only one message is fetched per call, so a keypress is never kept waiting
+ * for more than one message.  The messages are fetched with BODY.PEEK, so they
+ * aren't marked as read.
+ */
+void imap_prefetch(struct Mailbox *m, struct Email *e)
+{
+  if (!m || !e || (m->type != MUTT_IMAP) || !m->v2r || (e->vnum < 0))
+    return;
+
+  const short c_imap_prefetch = cs_subset_number(NeoMutt->sub, "imap_prefetch");
+  if (c_imap_prefetch <= 0)
+    return;
+
+  struct ImapAccountData *adata = imap_adata_get(m);
+  if (!adata || (adata->mailbox != m) || (adata->state != IMAP_SELECTED))
+    return;
+
+  for (int i = 1; (i <= c_imap_prefetch) && ((e->vnum + i) < m->vcount); i++)
+  {
+    struct Email *e_next = m->emails[m->v2r[e->vnum + i]];
+    if (!e_next || !imap_edata_get(e_next) || msg_cache_exists(m, e_next))
+      continue;
+
+    FILE *fp = msg_cache_put(m, e_next);
+    if (!fp)
+      return; // The message cache is disabled
+
+    mutt_debug(LL_DEBUG2, "prefetching uid %u\n", imap_edata_get(e_next)->uid);
+    if (msg_fetch_body(m, e_next, fp, true))
+    {
+      mutt_file_fclose(&fp);
+      if (msg_cache_commit(m, e_next) < 0)
+        mutt_debug(LL_DEBUG1, "failed to add message to cache\n");
+    }
+    else
+    {
+      mutt_file_fclose(&fp);
+      imap_cache_del(m, e_next);
+    }
+    return;
+  }
+}
+
 /**
  * imap_msg_commit - Save changes to an email - Implements MxOps::msg_commit() - @ingroup mx_msg_commit
  *
@@ -0,0 +1,173 @@
+/**
+ * @file
+ * Pool of secondary IMAP connections
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page imap_pool Pool of secondary IMAP connections
+ *
+ * An Account may keep a few extra authenticated connections to the server,
+ * alongside the one that has a Mailbox SELECTed.  Background work, such as
+ * polling the STATUS of other mailboxes, runs on these, so it never delays the
+ * commands of the selected Mailbox.
+ *
+ * The pool connections never SELECT a Mailbox, so the responses they receive
+ * are limited to things like STATUS, LIST and the tagged completions.
+ *
+ * The size of the pool is limited by `$imap_pool_size`.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "conn/lib.h"
+#include "adata.h"
+#include "mutt_socket.h"
+
+/**
+ * pool_pending - Count the commands waiting for a response
+ * @param pdata Imap Account data of a pool connection
+ * @retval num Number of commands in the queue
+ */
+static int pool_pending(const struct ImapAccountData *pdata)
+{
+  return (pdata->nextcmd - pdata->lastcmd + pdata->cmdslots) % pdata->cmdslots;
+}
+
+/**
+ * pool_connect - Open and log in a new pool connection
+ * @param adata Imap Account data of the primary connection
+ * @retval ptr  New pool connection
+ * @retval NULL Error
+ */
+static struct ImapAccountData *pool_connect(struct ImapAccountData *adata)
+{
+  struct ImapAccountData *pdata = imap_adata_new(adata->account);
+
+  // Reuse the credentials that the primary connection logged in with
+  pdata->conn = mutt_conn_new(&adata->conn->account);
+  if (!pdata->conn || (imap_login(pdata) < 0))
+  {
+    imap_adata_free((void **) &pdata);
+    return NULL;
+  }
+
+  mutt_debug(LL_DEBUG1, "opened pool connection %d to %s\n",
+             ARRAY_SIZE(&adata->pool) + 1, adata->conn->account.host);
+  return pdata;
+}
+
+/**
+ * imap_pool_get - Get a pool connection for background work
+ * @param adata Imap Account data of the primary connection
+ * @retval ptr  Pool connection
+ * @retval NULL The pool is disabled, or no connection could be opened
+ *
+ * An idle connection is preferred.  If they are all busy, a new one is opened,
+ * up to `$imap_pool_size`.  Otherwise, the least busy connection is used.
+ *
+ * If NULL is returned, the caller should fall back to the primary connection.
+ */
+struct ImapAccountData *imap_pool_get(struct ImapAccountData *adata)
+{
+  if (!adata || !adata->conn || !adata->account)
+    return NULL;
+
+  const short c_imap_pool_size = cs_subset_number(NeoMutt->sub, "imap_pool_size");
+  if ((c_imap_pool_size <= 0) || (adata->state < IMAP_AUTHENTICATED))
+    return NULL;
+
+  struct ImapAccountData *best = NULL;
+  struct ImapAccountData **pp = NULL;
+  ARRAY_FOREACH(pp, &adata->pool)
+  {
+    struct ImapAccountData *pdata = *pp;
+    if (pdata->state < IMAP_AUTHENTICATED)
+      continue;
+
+    if (!best || (pool_pending(pdata) < pool_pending(best)))
+      best = pdata;
+  }
+
+  if (best && (pool_pending(best) == 0))
+    return best;
+
+  if (!adata->pool_failed && (ARRAY_SIZE(&adata->pool) < c_imap_pool_size))
+  {
+    struct ImapAccountData *pdata = pool_connect(adata);
+    if (pdata)
+    {
+      ARRAY_ADD(&adata->pool, pdata);
+      return pdata;
+    }
+
+    // Don't keep trying, e.g. if the server limits the number of connections
+    mutt_debug(LL_DEBUG1, "can't open a pool connection to %s\n",
+               adata->conn->account.host);
+    adata->pool_failed = true;
+  }
+
+  return best;
+}
+
+/**
+ * imap_pool_poll - Process any responses waiting on the pool connections
+ * @param adata Imap Account data of the primary connection
+ *
+ * This doesn't wait for the server, it only handles data that has already
+ * arrived.
+ */
+void imap_pool_poll(struct ImapAccountData *adata)
+{
+  if (!adata)
+    return;
+
+  struct ImapAccountData **pp = NULL;
+  ARRAY_FOREACH(pp, &adata->pool)
+  {
+    struct ImapAccountData *pdata = *pp;
+    while ((pdata->state >= IMAP_AUTHENTICATED) && (pool_pending(pdata) > 0) &&
+           (mutt_socket_poll(pdata->conn, 0) > 0))
+    {
+      if (imap_cmd_step(pdata) == IMAP_RES_BAD)
+        break;
+    }
+  }
+}
+
+/**
+ * imap_pool_free - Close all the pool connections
+ * @param adata Imap Account data of the primary connection
+ */
+void imap_pool_free(struct ImapAccountData *adata)
+{
+  if (!adata)
+    return;
+
+  struct ImapAccountData **pp = NULL;
+  ARRAY_FOREACH(pp, &adata->pool)
+  {
+    imap_adata_free((void **) pp);
+  }
+  ARRAY_FREE(&adata->pool);
+}
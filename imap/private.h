@@ -139,8 +139,9 @@ typedef uint32_t ImapCapFlags;              ///< Flags, e.g. #IMAP_CAP_IMAP4
 #define IMAP_CAP_COMPRESS         (1 << 18) ///< RFC4978: COMPRESS=DEFLATE
 #define IMAP_CAP_X_GM_EXT_1       (1 << 19) ///< https://developers.google.com/gmail/imap/imap-extensions
 #define IMAP_CAP_ID               (1 << 20) ///< RFC2971: IMAP4 ID extension
+#define IMAP_CAP_NOTIFY           (1 << 21) ///< RFC5465: IMAP NOTIFY extension
 
-#define IMAP_CAP_ALL             ((1 << 21) - 1)
+#define IMAP_CAP_ALL             ((1 << 22) - 1)
 
 /**
  * struct ImapList - Items in an IMAP browser
@@ -254,6 +255,11 @@ void imap_utf_decode(bool unicode, char **s);
 void imap_allow_reopen(struct Mailbox *m);
 void imap_disallow_reopen(struct Mailbox *m);
 
+/* pool.c */
+void                    imap_pool_free(struct ImapAccountData *adata);
+struct ImapAccountData *imap_pool_get (struct ImapAccountData *adata);
+void                    imap_pool_poll(struct ImapAccountData *adata);
+
 /* search.c */
 void cmd_parse_search(struct ImapAccountData *adata, const char *s);
 
@@ -71,6 +71,7 @@
 #include "lib.h"
 #include "color/lib.h"
 #include "expando/lib.h"
+#include "imap/lib.h"
 #include "key/lib.h"
 #include "menu/lib.h"
 #include "nntp/lib.h"
@@ -821,6 +822,10 @@ int mutt_make_string(struct Buffer *buf, size_t max_cols,
 /**
  * index_make_entry - Format an Email for the Menu - Implements Menu::make_entry() - @ingroup menu_make_entry
  *
+ * The rendered row is cached in the Email.  It's reused until the Mailbox's
+ * view_gen changes, or the row is drawn at a different width or with
+ * different format flags.
+ *
  * @sa $index_format
  */
 int index_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *buf)
@@ -918,7 +923,27 @@ int index_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *b
       max_cols -= (mutt_strwidth(c_arrow_string) + 1);
   }
 
-  return mutt_make_string(buf, max_cols, c_index_format, m, msg_in_pager, e, flags, NULL);
+  // Searching the Menu uses an unlimited width; don't cache those rows.
+  // Date conditions, e.g. %<[1d?...>, depend on the time, so rows using them
+  // can go stale without the Mailbox changing.
+  if ((max_cols <= 0) || (c_index_format && node_find_type(c_index_format->node, ENT_CONDDATE)))
+    return mutt_make_string(buf, max_cols, c_index_format, m, msg_in_pager, e, flags, NULL);
+
+  const bool in_pager = (msg_in_pager == e->msgno);
+  const int key = (max_cols << 9) | (in_pager << 8) | flags;
+  if (e->index_row && (e->index_row_gen == m->view_gen) && (e->index_row_key == key))
+  {
+    buf_strcpy(buf, e->index_row);
+    return e->index_row_cols;
+  }
+
+  int cols = mutt_make_string(buf, max_cols, c_index_format, m, msg_in_pager, e, flags, NULL);
+
+  mutt_str_replace(&e->index_row, buf_string(buf));
+  e->index_row_gen = m->view_gen;
+  e->index_row_key = key;
+  e->index_row_cols = cols;
+  return cols;
 }
 
 /**
@@ -1312,6 +1337,21 @@ struct Mailbox *dlg_index(struct MuttWindow *dlg, struct Mailbox *m_init)
     /* either user abort or timeout */
     if (op < OP_NULL)
     {
+      if (op == OP_TIMEOUT)
+      {
+        imap_prefetch(shared->mailbox, shared->email);
+#ifdef USE_NOTMUCH
+        if (nm_stream_read(shared->mailbox) == MX_STATUS_NEW_MAIL)
+        {
+          update_index(priv->menu, shared->mailbox_view, MX_STATUS_NEW_MAIL,
+                       priv->oldcount, shared);
+          priv->menu->max = shared->mailbox->vcount;
+          menu_queue_redraw(priv->menu, MENU_REDRAW_FULL);
+          index_shared_data_set_email(shared, mutt_get_virt_email(shared->mailbox,
+                                                                  menu_get_index(priv->menu)));
+        }
+#endif
+      }
       if (priv->tag_prefix)
         msgwin_clear_text(NULL);
       continue;
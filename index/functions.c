@@ -1401,6 +1401,7 @@ static int op_main_modify_tags(struct IndexSharedData *shared,
       progress_update(progress, ++px, -1);
       mx_tags_commit(m, e, buf_string(buf));
       e->attr_color = NULL;
+      m->view_gen++;
       if (op == OP_MAIN_MODIFY_TAGS_THEN_HIDE)
       {
         bool still_queried = false;
@@ -1427,6 +1428,7 @@ static int op_main_modify_tags(struct IndexSharedData *shared,
       goto done;
     }
     shared->email->attr_color = NULL;
+    m->view_gen++;
     if (op == OP_MAIN_MODIFY_TAGS_THEN_HIDE)
     {
       bool still_queried = false;
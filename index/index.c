@@ -75,6 +75,7 @@
 #include "email/lib.h"
 #include "core/lib.h"
 #include "gui/lib.h"
+#include "lib.h"
 #include "attach/lib.h"
 #include "color/lib.h"
 #include "menu/lib.h"
@@ -89,6 +90,25 @@
 #include "shared_data.h"
 #include "subjectrx.h"
 
+/**
+ * index_rows_invalidate - Discard the cached Index rows
+ * @param win Index Window
+ *
+ * Any Email's row may have changed, so they'll be rendered again.
+ *
+ * @sa index_make_entry()
+ */
+static void index_rows_invalidate(struct MuttWindow *win)
+{
+  struct MuttWindow *dlg = dialog_find(win);
+  if (!dlg)
+    return;
+
+  struct IndexSharedData *shared = dlg->wdata;
+  if (shared && shared->mailbox)
+    shared->mailbox->view_gen++;
+}
+
 /**
  * sort_use_threads_warn - Alert the user to odd $sort settings
  */
@@ -231,6 +251,7 @@ static int index_altern_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_alternates_reset(shared->mailbox_view);
+  index_rows_invalidate(win);
   mutt_debug(LL_DEBUG5, "alternates done\n");
   return 0;
 }
@@ -250,6 +271,7 @@ static int index_attach_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_attachments_reset(shared->mailbox_view);
+  index_rows_invalidate(win);
   mutt_debug(LL_DEBUG5, "attachments done\n");
   return 0;
 }
@@ -297,6 +319,7 @@ static int index_color_observer(struct NotifyCallback *nc)
       break;
     e->attr_color = NULL;
   }
+  m->view_gen++;
 
   struct MuttWindow *panel_index = window_find_child(dlg, WT_INDEX);
   struct IndexPrivateData *priv = panel_index->wdata;
@@ -395,6 +418,9 @@ static int index_config_observer(struct NotifyCallback *nc)
 
   struct MuttWindow *win = nc->global_data;
 
+  // Any config can be used by $index_format, e.g. $date_format
+  index_rows_invalidate(win);
+
   if (!config_check_sort(ev_c->name) && !config_check_index(ev_c->name))
     return 0;
 
@@ -446,6 +472,9 @@ static int index_global_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
   mutt_check_rescore(shared->mailbox);
 
+  // The command may have changed a hook or transform used by $index_format
+  index_rows_invalidate(win);
+
   return 0;
 }
 
@@ -466,6 +495,11 @@ static int index_index_observer(struct NotifyCallback *nc)
 
   struct IndexPrivateData *priv = menu->mdata;
   struct IndexSharedData *shared = priv->shared;
+  if ((nc->event_type == NT_INDEX) &&
+      (nc->event_subtype & (NT_INDEX_SUBSET | NT_INDEX_MVIEW | NT_INDEX_MAILBOX)))
+  {
+    index_rows_invalidate(win);
+  }
   if (shared && shared->mailbox)
     menu->max = shared->mailbox->vcount;
   else
@@ -523,6 +557,7 @@ static int index_score_observer(struct NotifyCallback *nc)
     mutt_score_message(m, e, true);
     e->attr_color = NULL; // Force recalc of colour
   }
+  m->view_gen++;
 
   mutt_debug(LL_DEBUG5, "score done\n");
   return 0;
@@ -543,6 +578,7 @@ static int index_subjrx_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   subjrx_clear_mods(shared->mailbox_view);
+  index_rows_invalidate(win);
   mutt_debug(LL_DEBUG5, "subjectrx done\n");
   return 0;
 }
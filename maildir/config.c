@@ -77,6 +77,9 @@ static struct ConfigDef MaildirVars[] = {
   { "maildir_field_delimiter", DT_STRING|D_NOT_EMPTY|D_ON_STARTUP, IP ":", 0, maildir_field_delimiter_validator,
     "Field delimiter to be used for maildir email files (default is colon, recommended alternative is semi-colon)"
   },
+  { "maildir_readahead_threads", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 4, 0, NULL,
+    "Number of threads used to read ahead new messages when opening a maildir"
+  },
   { "maildir_trash", DT_BOOL, false, 0, NULL,
     "Use the maildir 'trashed' flag, rather than deleting"
   },
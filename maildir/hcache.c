@@ -62,6 +62,17 @@ static size_t maildir_hcache_keylen(const char *fn)
   return p ? (size_t) (p - fn) : mutt_str_len(fn);
 }
 
+/**
+ * maildir_hcache_begin_batch - Group the following writes into one transaction
+ * @param hc Header Cache
+ *
+ * The batch is committed by maildir_hcache_close().
+ */
+void maildir_hcache_begin_batch(struct HeaderCache *hc)
+{
+  hcache_begin_batch(hc);
+}
+
 /**
  * maildir_hcache_close - Close the Header Cache
  * @param ptr Header Cache
@@ -31,19 +31,21 @@ struct Mailbox;
 
 #ifdef USE_HCACHE
 
-void                maildir_hcache_close (struct HeaderCache **ptr);
-int                 maildir_hcache_delete(struct HeaderCache *hc, struct Email *e);
-struct HeaderCache *maildir_hcache_open  (struct Mailbox *m);
-struct Email *      maildir_hcache_read  (struct HeaderCache *hc, struct Email *e, const char *fn);
-int                 maildir_hcache_store (struct HeaderCache *hc, struct Email *e);
+void                maildir_hcache_begin_batch(struct HeaderCache *hc);
+void                maildir_hcache_close      (struct HeaderCache **ptr);
+int                 maildir_hcache_delete     (struct HeaderCache *hc, struct Email *e);
+struct HeaderCache *maildir_hcache_open       (struct Mailbox *m);
+struct Email *      maildir_hcache_read       (struct HeaderCache *hc, struct Email *e, const char *fn);
+int                 maildir_hcache_store      (struct HeaderCache *hc, struct Email *e);
 
 #else
 
-static inline void                maildir_hcache_close (struct HeaderCache **ptr) {}
-static inline int                 maildir_hcache_delete(struct HeaderCache *hc, struct Email *e) { return 0; }
-static inline struct HeaderCache *maildir_hcache_open  (struct Mailbox *m) { return NULL; }
-static inline struct Email *      maildir_hcache_read  (struct HeaderCache *hc, struct Email *e, const char *fn) { return NULL; }
-static inline int                 maildir_hcache_store (struct HeaderCache *hc, struct Email *e) { return 0; }
+static inline void                maildir_hcache_begin_batch(struct HeaderCache *hc) {}
+static inline void                maildir_hcache_close      (struct HeaderCache **ptr) {}
+static inline int                 maildir_hcache_delete     (struct HeaderCache *hc, struct Email *e) { return 0; }
+static inline struct HeaderCache *maildir_hcache_open       (struct Mailbox *m) { return NULL; }
+static inline struct Email *      maildir_hcache_read       (struct HeaderCache *hc, struct Email *e, const char *fn) { return NULL; }
+static inline int                 maildir_hcache_store      (struct HeaderCache *hc, struct Email *e) { return 0; }
 
 #endif
 
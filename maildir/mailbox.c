@@ -29,7 +29,9 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -329,11 +331,108 @@ cleanup:
   return rc;
 }
 
+/// Number of messages handed to the worker threads at once
+#define MAILDIR_READAHEAD_BATCH 256
+
+/// Maximum number of bytes of a message read ahead
+#define MAILDIR_READAHEAD_MAX (64 * 1024)
+
+/**
+ * struct MaildirReadahead - A batch of messages to be read ahead by worker threads
+ */
+struct MaildirReadahead
+{
+  const char *path;                             ///< Path of the Mailbox
+  struct MdEmail *mds[MAILDIR_READAHEAD_BATCH]; ///< Messages that missed the Header Cache
+  size_t count;                                 ///< Number of messages in the batch
+};
+
+/**
+ * maildir_readahead_job - Read the headers of a message file - Implements ::worker_job_t - @ingroup worker_job_api
+ *
+ * Read the file up to the end of the headers, so that they're in the page
+ * cache when the main thread parses them.  The file is closed again, so only
+ * one file per thread is open at a time.
+ */
+static void maildir_readahead_job(size_t index, void *data)
+{
+  struct MaildirReadahead *ra = data;
+  char fn[PATH_MAX] = { 0 };
+  char buf[4096];
+
+  snprintf(fn, sizeof(fn), "%s/%s", ra->path, ra->mds[index]->email->path);
+
+  int fd = open(fn, O_RDONLY);
+  if (fd < 0)
+    return;
+
+  // Stop at the blank line after the headers
+  bool eoh = false;
+  char last = '\0';
+  for (size_t total = 0; !eoh && (total < MAILDIR_READAHEAD_MAX);)
+  {
+    const ssize_t n = read(fd, buf, sizeof(buf));
+    if (n <= 0)
+      break;
+
+    for (ssize_t i = 0; !eoh && (i < n); i++)
+    {
+      eoh = (last == '\n') && (buf[i] == '\n');
+      last = buf[i];
+    }
+    total += n;
+  }
+
+  close(fd);
+}
+
+/**
+ * maildir_readahead_batch - Read ahead, then parse, a batch of messages
+ * @param m       Mailbox
+ * @param hc      Header Cache
+ * @param ra      Batch of messages
+ * @param threads Number of threads to use
+ *
+ * The worker threads only read the headers into the page cache.  They're
+ * parsed, and stored in the Header Cache, by the main thread, in array order.
+ * The RFC822 parser uses the Buffer pool, logs and auto-subscribes, so it
+ * can't run in the workers.
+ */
+static void maildir_readahead_batch(struct Mailbox *m, struct HeaderCache *hc,
+                                    struct MaildirReadahead *ra, int threads)
+{
+  char fn[PATH_MAX] = { 0 };
+
+  mutt_worker_run(ra->count, threads, maildir_readahead_job, ra);
+
+  for (size_t i = 0; i < ra->count; i++)
+  {
+    struct MdEmail *md = ra->mds[i];
+    snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), md->email->path);
+
+    if (maildir_parse_message(fn, md->email->old, md->email))
+    {
+      md->header_parsed = true;
+      maildir_hcache_store(hc, md->email);
+    }
+    else
+    {
+      email_free(&md->email);
+    }
+  }
+
+  ra->count = 0;
+}
+
 /**
  * maildir_delayed_parsing - This function does the second parsing pass
  * @param[in]  m   Mailbox
  * @param[out] mda Maildir array to parse
  * @param[in]  progress Progress bar
+ *
+ * If `$maildir_readahead_threads` is greater than 1, the messages that aren't
+ * in the Header Cache are read ahead by a pool of worker threads.  The parsing
+ * itself is always serial.
  */
 static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
                                     struct Progress *progress)
@@ -341,6 +440,15 @@ static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
   char fn[PATH_MAX] = { 0 };
 
   struct HeaderCache *hc = maildir_hcache_open(m);
+  maildir_hcache_begin_batch(hc);
+
+  const short c_maildir_readahead_threads = cs_subset_number(NeoMutt->sub, "maildir_readahead_threads");
+  struct MaildirReadahead *ra = NULL;
+  if (c_maildir_readahead_threads > 1)
+  {
+    ra = MUTT_MEM_CALLOC(1, struct MaildirReadahead);
+    ra->path = mailbox_path(m);
+  }
 
   struct MdEmail *md = NULL;
   struct MdEmail **mdp = NULL;
@@ -360,6 +468,12 @@ static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
       email_free(&md->email);
       md->email = e;
     }
+    else if (ra)
+    {
+      ra->mds[ra->count++] = md;
+      if (ra->count == MAILDIR_READAHEAD_BATCH)
+        maildir_readahead_batch(m, hc, ra, c_maildir_readahead_threads);
+    }
     else
     {
       if (maildir_parse_message(fn, md->email->old, md->email))
@@ -374,6 +488,12 @@ static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
     }
   }
 
+  if (ra)
+  {
+    maildir_readahead_batch(m, hc, ra, c_maildir_readahead_threads);
+    FREE(&ra);
+  }
+
   maildir_hcache_close(&hc);
 }
 
@@ -846,6 +966,7 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
     return check;
 
   struct HeaderCache *hc = maildir_hcache_open(m);
+  maildir_hcache_begin_batch(hc);
 
   struct Progress *progress = NULL;
   if (m->verbose)
@@ -39,6 +39,9 @@ static struct ConfigDef MboxVars[] = {
   { "check_mbox_size", DT_BOOL, false, 0, NULL,
     "(mbox,mmdf) Use mailbox size as an indicator of new mail"
   },
+  { "mbox_mmap", DT_BOOL, true, 0, NULL,
+    "(mbox,mmdf) Map the mailbox into memory when reading it"
+  },
   { NULL },
   // clang-format on
 };
@@ -41,6 +41,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
@@ -73,6 +74,22 @@ struct MUpdate
   LOFF_T length;
 };
 
+/**
+ * struct MboxMap - A read-only mapping of a mailbox file
+ *
+ * The scanner works directly on the mapping, searching for message
+ * separators with memmem()/memchr(), which libc implements with vector
+ * instructions.  Headers are parsed through @a fp, which reads from the same
+ * mapping if fmemopen() is available.
+ */
+struct MboxMap
+{
+  const char *data; ///< Mapped file
+  size_t len;       ///< Length of the mapping
+  FILE *fp;         ///< Stream used for parsing the headers
+  bool own_fp;      ///< Close fp when the mapping is released
+};
+
 /**
  * mbox_adata_free - Free the private Account data - Implements Account::adata_free() - @ingroup account_adata_free
  */
@@ -175,6 +192,391 @@ static void mbox_unlock_mailbox(struct Mailbox *m)
   }
 }
 
+/**
+ * mbox_map_open - Map a mailbox file into memory
+ * @param m   Mailbox
+ * @param fp  Open mailbox file
+ * @param map Mapping to fill
+ * @retval true  Success
+ * @retval false Mapping isn't possible, fall back to stdio
+ */
+static bool mbox_map_open(struct Mailbox *m, FILE *fp, struct MboxMap *map)
+{
+  const bool c_mbox_mmap = cs_subset_bool(NeoMutt->sub, "mbox_mmap");
+  if (!c_mbox_mmap || (m->size <= 0) || ((uintmax_t) m->size > SIZE_MAX))
+    return false;
+
+  void *data = mmap(NULL, m->size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+  if (data == MAP_FAILED)
+  {
+    mutt_debug(LL_DEBUG1, "mmap: %s (errno %d)\n", strerror(errno), errno);
+    return false;
+  }
+
+#ifdef POSIX_MADV_SEQUENTIAL
+  posix_madvise(data, m->size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+  map->data = data;
+  map->len = m->size;
+  map->fp = fp;
+  map->own_fp = false;
+
+#ifdef USE_FMEMOPEN
+  FILE *fp_map = fmemopen(data, map->len, "r");
+  if (fp_map)
+  {
+    map->fp = fp_map;
+    map->own_fp = true;
+  }
+#endif
+
+  return true;
+}
+
+/**
+ * mbox_map_close - Release a mailbox mapping
+ * @param map Mapping to release
+ */
+static void mbox_map_close(struct MboxMap *map)
+{
+  if (map->own_fp)
+    mutt_file_fclose(&map->fp);
+  if (map->data)
+    munmap((void *) map->data, map->len);
+  map->data = NULL;
+  map->len = 0;
+}
+
+/**
+ * map_line_end - Find the start of the next line
+ * @param map Mapping
+ * @param pos Offset within the current line
+ * @retval num Offset of the next line, or the end of the mapping
+ */
+static size_t map_line_end(const struct MboxMap *map, size_t pos)
+{
+  const char *nl = memchr(map->data + pos, '\n', map->len - pos);
+  return nl ? (nl - map->data + 1) : map->len;
+}
+
+/**
+ * map_count_lines - Count the lines in a region of the mapping
+ * @param map   Mapping
+ * @param start Start offset, at the beginning of a line
+ * @param end   End offset
+ * @retval num Number of lines, including an unterminated last line
+ */
+static long map_count_lines(const struct MboxMap *map, size_t start, size_t end)
+{
+  long lines = 0;
+  const char *p = map->data + start;
+  const char *last = map->data + end;
+
+  while (p < last)
+  {
+    const char *nl = memchr(p, '\n', last - p);
+    lines++;
+    if (!nl)
+      break;
+    p = nl + 1;
+  }
+
+  return lines;
+}
+
+/**
+ * map_find_line - Find the next line starting with a string
+ * @param map    Mapping
+ * @param pos    Offset to start from, at the beginning of a line
+ * @param prefix String to find, e.g. "From "
+ * @retval num Offset of the matching line, or the end of the mapping
+ */
+static size_t map_find_line(const struct MboxMap *map, size_t pos, const char *prefix)
+{
+  const size_t plen = strlen(prefix);
+  if (pos >= map->len)
+    return map->len;
+
+  if (((map->len - pos) >= plen) && (memcmp(map->data + pos, prefix, plen) == 0))
+    return pos;
+
+  char needle[16] = { 0 };
+  needle[0] = '\n';
+  memcpy(needle + 1, prefix, plen);
+
+  const char *found = memmem(map->data + pos, map->len - pos, needle, plen + 1);
+  return found ? (found - map->data + 1) : map->len;
+}
+
+/**
+ * map_copy_line - Copy a line of the mapping into a buffer
+ * @param map    Mapping
+ * @param pos    Offset of the line
+ * @param buf    Buffer for the result
+ * @param buflen Length of the buffer
+ * @retval num Offset of the next line
+ */
+static size_t map_copy_line(const struct MboxMap *map, size_t pos, char *buf, size_t buflen)
+{
+  size_t end = map_line_end(map, pos);
+  size_t len = MIN(end - pos, buflen - 1);
+  memcpy(buf, map->data + pos, len);
+  buf[len] = '\0';
+  return end;
+}
+
+/**
+ * mmdf_parse_map - Read an MMDF mailbox from a memory mapping
+ * @param m        Mailbox
+ * @param map      Mapping of the mailbox file
+ * @param pos      Offset to start reading from
+ * @param progress Progress bar, may be NULL
+ * @retval enum #MxOpenReturns
+ */
+static enum MxOpenReturns mmdf_parse_map(struct Mailbox *m, struct MboxMap *map,
+                                         size_t pos, struct Progress *progress)
+{
+  const size_t seplen = sizeof(MMDF_SEP) - 1;
+  char buf[1024] = { 0 };
+  char return_path[1024] = { 0 };
+  int count = 0;
+  time_t t = 0;
+
+  while ((pos < map->len) && !SigInt)
+  {
+    if (((map->len - pos) < seplen) || (memcmp(map->data + pos, MMDF_SEP, seplen) != 0))
+    {
+      mutt_debug(LL_DEBUG1, "corrupt mailbox\n");
+      mutt_error(_("Mailbox is corrupt"));
+      return MX_OPEN_ERROR;
+    }
+
+    pos += seplen;
+    if (pos >= map->len)
+    {
+      mutt_debug(LL_DEBUG1, "unexpected EOF\n");
+      break;
+    }
+
+    count++;
+    progress_update(progress, count, (int) (pos / (m->size / 100 + 1)));
+
+    mx_alloc_memory(m, m->msg_count);
+    struct Email *e = email_new();
+    m->emails[m->msg_count] = e;
+    e->offset = pos;
+    e->index = m->msg_count;
+
+    return_path[0] = '\0';
+    size_t hdr = map_copy_line(map, pos, buf, sizeof(buf));
+    if (is_from(buf, return_path, sizeof(return_path), &t))
+      e->received = t - mutt_date_local_tz(t);
+    else
+      hdr = pos;
+
+    if (!mutt_file_seek(map->fp, hdr, SEEK_SET))
+      return MX_OPEN_ERROR;
+    e->env = mutt_rfc822_read_header(map->fp, e, false, false);
+
+    LOFF_T loc = ftello(map->fp);
+    if (loc < 0)
+      return MX_OPEN_ERROR;
+
+    if ((e->body->length > 0) && (e->lines > 0))
+    {
+      LOFF_T tmploc = loc + e->body->length;
+      if ((tmploc > 0) && (tmploc < m->size) && ((m->size - tmploc) >= (LOFF_T) seplen) &&
+          (memcmp(map->data + tmploc, MMDF_SEP, seplen) == 0))
+      {
+        pos = tmploc + seplen;
+      }
+      else
+      {
+        e->body->length = -1;
+      }
+    }
+    else
+    {
+      e->body->length = -1;
+    }
+
+    if (e->body->length < 0)
+    {
+      size_t sep = map_find_line(map, loc, MMDF_SEP);
+      e->lines = map_count_lines(map, loc, sep);
+      if (sep == map->len)
+        e->lines--;
+      e->body->length = sep - e->body->offset;
+      pos = MIN(sep + seplen, map->len);
+    }
+
+    if (TAILQ_EMPTY(&e->env->return_path) && return_path[0])
+      mutt_addrlist_parse(&e->env->return_path, return_path);
+
+    if (TAILQ_EMPTY(&e->env->from))
+      mutt_addrlist_copy(&e->env->from, &e->env->return_path, false);
+
+    m->msg_count++;
+  }
+
+  if (SigInt)
+  {
+    SigInt = false;
+    return MX_OPEN_ABORT; /* action aborted */
+  }
+
+  return MX_OPEN_OK;
+}
+
+/**
+ * mbox_parse_map - Read an mbox mailbox from a memory mapping
+ * @param m        Mailbox
+ * @param map      Mapping of the mailbox file
+ * @param pos      Offset to start reading from
+ * @param progress Progress bar, may be NULL
+ * @retval enum #MxOpenReturns
+ *
+ * Only the "From " lines and the headers are examined.  Message bodies are
+ * skipped by searching the mapping for the next separator.
+ */
+static enum MxOpenReturns mbox_parse_map(struct Mailbox *m, struct MboxMap *map,
+                                         size_t pos, struct Progress *progress)
+{
+  char buf[1024] = { 0 };
+  char return_path[256] = { 0 };
+  struct Email *e_cur = NULL;
+  time_t t = 0;
+  int count = 0;
+  long lines = 0;
+
+  while ((pos < map->len) && !SigInt)
+  {
+    size_t loc = map_find_line(map, pos, "From ");
+    lines += map_count_lines(map, pos, loc);
+    if (loc == map->len)
+      break;
+
+    pos = map_copy_line(map, loc, buf, sizeof(buf));
+    if (!is_from(buf, return_path, sizeof(return_path), &t))
+    {
+      lines++;
+      continue;
+    }
+
+    /* Save the Content-Length of the previous message */
+    if (count > 0)
+    {
+      struct Email *e = m->emails[m->msg_count - 1];
+      if (e->body->length < 0)
+      {
+        e->body->length = loc - e->body->offset - 1;
+        if (e->body->length < 0)
+          e->body->length = 0;
+      }
+      if (e->lines == 0)
+        e->lines = lines ? lines - 1 : 0;
+    }
+
+    count++;
+    progress_update(progress, count, (int) (pos / (m->size / 100 + 1)));
+
+    mx_alloc_memory(m, m->msg_count);
+
+    m->emails[m->msg_count] = email_new();
+    e_cur = m->emails[m->msg_count];
+    e_cur->received = t - mutt_date_local_tz(t);
+    e_cur->offset = loc;
+    e_cur->index = m->msg_count;
+
+    if (!mutt_file_seek(map->fp, pos, SEEK_SET))
+      return MX_OPEN_ERROR;
+    e_cur->env = mutt_rfc822_read_header(map->fp, e_cur, false, false);
+
+    LOFF_T body = ftello(map->fp);
+    if (body < 0)
+      return MX_OPEN_ERROR;
+    pos = body;
+
+    /* if we know how long this message is, skip over the body and count its
+     * lines if necessary */
+    if (e_cur->body->length > 0)
+    {
+      LOFF_T tmploc = (e_cur->body->length < m->size) ?
+                          (body + e_cur->body->length + 1) :
+                          -1;
+
+      if ((tmploc > 0) && (tmploc < m->size))
+      {
+        /* check to see if the content-length looks valid.  we expect to
+         * to see a valid message separator at this point in the stream */
+        if (((m->size - tmploc) < 5) || (memcmp(map->data + tmploc, "From ", 5) != 0))
+        {
+          mutt_debug(LL_DEBUG1, "bad content-length in message %d (cl=" OFF_T_FMT ")\n",
+                     e_cur->index, e_cur->body->length);
+          e_cur->body->length = -1;
+        }
+      }
+      else if (tmploc != m->size)
+      {
+        /* content-length would put us past the end of the file, so it
+         * must be wrong */
+        e_cur->body->length = -1;
+      }
+
+      if (e_cur->body->length != -1)
+      {
+        if (e_cur->lines == 0)
+        {
+          const char *p = map->data + body;
+          const char *end = p + e_cur->body->length;
+          while ((p = memchr(p, '\n', end - p)))
+          {
+            e_cur->lines++;
+            p++;
+          }
+        }
+
+        pos = tmploc;
+      }
+    }
+
+    m->msg_count++;
+
+    if (TAILQ_EMPTY(&e_cur->env->return_path) && return_path[0])
+      mutt_addrlist_parse(&e_cur->env->return_path, return_path);
+
+    if (TAILQ_EMPTY(&e_cur->env->from))
+      mutt_addrlist_copy(&e_cur->env->from, &e_cur->env->return_path, false);
+
+    lines = 0;
+  }
+
+  /* Only set the content-length of the previous message if we have read more
+   * than one message during _this_ invocation.  See mbox_parse_mailbox() */
+  if (count > 0)
+  {
+    struct Email *e = m->emails[m->msg_count - 1];
+    if (e->body->length < 0)
+    {
+      e->body->length = map->len - e->body->offset - 1;
+      if (e->body->length < 0)
+        e->body->length = 0;
+    }
+
+    if (e->lines == 0)
+      e->lines = lines ? lines - 1 : 0;
+  }
+
+  if (SigInt)
+  {
+    SigInt = false;
+    return MX_OPEN_ABORT; /* action aborted */
+  }
+
+  return MX_OPEN_OK;
+}
+
 /**
  * mmdf_parse_mailbox - Read a mailbox in MMDF format
  * @param m Mailbox
@@ -217,6 +619,16 @@ static enum MxOpenReturns mmdf_parse_mailbox(struct Mailbox *m)
     progress_set_message(progress, _("Reading %s..."), mailbox_path(m));
   }
 
+  struct MboxMap map = { 0 };
+  if (mbox_map_open(m, adata->fp, &map))
+  {
+    loc = ftello(adata->fp);
+    rc = mmdf_parse_map(m, &map, (loc < 0) ? 0 : loc, progress);
+    mbox_map_close(&map);
+    (void) mutt_file_seek(adata->fp, m->size, SEEK_SET);
+    goto fail;
+  }
+
   while (true)
   {
     if (!fgets(buf, sizeof(buf) - 1, adata->fp))
@@ -394,6 +806,15 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
     loc = 0;
   }
 
+  struct MboxMap map = { 0 };
+  if (mbox_map_open(m, adata->fp, &map))
+  {
+    rc = mbox_parse_map(m, &map, loc, progress);
+    mbox_map_close(&map);
+    (void) mutt_file_seek(adata->fp, m->size, SEEK_SET);
+    goto fail;
+  }
+
   while ((fgets(buf, sizeof(buf), adata->fp)) && !SigInt)
   {
     if (is_from(buf, return_path, sizeof(return_path), &t))
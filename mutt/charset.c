@@ -37,8 +37,12 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
 #include "charset.h"
 #include "buffer.h"
+#include "hash.h"
 #include "list.h"
 #include "logging2.h"
 #include "memory.h"
@@ -83,21 +87,52 @@ TAILQ_HEAD(LookupList, Lookup);
 static struct LookupList Lookups = TAILQ_HEAD_INITIALIZER(Lookups);
 
 /**
- * struct IconvCacheEntry - Cached iconv conversion descriptor
+ * struct CharsetCacheEntry - Cached canonical name or iconv conversion descriptor
  */
-struct IconvCacheEntry
+struct CharsetCacheEntry
 {
-  char *fromcode1; ///< Source character set
-  char *tocode1;   ///< Destination character set
-  iconv_t cd;      ///< iconv conversion descriptor
+  char *key;                              ///< Lookup key
+  char *canon;                            ///< Canonical charset name
+  iconv_t cd;                             ///< iconv conversion descriptor
+  unsigned int hook_gen;                  ///< #HookGen when a failed iconv_open() was cached
+  TAILQ_ENTRY(CharsetCacheEntry) entries; ///< Linked list, most recently used first
 };
+TAILQ_HEAD(CharsetCacheList, CharsetCacheEntry);
 
-/// Max size of the iconv cache
-#define ICONV_CACHE_SIZE 16
-/// Cache of iconv conversion descriptors
-static struct IconvCacheEntry IconvCache[ICONV_CACHE_SIZE];
-/// Number of iconv descriptors in the cache
-static int IconvCacheUsed = 0;
+/**
+ * struct CharsetCache - Cache that drops its least recently used entries
+ */
+struct CharsetCache
+{
+  struct HashTable *hash;       ///< Key -> CharsetCacheEntry
+  struct CharsetCacheList list; ///< Entries, most recently used first
+  size_t count;                 ///< Number of entries
+  size_t max;                   ///< Maximum number of entries
+};
+
+/// Max number of iconv descriptors cached by each thread
+#define ICONV_CACHE_SIZE 64
+/// Max number of canonical charset names in each cache
+#define CANON_CACHE_SIZE 256
+
+/// Cache of canonical charset names, name -> canonical name
+static struct CharsetCache *CanonCache = NULL;
+/// Cache of canonical charset names, after applying charset-hooks
+static struct CharsetCache *CanonHookCache = NULL;
+/// Bumped when the charset-hooks or iconv-hooks change
+static unsigned int HookGen = 0;
+
+#ifdef HAVE_PTHREAD
+/// Protects the canonical name caches and #HookGen
+static pthread_mutex_t CanonCacheLock = PTHREAD_MUTEX_INITIALIZER;
+/// Each thread has its own cache of iconv descriptors
+static pthread_key_t IconvCacheKey;
+/// Creates #IconvCacheKey
+static pthread_once_t IconvCacheOnce = PTHREAD_ONCE_INIT;
+#else
+/// Cache of iconv conversion descriptors, "tocode\tfromcode\tflags" -> iconv_t
+static struct CharsetCache *IconvCache = NULL;
+#endif
 
 /**
  * struct MimeNames - MIME name lookup entry
@@ -262,6 +297,193 @@ static const struct MimeNames PreferredMimeNames[] = {
   // clang-format on
 };
 
+/**
+ * canon_cache_lock - Lock the canonical name caches
+ */
+static void canon_cache_lock(void)
+{
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock(&CanonCacheLock);
+#endif
+}
+
+/**
+ * canon_cache_unlock - Unlock the canonical name caches
+ */
+static void canon_cache_unlock(void)
+{
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock(&CanonCacheLock);
+#endif
+}
+
+/**
+ * charset_cache_new - Create a new CharsetCache
+ * @param max Maximum number of entries
+ * @retval ptr New CharsetCache
+ */
+static struct CharsetCache *charset_cache_new(size_t max)
+{
+  struct CharsetCache *cache = MUTT_MEM_CALLOC(1, struct CharsetCache);
+  cache->hash = mutt_hash_new(max, MUTT_HASH_NO_FLAGS);
+  TAILQ_INIT(&cache->list);
+  cache->max = max;
+  return cache;
+}
+
+/**
+ * charset_cache_remove - Remove an entry from a CharsetCache and free it
+ * @param cache CharsetCache
+ * @param cce   Entry to remove
+ */
+static void charset_cache_remove(struct CharsetCache *cache, struct CharsetCacheEntry *cce)
+{
+  mutt_hash_delete(cache->hash, cce->key, cce);
+  TAILQ_REMOVE(&cache->list, cce, entries);
+  cache->count--;
+
+  if (iconv_t_valid(cce->cd))
+    iconv_close(cce->cd);
+  FREE(&cce->canon);
+  FREE(&cce->key);
+  FREE(&cce);
+}
+
+/**
+ * charset_cache_free - Free a CharsetCache
+ * @param ptr CharsetCache to free
+ */
+static void charset_cache_free(struct CharsetCache **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct CharsetCache *cache = *ptr;
+  struct CharsetCacheEntry *cce = NULL;
+  struct CharsetCacheEntry *tmp = NULL;
+  TAILQ_FOREACH_SAFE(cce, &cache->list, entries, tmp)
+  {
+    charset_cache_remove(cache, cce);
+  }
+
+  mutt_hash_free(&cache->hash);
+  FREE(ptr);
+}
+
+/**
+ * charset_cache_find - Find an entry in a CharsetCache
+ * @param cache CharsetCache
+ * @param key   Key to find
+ * @retval ptr  Matching entry, now the most recently used
+ * @retval NULL Not found
+ */
+static struct CharsetCacheEntry *charset_cache_find(struct CharsetCache *cache, const char *key)
+{
+  struct CharsetCacheEntry *cce = mutt_hash_find(cache->hash, key);
+  if (cce && (cce != TAILQ_FIRST(&cache->list)))
+  {
+    TAILQ_REMOVE(&cache->list, cce, entries);
+    TAILQ_INSERT_HEAD(&cache->list, cce, entries);
+  }
+  return cce;
+}
+
+/**
+ * charset_cache_add - Add an entry to a CharsetCache
+ * @param cache CharsetCache
+ * @param key   Key of the new entry
+ * @retval ptr New entry, for the caller to fill in
+ *
+ * If the cache is full, the least recently used entry is freed.
+ */
+static struct CharsetCacheEntry *charset_cache_add(struct CharsetCache *cache, const char *key)
+{
+  if (cache->count >= cache->max)
+    charset_cache_remove(cache, TAILQ_LAST(&cache->list, CharsetCacheList));
+
+  struct CharsetCacheEntry *cce = MUTT_MEM_CALLOC(1, struct CharsetCacheEntry);
+  cce->key = mutt_str_dup(key);
+  cce->cd = ICONV_T_INVALID;
+
+  mutt_hash_insert(cache->hash, cce->key, cce);
+  TAILQ_INSERT_HEAD(&cache->list, cce, entries);
+  cache->count++;
+  return cce;
+}
+
+#ifdef HAVE_PTHREAD
+/**
+ * iconv_cache_thread_free - Free a thread's iconv cache when the thread exits
+ * @param ptr CharsetCache to free
+ */
+static void iconv_cache_thread_free(void *ptr)
+{
+  struct CharsetCache *cache = ptr;
+  charset_cache_free(&cache);
+}
+
+/**
+ * iconv_cache_key_init - Create the key for the per-thread iconv caches
+ */
+static void iconv_cache_key_init(void)
+{
+  pthread_key_create(&IconvCacheKey, iconv_cache_thread_free);
+}
+#endif
+
+/**
+ * iconv_cache_get - Get the calling thread's cache of iconv descriptors
+ * @param create If true, create the cache if it doesn't exist
+ * @retval ptr  CharsetCache
+ * @retval NULL No cache
+ *
+ * An iconv descriptor has state, so each thread has a cache of its own.
+ */
+static struct CharsetCache *iconv_cache_get(bool create)
+{
+#ifdef HAVE_PTHREAD
+  pthread_once(&IconvCacheOnce, iconv_cache_key_init);
+  struct CharsetCache *cache = pthread_getspecific(IconvCacheKey);
+  if (!cache && create)
+  {
+    cache = charset_cache_new(ICONV_CACHE_SIZE);
+    pthread_setspecific(IconvCacheKey, cache);
+  }
+  return cache;
+#else
+  if (!IconvCache && create)
+    IconvCache = charset_cache_new(ICONV_CACHE_SIZE);
+  return IconvCache;
+#endif
+}
+
+/**
+ * canon_hook_cache_reset - Forget the results that depend on the hooks
+ *
+ * The charset names that charset-hooks applied to are freed.  The failed
+ * iconv_open() calls, cached by each thread, are retried when they're next
+ * used, see mutt_ch_iconv_open().
+ */
+static void canon_hook_cache_reset(void)
+{
+  canon_cache_lock();
+  charset_cache_free(&CanonHookCache);
+  HookGen++;
+  canon_cache_unlock();
+}
+
+/**
+ * hook_gen_get - Get the generation of the hooks
+ * @retval num Current #HookGen
+ */
+static unsigned int hook_gen_get(void)
+{
+  canon_cache_lock();
+  const unsigned int gen = HookGen;
+  canon_cache_unlock();
+  return gen;
+}
+
 /**
  * lookup_new - Create a new Lookup
  * @retval ptr New Lookup
@@ -378,7 +600,7 @@ void mutt_ch_canonical_charset(char *buf, size_t buflen, const char *name)
 
   char in[1024] = { 0 };
   char scratch[1024 + 10] = { 0 };
-  struct Buffer *canon = buf_pool_get();
+  char canon[1024 + 10] = { 0 };
 
   mutt_str_copy(in, name, sizeof(in));
   char *ext = strchr(in, '/');
@@ -387,7 +609,7 @@ void mutt_ch_canonical_charset(char *buf, size_t buflen, const char *name)
 
   if (mutt_istr_equal(in, "utf-8") || mutt_istr_equal(in, "utf8"))
   {
-    buf_strcpy(canon, "utf-8");
+    mutt_str_copy(canon, "utf-8", sizeof(canon));
     goto out;
   }
 
@@ -408,23 +630,19 @@ void mutt_ch_canonical_charset(char *buf, size_t buflen, const char *name)
   {
     if (mutt_istr_equal(scratch, PreferredMimeNames[i].key))
     {
-      buf_strcpy(canon, PreferredMimeNames[i].pref);
+      mutt_str_copy(canon, PreferredMimeNames[i].pref, sizeof(canon));
       goto out;
     }
   }
 
-  buf_strcpy(canon, scratch);
-  buf_lower(canon); // for cosmetics' sake
+  mutt_str_copy(canon, scratch, sizeof(canon));
+  mutt_str_lower(canon); // for cosmetics' sake
 
 out:
   if (ext && (*ext != '\0'))
-  {
-    buf_addch(canon, '/');
-    buf_addstr(canon, ext);
-  }
-
-  mutt_str_copy(buf, buf_string(canon), buflen);
-  buf_pool_release(&canon);
+    snprintf(buf, buflen, "%s/%s", canon, ext);
+  else
+    mutt_str_copy(buf, canon, buflen);
 }
 
 /**
@@ -529,6 +747,7 @@ bool mutt_ch_lookup_add(enum LookupType type, const char *pat,
   l->regex.pat_not = false;
 
   TAILQ_INSERT_TAIL(&Lookups, l, entries);
+  canon_hook_cache_reset();
 
   return true;
 }
@@ -548,6 +767,7 @@ void mutt_ch_lookup_remove(void)
     TAILQ_REMOVE(&Lookups, l, entries);
     lookup_free(&l);
   }
+  canon_hook_cache_reset();
 }
 
 /**
@@ -564,6 +784,48 @@ const char *mutt_ch_charset_lookup(const char *chs)
   return lookup_charset(MUTT_LOOKUP_CHARSET, chs);
 }
 
+/**
+ * canon_cache_get - Get the canonical name of a charset, using a cache
+ * @param[in]  name   Character set, may be NULL
+ * @param[in]  hook   Apply charset-hooks, see #MUTT_ICONV_HOOK_FROM
+ * @param[out] buf    Buffer for the canonical name
+ * @param[in]  buflen Length of the buffer
+ */
+static void canon_cache_get(const char *name, bool hook, char *buf, size_t buflen)
+{
+  buf[0] = '\0';
+  if (!name)
+    return;
+
+  canon_cache_lock();
+
+  struct CharsetCache **cache = hook ? &CanonHookCache : &CanonCache;
+  if (!*cache)
+    *cache = charset_cache_new(CANON_CACHE_SIZE);
+
+  struct CharsetCacheEntry *cce = charset_cache_find(*cache, name);
+  if (cce)
+  {
+    mutt_str_copy(buf, cce->canon, buflen);
+    canon_cache_unlock();
+    return;
+  }
+
+  mutt_ch_canonical_charset(buf, buflen, name);
+
+  /* maybe apply charset-hooks and recanonicalise */
+  if (hook)
+  {
+    const char *tmp = mutt_ch_charset_lookup(buf);
+    if (tmp)
+      mutt_ch_canonical_charset(buf, buflen, tmp);
+  }
+
+  cce = charset_cache_add(*cache, name);
+  cce->canon = mutt_str_dup(buf);
+  canon_cache_unlock();
+}
+
 /**
  * mutt_ch_iconv_open - Set up iconv for conversions
  * @param tocode   Current character set
@@ -581,9 +843,16 @@ const char *mutt_ch_charset_lookup(const char *chs)
  * in some setups.
  *
  * Since calling iconv_open() repeatedly can be expensive, we keep a cache of
- * the most recently used iconv_t objects, kept in LRU order. This means that
- * you should not call iconv_close() on the object yourself. All remaining
- * objects in the cache will exit when main() calls mutt_ch_cache_cleanup().
+ * the most recently used iconv_t objects, kept in LRU order and keyed on the
+ * canonical charsets and the flags.  The canonical names are cached too.
+ * Failures are cached until a charset-hook or iconv-hook changes.
+ * This means that you should not call iconv_close() on the object yourself.
+ * All remaining objects in the cache will exit when main() calls
+ * mutt_ch_cache_cleanup().
+ *
+ * This may be called from any thread.  Each thread has its own cache, so an
+ * iconv_t object is never shared.  A worker thread's cache is freed when the
+ * thread exits.
  *
  * @note By design charset-hooks should never be, and are never, applied
  * to tocode.
@@ -595,46 +864,33 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t fla
 {
   char tocode1[128] = { 0 };
   char fromcode1[128] = { 0 };
+  char key[256] = { 0 };
   const char *tocode2 = NULL, *fromcode2 = NULL;
-  const char *tmp = NULL;
 
-  /* transform to MIME preferred charset names */
-  mutt_ch_canonical_charset(tocode1, sizeof(tocode1), tocode);
-  mutt_ch_canonical_charset(fromcode1, sizeof(fromcode1), fromcode);
+  /* transform to MIME preferred charset names, maybe applying charset-hooks
+   * to fromcode, but only when caller asked us to sanitize a potentially
+   * wrong charset name incoming from the wild exterior. */
+  canon_cache_get(tocode, false, tocode1, sizeof(tocode1));
+  canon_cache_get(fromcode, (flags & MUTT_ICONV_HOOK_FROM), fromcode1, sizeof(fromcode1));
 
-  /* maybe apply charset-hooks and recanonicalise fromcode,
-   * but only when caller asked us to sanitize a potentially wrong
-   * charset name incoming from the wild exterior. */
-  if (flags & MUTT_ICONV_HOOK_FROM)
-  {
-    tmp = mutt_ch_charset_lookup(fromcode1);
-    if (tmp)
-      mutt_ch_canonical_charset(fromcode1, sizeof(fromcode1), tmp);
-  }
+  struct CharsetCache *cache = iconv_cache_get(true);
 
   /* check if we have this pair cached already */
-  for (int i = 0; i < IconvCacheUsed; i++)
+  snprintf(key, sizeof(key), "%s\t%s\t%d", tocode1, fromcode1, flags);
+  struct CharsetCacheEntry *cce = charset_cache_find(cache, key);
+  if (cce && !iconv_t_valid(cce->cd) && (cce->hook_gen != hook_gen_get()))
   {
-    if (strcmp(tocode1, IconvCache[i].tocode1) == 0 &&
-        strcmp(fromcode1, IconvCache[i].fromcode1) == 0)
-    {
-      iconv_t cd = IconvCache[i].cd;
-
-      /* make room for this one at the top */
-      struct IconvCacheEntry top = IconvCache[i];
-      for (int j = i - 1; j >= 0; j--)
-      {
-        IconvCache[j + 1] = IconvCache[j];
-      }
-      IconvCache[0] = top;
+    /* a failure from before the hooks changed */
+    charset_cache_remove(cache, cce);
+    cce = NULL;
+  }
 
-      if (iconv_t_valid(cd))
-      {
-        /* reset state */
-        iconv(cd, NULL, NULL, NULL, NULL);
-      }
-      return cd;
-    }
+  if (cce)
+  {
+    /* reset state */
+    if (iconv_t_valid(cce->cd))
+      iconv(cce->cd, NULL, NULL, NULL, NULL);
+    return cce->cd;
   }
 
   /* not found in cache */
@@ -645,35 +901,13 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t fla
   fromcode2 = fromcode2 ? fromcode2 : fromcode1;
 
   /* call system iconv with names it appreciates */
+  const unsigned int gen = hook_gen_get();
   iconv_t cd = iconv_open(tocode2, fromcode2);
 
-  if (IconvCacheUsed == ICONV_CACHE_SIZE)
-  {
-    mutt_debug(LL_DEBUG2, "iconv: dropping %s -> %s from the cache\n",
-               IconvCache[IconvCacheUsed - 1].fromcode1,
-               IconvCache[IconvCacheUsed - 1].tocode1);
-    /* get rid of the oldest entry */
-    FREE(&IconvCache[IconvCacheUsed - 1].fromcode1);
-    FREE(&IconvCache[IconvCacheUsed - 1].tocode1);
-    if (iconv_t_valid(IconvCache[IconvCacheUsed - 1].cd))
-    {
-      iconv_close(IconvCache[IconvCacheUsed - 1].cd);
-    }
-    IconvCacheUsed--;
-  }
-
-  /* make room for this one at the top */
-  for (int j = IconvCacheUsed - 1; j >= 0; j--)
-  {
-    IconvCache[j + 1] = IconvCache[j];
-  }
-
-  IconvCacheUsed++;
-
-  mutt_debug(LL_DEBUG2, "iconv: adding %s -> %s to the cache\n", fromcode1, tocode1);
-  IconvCache[0].fromcode1 = strdup(fromcode1);
-  IconvCache[0].tocode1 = strdup(tocode1);
-  IconvCache[0].cd = cd;
+  /* failures are cached too, until the hooks change */
+  cce = charset_cache_add(cache, key);
+  cce->cd = cd;
+  cce->hook_gen = gen;
 
   return cd;
 }
@@ -1174,14 +1408,16 @@ char *mutt_ch_choose(const char *fromcode, const struct Slist *charsets,
  */
 void mutt_ch_cache_cleanup(void)
 {
-  for (int i = 0; i < IconvCacheUsed; i++)
-  {
-    FREE(&IconvCache[i].fromcode1);
-    FREE(&IconvCache[i].tocode1);
-    if (iconv_t_valid(IconvCache[i].cd))
-    {
-      iconv_close(IconvCache[i].cd);
-    }
-  }
-  IconvCacheUsed = 0;
+  struct CharsetCache *cache = iconv_cache_get(false);
+  charset_cache_free(&cache);
+#ifdef HAVE_PTHREAD
+  pthread_setspecific(IconvCacheKey, NULL);
+#else
+  IconvCache = NULL;
+#endif
+
+  canon_cache_lock();
+  charset_cache_free(&CanonCache);
+  charset_cache_free(&CanonHookCache);
+  canon_cache_unlock();
 }
@@ -25,34 +25,97 @@
  * @page mutt_hash Hash Table data structure
  *
  * Hash Table data structure.
+ *
+ * The table is an array of slots, using open addressing with linear probing.
+ * Each slot stores the full hash of its key, so most mismatches are rejected
+ * without comparing the keys.
+ *
+ * The number of slots is always a power of two.  When the table becomes three
+ * quarters full, it is doubled and the keys are redistributed.  Deleting a key
+ * moves any following keys back into the gap, so there are no tombstones.
+ *
+ * If duplicate keys are allowed, the extra HashElem's are chained from the
+ * first one, using HashElem.next.
+ *
+ * The HashElem's are allocated individually, so their addresses don't change
+ * when the table grows.
  */
 
 #include "config.h"
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include "hash.h"
 #include "memory.h"
 #include "string2.h"
 
-#define SOME_PRIME 149711
+/// Minimum number of slots in a Hash Table
+#define HASH_MIN_SLOTS 8
+
+/**
+ * hash_mix - Scramble the bits of a hash
+ * @param h Hash
+ * @retval num Mixed hash
+ *
+ * This is the 64-bit finaliser from MurmurHash3.
+ */
+static inline uint64_t hash_mix(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * hash_round - Add a word to a hash
+ * @param h Hash
+ * @param w Word of the key
+ * @retval num Updated hash
+ */
+static inline uint64_t hash_round(uint64_t h, uint64_t w)
+{
+  w *= 0x87c37b91114253d5ULL;
+  w = (w << 31) | (w >> 33);
+  w *= 0x4cf5ad432745937fULL;
+  h ^= w;
+  h = (h << 27) | (h >> 37);
+  return (h * 5) + 0x52dce729;
+}
 
 /**
  * gen_hash_string - Generate a hash from a string - Implements ::hash_gen_hash_t - @ingroup hash_gen_hash_api
  *
- * @note If the key is NULL or empty, the retval will be 0
+ * The string is read eight bytes at a time.
  */
-static size_t gen_hash_string(union HashKey key, size_t num_elems)
+static size_t gen_hash_string(union HashKey key)
 {
-  size_t hash = 0;
-  const unsigned char *s = (const unsigned char *) key.strkey;
+  const char *s = key.strkey;
   if (!s)
     return 0;
 
-  while (*s != '\0')
-    hash += ((hash << 7) + *s++);
-  hash = (hash * SOME_PRIME) % num_elems;
+  const size_t len = strlen(s);
+  uint64_t h = len;
+  size_t i = 0;
+
+  for (; (i + 8) <= len; i += 8)
+  {
+    uint64_t w = 0;
+    memcpy(&w, s + i, sizeof(w));
+    h = hash_round(h, w);
+  }
+
+  if (i < len)
+  {
+    uint64_t w = 0;
+    memcpy(&w, s + i, len - i);
+    h = hash_round(h, w);
+  }
 
-  return hash;
+  return (size_t) hash_mix(h);
 }
 
 /**
@@ -65,21 +128,31 @@ static int cmp_key_string(union HashKey a, union HashKey b)
 
 /**
  * gen_hash_case_string - Generate a hash from a string (ignore the case) - Implements ::hash_gen_hash_t - @ingroup hash_gen_hash_api
- *
- * @note If the key is NULL or empty, the retval will be 0
  */
-static size_t gen_hash_case_string(union HashKey key, size_t num_elems)
+static size_t gen_hash_case_string(union HashKey key)
 {
-  size_t hash = 0;
   const unsigned char *s = (const unsigned char *) key.strkey;
   if (!s)
     return 0;
 
+  uint64_t h = 0;
+  size_t len = 0;
+
   while (*s != '\0')
-    hash += ((hash << 7) + tolower(*s++));
-  hash = (hash * SOME_PRIME) % num_elems;
+  {
+    unsigned char buf[8] = { 0 };
+    size_t n = 0;
+    for (; (n < sizeof(buf)) && (s[n] != '\0'); n++)
+      buf[n] = tolower(s[n]);
+
+    uint64_t w = 0;
+    memcpy(&w, buf, sizeof(w));
+    h = hash_round(h, w);
+    s += n;
+    len += n;
+  }
 
-  return hash;
+  return (size_t) hash_mix(h ^ len);
 }
 
 /**
@@ -93,9 +166,9 @@ static int cmp_key_case_string(union HashKey a, union HashKey b)
 /**
  * gen_hash_int - Generate a hash from an integer - Implements ::hash_gen_hash_t - @ingroup hash_gen_hash_api
  */
-static size_t gen_hash_int(union HashKey key, size_t num_elems)
+static size_t gen_hash_int(union HashKey key)
 {
-  return (key.intkey % num_elems);
+  return (size_t) hash_mix(key.intkey);
 }
 
 /**
@@ -115,19 +188,97 @@ static int cmp_key_int(union HashKey a, union HashKey b)
  * @param num_elems Number of elements it should contain
  * @retval ptr New Hash Table
  *
- * The Hash Table can contain more elements than num_elems, but they will be
- * chained together.
+ * The Hash Table will grow if more than num_elems elements are added.
  */
 static struct HashTable *hash_new(size_t num_elems)
 {
   struct HashTable *table = MUTT_MEM_CALLOC(1, struct HashTable);
-  if (num_elems == 0)
-    num_elems = 2;
-  table->num_elems = num_elems;
-  table->table = MUTT_MEM_CALLOC(num_elems, struct HashElem *);
+  size_t slots = HASH_MIN_SLOTS;
+  while (slots < num_elems)
+    slots *= 2;
+  table->num_elems = slots;
+  table->table = MUTT_MEM_CALLOC(slots, struct HashSlot);
   return table;
 }
 
+/**
+ * hash_find_slot - Find the slot for a key
+ * @param table Hash Table to search
+ * @param key   Key (either string or integer)
+ * @param hash  Hash of the key
+ * @retval ptr Slot holding the key, or the empty slot where it belongs
+ */
+static struct HashSlot *hash_find_slot(const struct HashTable *table,
+                                       union HashKey key, size_t hash)
+{
+  const size_t mask = table->num_elems - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask)
+  {
+    struct HashSlot *slot = &table->table[i];
+    if (!slot->he)
+      return slot;
+    if ((slot->hash == hash) && (table->cmp_key(slot->he->key, key) == 0))
+      return slot;
+  }
+}
+
+/**
+ * hash_grow - Double the number of slots in a Hash Table
+ * @param table Hash Table to grow
+ */
+static void hash_grow(struct HashTable *table)
+{
+  struct HashSlot *old = table->table;
+  const size_t old_size = table->num_elems;
+
+  table->num_elems = old_size * 2;
+  table->table = MUTT_MEM_CALLOC(table->num_elems, struct HashSlot);
+
+  // The keys are unique, so they don't need to be compared
+  const size_t mask = table->num_elems - 1;
+  for (size_t i = 0; i < old_size; i++)
+  {
+    if (!old[i].he)
+      continue;
+
+    size_t j = old[i].hash & mask;
+    while (table->table[j].he)
+      j = (j + 1) & mask;
+    table->table[j] = old[i];
+  }
+
+  FREE(&old);
+}
+
+/**
+ * hash_remove_slot - Empty a slot and close the gap
+ * @param table Hash Table
+ * @param slot  Slot to empty
+ *
+ * Any keys, after the slot, that belong earlier are moved back, so that
+ * linear probing will still find them.
+ */
+static void hash_remove_slot(struct HashTable *table, struct HashSlot *slot)
+{
+  const size_t mask = table->num_elems - 1;
+  size_t gap = slot - table->table;
+
+  for (size_t i = (gap + 1) & mask; table->table[i].he; i = (i + 1) & mask)
+  {
+    // Distance of the key from its ideal slot, and of the gap from that slot
+    const size_t ideal = table->table[i].hash & mask;
+    if (((i - ideal) & mask) >= ((i - gap) & mask))
+    {
+      table->table[gap] = table->table[i];
+      gap = i;
+    }
+  }
+
+  table->table[gap].he = NULL;
+  table->table[gap].hash = 0;
+  table->num_keys--;
+}
+
 /**
  * union_hash_insert - Insert into a hash table using a union as a key
  * @param table Hash Table to update
@@ -142,38 +293,34 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
+  const size_t hash = table->gen_hash(key);
+  struct HashSlot *slot = hash_find_slot(table, key, hash);
+
+  if (slot->he && !table->allow_dups)
+    return NULL;
+
+  if (!slot->he && (((table->num_keys + 1) * 4) > (table->num_elems * 3)))
+  {
+    hash_grow(table);
+    slot = hash_find_slot(table, key, hash);
+  }
+
   struct HashElem *he = MUTT_MEM_CALLOC(1, struct HashElem);
-  size_t hash = table->gen_hash(key, table->num_elems);
   he->key = key;
   he->data = data;
   he->type = type;
 
-  if (table->allow_dups)
+  if (slot->he)
   {
-    he->next = table->table[hash];
-    table->table[hash] = he;
+    he->next = slot->he;
   }
   else
   {
-    struct HashElem *tmp = NULL, *last = NULL;
-
-    for (tmp = table->table[hash], last = NULL; tmp; last = tmp, tmp = tmp->next)
-    {
-      const int rc = table->cmp_key(tmp->key, key);
-      if (rc == 0)
-      {
-        FREE(&he);
-        return NULL;
-      }
-      if (rc > 0)
-        break;
-    }
-    if (last)
-      last->next = he;
-    else
-      table->table[hash] = he;
-    he->next = tmp;
+    slot->hash = hash;
+    table->num_keys++;
   }
+  slot->he = he;
+
   return he;
 }
 
@@ -185,17 +332,10 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
  */
 static struct HashElem *union_hash_find_elem(const struct HashTable *table, union HashKey key)
 {
-  if (!table)
-    return NULL; // LCOV_EXCL_LINE
+  if (!table || !table->table)
+    return NULL;
 
-  size_t hash = table->gen_hash(key, table->num_elems);
-  struct HashElem *he = table->table[hash];
-  for (; he; he = he->next)
-  {
-    if (table->cmp_key(key, he->key) == 0)
-      return he;
-  }
-  return NULL;
+  return hash_find_slot(table, key, table->gen_hash(key))->he;
 }
 
 /**
@@ -222,16 +362,20 @@ static void *union_hash_find(const struct HashTable *table, union HashKey key)
  */
 static void union_hash_delete(struct HashTable *table, union HashKey key, const void *data)
 {
-  if (!table)
+  if (!table || !table->table)
     return; // LCOV_EXCL_LINE
 
-  size_t hash = table->gen_hash(key, table->num_elems);
-  struct HashElem *he = table->table[hash];
-  struct HashElem **he_last = &table->table[hash];
+  struct HashSlot *slot = hash_find_slot(table, key, table->gen_hash(key));
+  if (!slot->he)
+    return;
+
+  struct HashElem *he = slot->he;
+  struct HashElem **he_last = &slot->he;
 
+  // Every element in the slot has the same key
   while (he)
   {
-    if (((data == he->data) || !data) && (table->cmp_key(he->key, key) == 0))
+    if ((data == he->data) || !data)
     {
       *he_last = he->next;
       if (table->hdata_free)
@@ -248,6 +392,9 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
       he = he->next;
     }
   }
+
+  if (!slot->he)
+    hash_remove_slot(table, slot);
 }
 
 /**
@@ -322,7 +469,10 @@ struct HashElem *mutt_hash_typed_insert(struct HashTable *table,
 
   union HashKey key;
   key.strkey = table->strdup_keys ? mutt_str_dup(strkey) : strkey;
-  return union_hash_insert(table, key, type, data);
+  struct HashElem *he = union_hash_insert(table, key, type, data);
+  if (!he && table->strdup_keys)
+    FREE(&key.strkey);
+  return he;
 }
 
 /**
@@ -404,7 +554,7 @@ void *mutt_hash_int_find(const struct HashTable *table, unsigned int intkey)
  * @param strkey String key to search for
  * @retval ptr HashElem matching the key
  *
- * Unlike mutt_hash_find_elem(), this will return the first matching entry.
+ * The HashElem's with the same key can be iterated using HashElem.next.
  */
 struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char *strkey)
 {
@@ -412,10 +562,8 @@ struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char
     return NULL;
 
   union HashKey key;
-
   key.strkey = strkey;
-  size_t hash = table->gen_hash(key, table->num_elems);
-  return table->table[hash];
+  return union_hash_find_elem(table, key);
 }
 
 /**
@@ -429,10 +577,9 @@ void mutt_hash_delete(struct HashTable *table, const char *strkey, const void *d
   if (!table || !strkey || (strkey[0] == '\0'))
     return;
   union HashKey key;
-  // Copy the key because union_hash_delete() may use it after the HashElem is freed.
-  key.strkey = mutt_str_dup(strkey);
+  // The key is only compared once, before any HashElem is freed
+  key.strkey = strkey;
   union_hash_delete(table, key, data);
-  FREE(&key.strkey);
 }
 
 /**
@@ -464,7 +611,7 @@ void mutt_hash_free(struct HashTable **ptr)
 
   for (size_t i = 0; i < table->num_elems; i++)
   {
-    for (he = table->table[i]; he;)
+    for (he = table->table[i].he; he;)
     {
       tmp = he;
       he = he->next;
@@ -502,9 +649,9 @@ struct HashElem *mutt_hash_walk(const struct HashTable *table, struct HashWalkSt
 
   while (state->index < table->num_elems)
   {
-    if (table->table[state->index])
+    if (table->table[state->index].he)
     {
-      state->last = table->table[state->index];
+      state->last = table->table[state->index].he;
       return state->last;
     }
     state->index++;
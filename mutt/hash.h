@@ -45,7 +45,7 @@ struct HashElem
   int type;              ///< Type of data stored in Hash Table, e.g. #DT_STRING
   union HashKey key;     ///< Key representing the data
   void *data;            ///< User-supplied data
-  struct HashElem *next; ///< Linked List
+  struct HashElem *next; ///< Next element with the same key (if duplicates are allowed)
 };
 ARRAY_HEAD(HashElemArray, struct HashElem *);
 
@@ -67,13 +67,13 @@ typedef void (*hash_hdata_free_t)(int type, void *obj, intptr_t data);
  *
  * Prototype for a Key hashing function
  *
- * @param key       Key to hash
- * @param num_elems Number of elements in the Hash Table
+ * @param key Key to hash
+ * @retval num Hash of the key
  *
- * Turn a Key (a string or an integer) into a hash id.
- * The hash id will be a number between 0 and (num_elems-1).
+ * Turn a Key (a string or an integer) into a well-mixed hash.
+ * The Hash Table uses the low bits to choose a slot.
  */
-typedef size_t (*hash_gen_hash_t)(union HashKey key, size_t num_elems);
+typedef size_t (*hash_gen_hash_t)(union HashKey key);
 
 /**
  * @defgroup hash_cmp_key_api Hash Table Compare API
@@ -90,17 +90,31 @@ typedef size_t (*hash_gen_hash_t)(union HashKey key, size_t num_elems);
  */
 typedef int (*hash_cmp_key_t)(union HashKey a, union HashKey b);
 
+/**
+ * struct HashSlot - A slot in a Hash Table
+ *
+ * Each slot holds one key.  Duplicates of the key are chained from the
+ * HashElem, using HashElem.next.
+ */
+struct HashSlot
+{
+  size_t hash;          ///< Hash of the key, see ::hash_gen_hash_t
+  struct HashElem *he;  ///< Elements with this key, NULL if the slot is empty
+};
+
 /**
  * struct HashTable - A Hash Table
  *
- * @note The number of actual elements in the HashTable isn't recorded.
+ * The table uses open addressing with linear probing.  The number of slots is
+ * a power of two and it grows as the table fills.
  */
 struct HashTable
 {
-  size_t num_elems;             ///< Number of buckets in the Hash Table
+  size_t num_elems;             ///< Number of slots in the Hash Table
+  size_t num_keys;              ///< Number of slots in use
   bool strdup_keys : 1;         ///< if set, the key->strkey is strdup()'d
   bool allow_dups  : 1;         ///< if set, duplicate keys are allowed
-  struct HashElem **table;      ///< Array of Hash keys
+  struct HashSlot *table;       ///< Array of slots
   hash_gen_hash_t gen_hash;     ///< Function to generate hash id from the key
   hash_cmp_key_t cmp_key;       ///< Function to compare two Hash keys
   intptr_t hdata;               ///< Data to pass to the hdata_free() function
@@ -132,8 +146,8 @@ struct HashElem * mutt_hash_typed_insert  (struct HashTable *table, const char *
  */
 struct HashWalkState
 {
-  size_t index;          ///< Current position in table
-  struct HashElem *last; ///< Current element in linked list
+  size_t index;          ///< Current slot in table
+  struct HashElem *last; ///< Current element in the slot's list
 };
 
 struct HashElem *mutt_hash_walk(const struct HashTable *table, struct HashWalkState *state);
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * Stable radix sort on a numeric key
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_radix_sort Stable radix sort on a numeric key
+ *
+ * Sort an array of records by an unsigned 64-bit key, which is stored in each
+ * record.  This is a stable LSD radix sort, one byte at a time.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "radix_sort.h"
+#include "memory.h"
+
+/**
+ * get_key - Get the key of a record
+ * @param rec    Record
+ * @param offset Offset of the key in the record
+ * @param flip   Value to XOR with the key
+ * @retval num Key
+ */
+static uint64_t get_key(const char *rec, size_t offset, uint64_t flip)
+{
+  uint64_t key = 0;
+  memcpy(&key, rec + offset, sizeof(key));
+  return key ^ flip;
+}
+
+/**
+ * mutt_radix_sort - Sort an array by a numeric key
+ * @param base    Array to sort
+ * @param nmemb   Number of records
+ * @param size    Size of each record
+ * @param offset  Offset of the `uint64_t` key in each record
+ * @param reverse If true, sort in descending order
+ *
+ * The sort is stable, records with equal keys keep their order, even when
+ * sorting in reverse.  Bytes that are the same in every key, e.g. the top
+ * bytes of a date, are skipped.
+ */
+void mutt_radix_sort(void *base, size_t nmemb, size_t size, size_t offset, bool reverse)
+{
+  if (!base || (nmemb < 2) || (size < (offset + sizeof(uint64_t))))
+    return;
+
+  const uint64_t flip = reverse ? UINT64_MAX : 0;
+
+  size_t *counts = MUTT_MEM_CALLOC(8 * 256, size_t);
+  for (size_t i = 0; i < nmemb; i++)
+  {
+    const uint64_t key = get_key((char *) base + (i * size), offset, flip);
+    for (int b = 0; b < 8; b++)
+      counts[(b * 256) + ((key >> (b * 8)) & 0xff)]++;
+  }
+
+  char *tmp = MUTT_MEM_MALLOC(nmemb * size, char);
+  char *src = base;
+  char *dst = tmp;
+
+  for (int b = 0; b < 8; b++)
+  {
+    size_t *count = counts + (b * 256);
+    const uint8_t first = (get_key(src, offset, flip) >> (b * 8)) & 0xff;
+    if (count[first] == nmemb)
+      continue;
+
+    size_t pos = 0;
+    for (int c = 0; c < 256; c++)
+    {
+      const size_t n = count[c];
+      count[c] = pos;
+      pos += n;
+    }
+
+    for (size_t i = 0; i < nmemb; i++)
+    {
+      const char *rec = src + (i * size);
+      const uint8_t byte = (get_key(rec, offset, flip) >> (b * 8)) & 0xff;
+      memcpy(dst + (count[byte]++ * size), rec, size);
+    }
+
+    char *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != base)
+    memcpy(base, src, nmemb * size);
+
+  FREE(&tmp);
+  FREE(&counts);
+}
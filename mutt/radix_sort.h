@@ -0,0 +1,31 @@
+/**
+ * @file
+ * Stable radix sort on a numeric key
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_RADIX_SORT_H
+#define MUTT_MUTT_RADIX_SORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+void mutt_radix_sort(void *base, size_t nmemb, size_t size, size_t offset, bool reverse);
+
+#endif /* MUTT_MUTT_RADIX_SORT_H */
@@ -0,0 +1,138 @@
+/**
+ * @file
+ * Run a job over a range of items using worker threads
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_worker Run a job using worker threads
+ *
+ * Run a job over a range of items, sharing the work between several threads.
+ * The calling thread takes part in the work, and the function returns when
+ * every item has been processed.
+ *
+ * If NeoMutt was built without POSIX threads, the items are processed
+ * serially, in order.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <stdbool.h>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+#include "worker.h"
+
+#ifdef HAVE_PTHREAD
+/**
+ * struct WorkerQueue - A range of items shared between threads
+ */
+struct WorkerQueue
+{
+  pthread_mutex_t lock; ///< Protects next
+  size_t next;          ///< Next item to process
+  size_t count;         ///< Number of items
+  worker_job_t job;     ///< Function to process an item
+  void *data;           ///< Private data for the job
+};
+
+/**
+ * worker_next - Claim the next item from the queue
+ * @param[in]  wq    Queue
+ * @param[out] index Index of the claimed item
+ * @retval true An item was claimed
+ */
+static bool worker_next(struct WorkerQueue *wq, size_t *index)
+{
+  bool rc = false;
+
+  pthread_mutex_lock(&wq->lock);
+  if (wq->next < wq->count)
+  {
+    *index = wq->next++;
+    rc = true;
+  }
+  pthread_mutex_unlock(&wq->lock);
+
+  return rc;
+}
+
+/**
+ * worker_main - Process items until the queue is empty
+ * @param arg WorkerQueue
+ * @retval NULL Always
+ */
+static void *worker_main(void *arg)
+{
+  struct WorkerQueue *wq = arg;
+  size_t index = 0;
+
+  while (worker_next(wq, &index))
+    wq->job(index, wq->data);
+
+  return NULL;
+}
+#endif
+
+/**
+ * mutt_worker_run - Run a job over a range of items
+ * @param count   Number of items
+ * @param threads Maximum number of threads to use, including the caller
+ * @param job     Function to process each item
+ * @param data    Private data passed to the job
+ *
+ * Each index in [0, count) is passed to @a job exactly once.  The order in
+ * which the items are processed is unspecified if @a threads is greater than 1.
+ */
+void mutt_worker_run(size_t count, int threads, worker_job_t job, void *data)
+{
+  if (!job || (count == 0))
+    return;
+
+#ifdef HAVE_PTHREAD
+  if ((threads > 1) && ((size_t) threads > count))
+    threads = count;
+  if (threads > MUTT_WORKER_MAX_THREADS)
+    threads = MUTT_WORKER_MAX_THREADS;
+
+  if (threads > 1)
+  {
+    struct WorkerQueue wq = { .next = 0, .count = count, .job = job, .data = data };
+    pthread_t tids[MUTT_WORKER_MAX_THREADS];
+    int started = 0;
+
+    pthread_mutex_init(&wq.lock, NULL);
+    for (; started < (threads - 1); started++)
+    {
+      if (pthread_create(&tids[started], NULL, worker_main, &wq) != 0)
+        break;
+    }
+
+    worker_main(&wq);
+
+    for (int i = 0; i < started; i++)
+      pthread_join(tids[i], NULL);
+    pthread_mutex_destroy(&wq.lock);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; i++)
+    job(i, data);
+}
@@ -0,0 +1,47 @@
+/**
+ * @file
+ * Run a job over a range of items using worker threads
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_WORKER_H
+#define MUTT_MUTT_WORKER_H
+
+#include <stddef.h>
+
+/**
+ * @defgroup worker_job_api Worker Job API
+ *
+ * Prototype for a Worker Job
+ *
+ * worker_job_t - Process one item
+ * @param index Index of the item, 0 <= index < count
+ * @param data  Private data passed to mutt_worker_run()
+ *
+ * @note The function may be called from any thread.
+ *       It must not use the Buffer pool, logging, or any other global state.
+ */
+typedef void (*worker_job_t)(size_t index, void *data);
+
+/// Upper limit for the number of worker threads
+#define MUTT_WORKER_MAX_THREADS 64
+
+void mutt_worker_run(size_t count, int threads, worker_job_t job, void *data);
+
+#endif /* MUTT_MUTT_WORKER_H */
@@ -895,6 +895,7 @@ static void init_variables(struct ConfigSet *cs)
 #if defined(USE_AUTOCRYPT)
   CONFIG_INIT_VARS(cs, autocrypt);
 #endif
+  CONFIG_INIT_VARS(cs, bcache);
   CONFIG_INIT_VARS(cs, browser);
   CONFIG_INIT_VARS(cs, compose);
   CONFIG_INIT_VARS(cs, conn);
@@ -163,6 +163,7 @@ int mutt_label_message(struct MailboxView *mv, struct EmailArray *ea)
     {
       changed++;
       email_set_color(m, e);
+      m->view_gen++;
     }
   }
 
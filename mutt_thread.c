@@ -768,10 +768,71 @@ static int compare_threads(const void *a, const void *b, void *sdata)
   }
 }
 
+/**
+ * sort_siblings - Sort a list of sibling threads
+ * @param array Siblings, from the last to the first
+ * @param num   Number of siblings
+ * @param init  If true, sort all the siblings
+ * @param tctx  Threading context
+ *
+ * The siblings that haven't changed since the last sort are still in order.
+ * If only a few of a long list have changed, just those are sorted and then
+ * merged back in.
+ */
+static void sort_siblings(struct MuttThread **array, int num, bool init,
+                          struct ThreadsContext *tctx)
+{
+  int num_dirty = 0;
+  for (int i = 0; !init && (i < num); i++)
+  {
+    if (array[i]->sort_dirty)
+      num_dirty++;
+  }
+
+  if (init || (num < 64) || (num_dirty > (num / 8)))
+  {
+    mutt_qsort_r((void *) array, num, sizeof(struct MuttThread *), compare_threads, tctx);
+    return;
+  }
+
+  if (num_dirty == 0)
+    return;
+
+  /* Move the changed siblings out of the way, keeping the rest in order */
+  struct MuttThread **dirty = MUTT_MEM_MALLOC(num_dirty, struct MuttThread *);
+  int num_clean = 0;
+  num_dirty = 0;
+  for (int i = 0; i < num; i++)
+  {
+    if (array[i]->sort_dirty)
+      dirty[num_dirty++] = array[i];
+    else
+      array[num_clean++] = array[i];
+  }
+
+  mutt_qsort_r((void *) dirty, num_dirty, sizeof(struct MuttThread *), compare_threads, tctx);
+
+  /* Merge from the end, so the clean siblings are never overwritten */
+  int c = num_clean - 1;
+  int d = num_dirty - 1;
+  for (int i = num - 1; d >= 0; i--)
+  {
+    if ((c >= 0) && (compare_threads(&array[c], &dirty[d], tctx) > 0))
+      array[i] = array[c--];
+    else
+      array[i] = dirty[d--];
+  }
+
+  FREE(&dirty);
+}
+
 /**
  * mutt_sort_subthreads - Sort the children of a thread
  * @param tctx Threading context
  * @param init If true, rebuild the thread
+ *
+ * Unless init is set, only the subthreads marked `sort_dirty` are visited.
+ * The sort keys of the rest are still valid from the last sort.
  */
 static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
 {
@@ -816,6 +877,7 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
     {
       thread->sort_thread_key = NULL;
       thread->sort_aux_key = NULL;
+      thread->sort_dirty = true;
 
       if (thread->parent)
         thread->parent->sort_children = true;
@@ -823,22 +885,24 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
         sort_top = true;
     }
 
-    if (thread->child)
+    /* an unchanged subthread keeps the sort keys from the last sort */
+    if (thread->child && (init || thread->sort_dirty))
     {
       thread = thread->child;
       continue;
     }
-    else
+
+    if (!thread->child)
     {
       /* if it has no children, it must be real. sort it on its own merits */
       thread->sort_thread_key = thread->message;
       thread->sort_aux_key = thread->message;
+    }
 
-      if (thread->next)
-      {
-        thread = thread->next;
-        continue;
-      }
+    if (thread->next)
+    {
+      thread = thread->next;
+      continue;
     }
 
     struct Mailbox *m = tctx->mailbox_view->mailbox;
@@ -860,7 +924,7 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
           array[i] = thread;
         }
 
-        mutt_qsort_r((void *) array, i, sizeof(struct MuttThread *), compare_threads, tctx);
+        sort_siblings(array, i, init, tctx);
 
         /* attach them back together.  make thread the last sibling. */
         thread = array[0];
@@ -879,6 +943,10 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
         }
       }
 
+      /* all the siblings are in order now */
+      for (tmp = thread; tmp; tmp = tmp->prev)
+        tmp->sort_dirty = false;
+
       if (thread->parent)
       {
         tmp = thread;
@@ -1068,6 +1136,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
    * new message as an identical child.  if we didn't attach the message to a
    * MuttThread, make a new one for it. */
   const bool c_duplicate_threads = cs_subset_bool(NeoMutt->sub, "duplicate_threads");
+  const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
   for (i = 0; i < m->msg_count; i++)
   {
     e = m->emails[i];
@@ -1076,6 +1145,10 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
 
     if (e->thread)
     {
+      /* there are no pseudo-threads to undo, leave the message where it is */
+      if (c_strict_threads)
+        continue;
+
       /* unlink pseudo-threads because they might be children of newly
        * arrived messages */
       thread = e->thread;
@@ -1257,7 +1330,6 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
 
   check_subjects(mv, init);
 
-  const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
   if (!c_strict_threads)
     pseudo_threads(tctx);
 
@@ -1410,6 +1482,7 @@ off_t mutt_set_vnum(struct Mailbox *m)
   const int padding = mx_msg_padding_size(m);
 
   m->vcount = 0;
+  m->view_gen++;
 
   for (int i = 0; i < m->msg_count; i++)
   {
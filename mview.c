@@ -223,6 +223,8 @@ void mview_update(struct MailboxView *mv)
     }
   }
 
+  flag_index_invalidate(m);
+
   /* rethread from scratch */
   mutt_sort_headers(mv, true);
 }
@@ -316,6 +318,8 @@ static void update_tables(struct MailboxView *mv)
     }
   }
   m->msg_count = j;
+  flag_index_invalidate(m);
+  m->view_gen++;
 }
 
 /**
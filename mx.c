@@ -368,6 +368,7 @@ bool mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
   m->msg_deleted = 0;
   m->msg_tagged = 0;
   m->vcount = 0;
+  flag_index_invalidate(m);
 
   enum MxOpenReturns rc = m->mx_ops->mbox_open(m);
   m->opened++;
@@ -431,6 +432,7 @@ void mx_fastclose_mailbox(struct Mailbox *m, bool keep_account)
   mutt_hash_free(&m->subj_hash);
   mutt_hash_free(&m->id_hash);
   mutt_hash_free(&m->label_hash);
+  flag_index_invalidate(m);
 
   if (m->emails)
   {
@@ -989,6 +991,7 @@ enum MxStatus mx_mbox_sync(struct Mailbox *m)
     rc = imap_sync_mailbox(m, purge, false);
   else
     rc = sync_mailbox(m);
+  flag_index_invalidate(m);
   if (rc != MX_STATUS_ERROR)
   {
     if ((m->type == MUTT_IMAP) && !purge)
@@ -1125,6 +1128,10 @@ enum MxStatus mx_mbox_check(struct Mailbox *m)
   {
     mailbox_changed(m, NT_MAILBOX_INVALID);
   }
+  else if (rc == MX_STATUS_FLAGS)
+  {
+    flag_index_invalidate(m);
+  }
 
   return rc;
 }
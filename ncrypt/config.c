@@ -336,6 +336,12 @@ static struct ConfigDef NcryptVarsPgp[] = {
   { "pgp_import_command", DT_EXPANDO|D_STRING_COMMAND, 0, IP &PgpCommandFormatDef, NULL,
     "(pgp) External command to import a key into the user's keyring"
   },
+  { "pgp_keyring_cache", DT_BOOL, false, 0, NULL,
+    "(pgp) Cache the parsed keyring listing"
+  },
+  { "pgp_keyring_cache_file", DT_PATH|D_PATH_FILE, 0, 0, NULL,
+    "(pgp) File in which to save the parsed keyring listing"
+  },
   { "pgp_list_pubring_command", DT_EXPANDO|D_STRING_COMMAND, 0, IP &PgpCommandFormatDef, NULL,
     "(pgp) External command to list the public keys in a user's keyring"
   },
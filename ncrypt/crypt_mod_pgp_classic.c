@@ -32,6 +32,7 @@
 #include "crypt_mod.h"
 #include "pgpinvoke.h"
 #include "pgpkey.h"
+#include "pgpkeyring.h"
 #ifdef CRYPT_BACKEND_CLASSIC_PGP
 #include "pgp.h"
 #endif
@@ -44,7 +45,7 @@ const struct CryptModuleSpecs CryptModPgpClassic = {
   APPLICATION_PGP,
 
   NULL, /* init */
-  NULL, /* cleanup */
+  pgp_keyring_cleanup,
   pgp_class_void_passphrase,
   pgp_class_valid_passphrase,
   pgp_class_decrypt_mime,
@@ -409,6 +409,89 @@ bail:
   return NULL;
 }
 
+/**
+ * struct PgpParseState - State of the parser of a key listing
+ */
+struct PgpParseState
+{
+  struct PgpKeyInfo *db;      ///< List of keys parsed so far
+  struct PgpKeyInfo **kend;   ///< End of the list of keys
+  struct PgpKeyInfo *k;       ///< Key being parsed
+  struct PgpKeyInfo *mainkey; ///< Principal key of the current subkeys
+};
+
+/**
+ * parse_line - Parse one line of a key listing
+ * @param state Parser state
+ * @param buf   Line to parse (will be altered)
+ */
+static void parse_line(struct PgpParseState *state, char *buf)
+{
+  bool is_sub = false;
+
+  struct PgpKeyInfo *kk = parse_pub_line(buf, &is_sub, state->k);
+  if (!kk)
+    return;
+
+  /* Only append kk to the list if it's new. */
+  if (kk == state->k)
+    return;
+
+  if (state->k)
+    state->kend = &state->k->next;
+  *state->kend = kk;
+  state->k = kk;
+
+  if (is_sub)
+  {
+    struct PgpUid **l = NULL;
+
+    kk->flags |= KEYFLAG_SUBKEY;
+    kk->parent = state->mainkey;
+    for (l = &kk->address; *l; l = &(*l)->next)
+      ; // do nothing
+
+    *l = pgp_copy_uids(state->mainkey->address, kk);
+  }
+  else
+  {
+    state->mainkey = kk;
+  }
+}
+
+/**
+ * pgp_parse_keys - Parse a key listing held in memory
+ * @param text Output of $pgp_list_pubring_command or $pgp_list_secring_command
+ * @param len  Length of the text
+ * @retval ptr  Key list
+ * @retval NULL No keys
+ *
+ * The text is parsed exactly as if it were read from the command.
+ */
+struct PgpKeyInfo *pgp_parse_keys(const char *text, size_t len)
+{
+  char buf[1024] = { 0 };
+  struct PgpParseState state = { 0 };
+  state.kend = &state.db;
+
+  mutt_str_replace(&Charset, cc_charset());
+
+  const char *end = text + len;
+  while (text && (text < end))
+  {
+    const char *nl = memchr(text, '\n', end - text);
+    const char *next = nl ? nl + 1 : end;
+    const size_t linelen = MIN((size_t) (next - text), sizeof(buf) - 2);
+
+    memcpy(buf, text, linelen);
+    buf[linelen] = '\0';
+    parse_line(&state, buf);
+    text = next;
+  }
+
+  return state.db;
+}
+
 /**
  * pgp_get_candidates - Find PGP keys matching a list of hints
  * @param keyring PGP Keyring
@@ -421,8 +504,8 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
   FILE *fp = NULL;
   pid_t pid;
   char buf[1024] = { 0 };
-  struct PgpKeyInfo *db = NULL, **kend = NULL, *k = NULL, *kk = NULL, *mainkey = NULL;
-  bool is_sub = false;
+  struct PgpParseState state = { 0 };
+  state.kend = &state.db;
 
   int fd_null = open("/dev/null", O_RDWR);
   if (fd_null == -1)
@@ -437,39 +520,8 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
     return NULL;
   }
 
-  kend = &db;
-  k = NULL;
   while (fgets(buf, sizeof(buf) - 1, fp))
-  {
-    kk = parse_pub_line(buf, &is_sub, k);
-    if (!kk)
-      continue;
-
-    /* Only append kk to the list if it's new. */
-    if (kk != k)
-    {
-      if (k)
-        kend = &k->next;
-      *kend = kk;
-      k = kk;
-
-      if (is_sub)
-      {
-        struct PgpUid **l = NULL;
-
-        k->flags |= KEYFLAG_SUBKEY;
-        k->parent = mainkey;
-        for (l = &k->address; *l; l = &(*l)->next)
-          ; // do nothing
-
-        *l = pgp_copy_uids(mainkey->address, k);
-      }
-      else
-      {
-        mainkey = k;
-      }
-    }
-  }
+    parse_line(&state, buf);
 
   if (ferror(fp))
     mutt_perror("fgets");
@@ -479,5 +531,5 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
 
   close(fd_null);
 
-  return db;
+  return state.db;
 }
@@ -24,10 +24,12 @@
 #ifndef MUTT_NCRYPT_GNUPGPARSE_H
 #define MUTT_NCRYPT_GNUPGPARSE_H
 
+#include <stddef.h>
 #include "pgpkey.h"
 
 struct ListHead;
 
-struct PgpKeyInfo * pgp_get_candidates(enum PgpRing keyring, struct ListHead *hints);
+struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hints);
+struct PgpKeyInfo *pgp_parse_keys    (const char *text, size_t len);
 
 #endif /* MUTT_NCRYPT_GNUPGPARSE_H */
@@ -51,6 +51,7 @@
  * | ncrypt/pgp_functions.c           | @subpage pgp_functions               |
  * | ncrypt/pgpinvoke.c               | @subpage crypt_pgpinvoke             |
  * | ncrypt/pgpkey.c                  | @subpage crypt_pgpkey                |
+ * | ncrypt/pgpkeyring.c              | @subpage crypt_pgpkeyring            |
  * | ncrypt/pgplib.c                  | @subpage crypt_pgplib                |
  * | ncrypt/pgpmicalg.c               | @subpage crypt_pgpmicalg             |
  * | ncrypt/pgppacket.c               | @subpage crypt_pgppacket             |
@@ -46,6 +46,7 @@
 #include "expando_command.h"
 #include "mutt_logging.h"
 #include "pgpkey.h"
+#include "pgpkeyring.h"
 #include "protos.h"
 #ifdef CRYPT_BACKEND_CLASSIC_PGP
 #include "pgp.h"
@@ -305,6 +306,8 @@ void pgp_class_invoke_import(const char *fname)
   if (mutt_system(buf_string(cmd)) != 0)
     mutt_debug(LL_DEBUG1, "Error running \"%s\"\n", buf_string(cmd));
 
+  pgp_keyring_reset();
+
   buf_pool_release(&buf_fname);
   buf_pool_release(&cmd);
 }
@@ -349,6 +352,8 @@ void pgp_class_invoke_getkeys(struct Address *addr)
   if (!isendwin())
     mutt_clear_error();
 
+  pgp_keyring_reset();
+
   if (fd_null >= 0)
     close(fd_null);
 
@@ -55,6 +55,7 @@
 #include "gnupgparse.h"
 #include "mutt_logging.h"
 #include "pgpinvoke.h"
+#include "pgpkeyring.h"
 #ifdef CRYPT_BACKEND_CLASSIC_PGP
 #include "pgp.h"
 #include "pgplib.h"
@@ -396,7 +397,8 @@ struct PgpKeyInfo *pgp_getkeybyaddr(struct Address *a, KeyFlags abilities,
 
   if (!oppenc_mode)
     mutt_message(_("Looking for keys matching \"%s\"..."), buf_string(a->mailbox));
-  keys = pgp_get_candidates(keyring, &hints);
+  if (!pgp_keyring_candidates(keyring, &hints, &keys))
+    keys = pgp_get_candidates(keyring, &hints);
 
   mutt_list_free(&hints);
 
@@ -531,7 +533,8 @@ struct PgpKeyInfo *pgp_getkeybystr(const char *cp, KeyFlags abilities, enum PgpR
 
   pfcopy = crypt_get_fingerprint_or_id(p, &phint, &pl, &ps);
   pgp_add_string_to_hints(phint, &hints);
-  keys = pgp_get_candidates(keyring, &hints);
+  if (!pgp_keyring_candidates(keyring, &hints, &keys))
+    keys = pgp_get_candidates(keyring, &hints);
   mutt_list_free(&hints);
 
   for (k = keys; k; k = kn)
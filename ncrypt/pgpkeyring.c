@@ -0,0 +1,738 @@
+/**
+ * @file
+ * Cache of the parsed PGP keyrings
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page crypt_pgpkeyring Cache of the parsed PGP keyrings
+ *
+ * Looking up a key used to run $pgp_list_pubring_command, or
+ * $pgp_list_secring_command, for every recipient.  If $pgp_keyring_cache is
+ * set, the whole keyring is listed once, indexed and kept in memory.
+ * Lookups are then answered without running any commands.
+ *
+ * The keys are indexed by:
+ * - key id and fingerprint, of the principal key and its subkeys
+ * - email address, of the user ids
+ *
+ * Other hints, e.g. parts of a name, are matched against the user ids, like
+ * gpg does.
+ *
+ * The cache is stamped with the size and modification time of the files in
+ * the GnuPG home directory, the list command, $charset and
+ * $pgp_ignore_subkeys.  If any of them change, or the cache is more than an
+ * hour old, the keyring is listed again.  If no GnuPG keyring files can be
+ * found, the cache isn't used.
+ *
+ * If $pgp_keyring_cache_file is set, the listing is saved there, with a
+ * suffix of `.pub` or `.sec`, so that it can be reused by the next NeoMutt.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "expando/lib.h"
+#include "pgpkeyring.h"
+#include "gnupgparse.h"
+#include "pgpinvoke.h"
+#include "pgpkey.h"
+#include "pgplib.h"
+
+/// Maximum age of a cached keyring, in seconds.
+/// Keys may expire, even if the keyring doesn't change.
+#define PGP_KEYRING_MAX_AGE (60 * 60)
+
+/// First line of a cache file, followed by the build time and the stamp
+static const char *const KeyringCacheHeader = "neomutt-pgp-keyring 1\t";
+
+/**
+ * struct KeyringGroup - A principal key and its subkeys
+ */
+struct KeyringGroup
+{
+  size_t offset;           ///< Start of the group in the listing
+  size_t len;              ///< Length of the group in the listing
+  struct PgpKeyInfo *keys; ///< Parsed keys, for matching the user ids
+};
+ARRAY_HEAD(KeyringGroupArray, struct KeyringGroup);
+
+/**
+ * struct PgpKeyring - A cached, indexed keyring listing
+ */
+struct PgpKeyring
+{
+  char *stamp;                     ///< State of the keyring when it was listed
+  time_t built;                    ///< When the keyring was listed
+  struct Buffer *text;             ///< Output of the list command
+  struct KeyringGroupArray groups; ///< Key groups in the listing
+  struct HashTable *by_id;         ///< Key id or fingerprint -> group index
+  struct HashTable *by_addr;       ///< User id's email address -> group index
+};
+
+/// Cached keyrings, indexed by #PgpRing
+static struct PgpKeyring *Keyrings[2] = { 0 };
+
+/**
+ * pgp_keyring_free - Free a cached keyring
+ * @param[out] ptr Keyring to free
+ */
+void pgp_keyring_free(struct PgpKeyring **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct PgpKeyring *kr = *ptr;
+
+  struct KeyringGroup *grp = NULL;
+  ARRAY_FOREACH(grp, &kr->groups)
+  {
+    pgp_key_free(&grp->keys);
+  }
+  ARRAY_FREE(&kr->groups);
+
+  mutt_hash_free(&kr->by_id);
+  mutt_hash_free(&kr->by_addr);
+  buf_free(&kr->text);
+  FREE(&kr->stamp);
+  FREE(ptr);
+}
+
+/**
+ * keyring_path - Get the path of a keyring's cache file
+ * @param[in]  keyring Keyring type, e.g. #PGP_SECRING
+ * @param[out] path    Buffer for the path
+ * @retval true  The keyring should be saved
+ * @retval false $pgp_keyring_cache_file isn't set
+ */
+static bool keyring_path(enum PgpRing keyring, struct Buffer *path)
+{
+  const char *const c_pgp_keyring_cache_file = cs_subset_path(NeoMutt->sub, "pgp_keyring_cache_file");
+  if (!c_pgp_keyring_cache_file)
+    return false;
+
+  buf_printf(path, "%s.%s", c_pgp_keyring_cache_file,
+             (keyring == PGP_SECRING) ? "sec" : "pub");
+  return true;
+}
+
+/**
+ * keyring_stamp - Describe the current state of a keyring
+ * @param[in]  keyring Keyring type, e.g. #PGP_SECRING
+ * @param[out] stamp   Buffer for the description
+ * @retval true  Success
+ * @retval false No keyring files were found
+ */
+static bool keyring_stamp(enum PgpRing keyring, struct Buffer *stamp)
+{
+  // GnuPG 2.4's keyboxd keeps the keys in an SQLite database, whose changes
+  // may sit in the write-ahead log until it's checkpointed
+  static const char *const Files[] = {
+    "pubring.kbx", "pubring.gpg", "public-keys.d/pubring.db",
+    "public-keys.d/pubring.db-wal", "trustdb.gpg", "private-keys-v1.d", "secring.gpg",
+  };
+  // The secret keyring needs all the files, the public keyring the first five
+  const size_t num_files = (keyring == PGP_SECRING) ? mutt_array_size(Files) : 5;
+
+  struct Buffer *dir = buf_pool_get();
+  struct Buffer *file = buf_pool_get();
+  bool found = false;
+
+  const char *home = mutt_str_getenv("GNUPGHOME");
+  if (home)
+    buf_strcpy(dir, home);
+  else
+    buf_concat_path(dir, NeoMutt->home_dir, ".gnupg");
+
+  buf_reset(stamp);
+  for (size_t i = 0; i < num_files; i++)
+  {
+    struct stat st = { 0 };
+    buf_concat_path(file, buf_string(dir), Files[i]);
+    if (stat(buf_string(file), &st) != 0)
+      continue;
+
+    buf_add_printf(stamp, "%s:%lld:%lld ", Files[i], (long long) st.st_mtime,
+                   (long long) st.st_size);
+    found = true;
+  }
+
+  const struct Expando *c_cmd = cs_subset_expando(NeoMutt->sub, (keyring == PGP_SECRING) ?
+                                                                    "pgp_list_secring_command" :
+                                                                    "pgp_list_pubring_command");
+  const bool c_pgp_ignore_subkeys = cs_subset_bool(NeoMutt->sub, "pgp_ignore_subkeys");
+  buf_add_printf(stamp, "%s %d %s", NONULL(cc_charset()), c_pgp_ignore_subkeys,
+                 c_cmd ? NONULL(c_cmd->string) : "");
+
+  // The stamp must fit on one line of the cache file
+  for (char *p = stamp->data; p && *p; p++)
+  {
+    if ((*p == '\n') || (*p == '\r'))
+      *p = ' ';
+  }
+
+  buf_pool_release(&dir);
+  buf_pool_release(&file);
+  return found && c_cmd;
+}
+
+/**
+ * raw_field - Get a field from a line of the listing
+ * @param line  Line of the listing
+ * @param end   End of the line
+ * @param field Field number, counting from 1
+ * @param buf   Buffer for the field
+ */
+static void raw_field(const char *line, const char *end, int field, struct Buffer *buf)
+{
+  buf_reset(buf);
+  for (int i = 1; i < field; i++)
+  {
+    line = memchr(line, ':', end - line);
+    if (!line)
+      return;
+    line++;
+  }
+
+  const char *colon = memchr(line, ':', end - line);
+  buf_addstr_n(buf, line, (colon ? colon : end) - line);
+}
+
+/**
+ * index_ids - Index the key ids and fingerprints of a key group
+ * @param kr  Keyring
+ * @param idx Index of the group
+ *
+ * The raw listing is used, because the subkeys may have been merged into the
+ * principal key, see $pgp_ignore_subkeys.
+ */
+static void index_ids(struct PgpKeyring *kr, size_t idx)
+{
+  struct KeyringGroup *grp = ARRAY_GET(&kr->groups, idx);
+  struct Buffer *id = buf_pool_get();
+  void *data = (void *) (intptr_t) idx;
+
+  const char *line = buf_string(kr->text) + grp->offset;
+  const char *end = line + grp->len;
+  while (line < end)
+  {
+    const char *nl = memchr(line, '\n', end - line);
+    const char *eol = nl ? nl : end;
+
+    if (mutt_strn_equal(line, "fpr:", 4))
+    {
+      raw_field(line, eol, 10, id);
+      if (!buf_is_empty(id))
+        mutt_hash_insert(kr->by_id, buf_string(id), data);
+    }
+    else if (mutt_strn_equal(line, "pub:", 4) || mutt_strn_equal(line, "sub:", 4) ||
+             mutt_strn_equal(line, "sec:", 4) || mutt_strn_equal(line, "ssb:", 4))
+    {
+      raw_field(line, eol, 5, id);
+      if (!buf_is_empty(id))
+      {
+        mutt_hash_insert(kr->by_id, buf_string(id), data);
+        if (buf_len(id) > 8)
+          mutt_hash_insert(kr->by_id, buf_string(id) + buf_len(id) - 8, data);
+      }
+    }
+
+    line = eol + 1;
+  }
+
+  buf_pool_release(&id);
+}
+
+/**
+ * index_addrs - Index the email addresses of a key group
+ * @param kr  Keyring
+ * @param idx Index of the group
+ */
+static void index_addrs(struct PgpKeyring *kr, size_t idx)
+{
+  struct KeyringGroup *grp = ARRAY_GET(&kr->groups, idx);
+  if (!grp->keys)
+    return;
+
+  struct Buffer *addr = buf_pool_get();
+  void *data = (void *) (intptr_t) idx;
+
+  for (struct PgpUid *uid = grp->keys->address; uid; uid = uid->next)
+  {
+    // "Name (Comment) <user@example.com>" or "user@example.com"
+    const char *start = strrchr(NONULL(uid->addr), '<');
+    const char *end = start ? strchr(start, '>') : NULL;
+    buf_reset(addr);
+    if (start && end)
+      buf_addstr_n(addr, start + 1, end - start - 1);
+    else if (uid->addr && strchr(uid->addr, '@') && !strchr(uid->addr, ' '))
+      buf_strcpy(addr, uid->addr);
+
+    if (!buf_is_empty(addr))
+      mutt_hash_insert(kr->by_addr, buf_string(addr), data);
+  }
+
+  buf_pool_release(&addr);
+}
+
+/**
+ * keyring_index - Split a keyring listing into key groups and index them
+ * @param kr Keyring, with a listing
+ */
+static void keyring_index(struct PgpKeyring *kr)
+{
+  const char *text = buf_string(kr->text);
+  const size_t len = buf_len(kr->text);
+
+  // A group starts with a "pub" or "sec" line and runs until the next one
+  struct KeyringGroup *grp = NULL;
+  for (size_t off = 0; off < len;)
+  {
+    const char *nl = memchr(text + off, '\n', len - off);
+    const size_t next = nl ? (nl - text + 1) : len;
+
+    if (mutt_strn_equal(text + off, "pub:", 4) || mutt_strn_equal(text + off, "sec:", 4))
+    {
+      struct KeyringGroup new_grp = { .offset = off };
+      ARRAY_ADD(&kr->groups, new_grp);
+      grp = ARRAY_LAST(&kr->groups);
+    }
+
+    if (grp)
+      grp->len = next - grp->offset;
+
+    off = next;
+  }
+
+  const size_t num = ARRAY_SIZE(&kr->groups);
+  const HashFlags flags = MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS | MUTT_HASH_ALLOW_DUPS;
+  kr->by_id = mutt_hash_new(MAX(num * 4, 16), flags);
+  kr->by_addr = mutt_hash_new(MAX(num * 2, 16), flags);
+
+  for (size_t i = 0; i < num; i++)
+  {
+    grp = ARRAY_GET(&kr->groups, i);
+    grp->keys = pgp_parse_keys(text + grp->offset, grp->len);
+    index_ids(kr, i);
+    index_addrs(kr, i);
+  }
+
+  mutt_debug(LL_DEBUG1, "indexed %zu keys\n", num);
+}
+
+/**
+ * pgp_keyring_new - Create a keyring from a listing
+ * @param text Output of $pgp_list_pubring_command or $pgp_list_secring_command
+ * @param len  Length of the text
+ * @retval ptr New, indexed, Keyring
+ */
+struct PgpKeyring *pgp_keyring_new(const char *text, size_t len)
+{
+  struct PgpKeyring *kr = MUTT_MEM_CALLOC(1, struct PgpKeyring);
+  kr->text = buf_new(NULL);
+  ARRAY_INIT(&kr->groups);
+
+  buf_addstr_n(kr->text, text, len);
+  keyring_index(kr);
+  return kr;
+}
+
+/**
+ * keyring_list - List a keyring by running the list command
+ * @param keyring Keyring type, e.g. #PGP_SECRING
+ * @param text    Buffer for the listing
+ * @retval true Success
+ */
+static bool keyring_list(enum PgpRing keyring, struct Buffer *text)
+{
+  struct ListHead hints = STAILQ_HEAD_INITIALIZER(hints);
+  FILE *fp = NULL;
+
+  int fd_null = open("/dev/null", O_RDWR);
+  if (fd_null == -1)
+    return false;
+
+  pid_t pid = pgp_invoke_list_keys(NULL, &fp, NULL, -1, -1, fd_null, keyring, &hints);
+  if (pid == -1)
+  {
+    close(fd_null);
+    return false;
+  }
+
+  char chunk[8192];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    buf_addstr_n(text, chunk, n);
+
+  const bool ok = !ferror(fp);
+  mutt_file_fclose(&fp);
+  const int rc = filter_wait(pid);
+  close(fd_null);
+
+  return ok && (rc == 0);
+}
+
+/**
+ * keyring_load - Load a keyring listing from its cache file
+ * @param keyring Keyring type, e.g. #PGP_SECRING
+ * @param stamp   Expected stamp
+ * @param now     Current time
+ * @retval ptr  Keyring, not yet indexed
+ * @retval NULL No usable cache file
+ */
+static struct PgpKeyring *keyring_load(enum PgpRing keyring, const char *stamp, time_t now)
+{
+  struct Buffer *path = buf_pool_get();
+  struct PgpKeyring *kr = NULL;
+  FILE *fp = NULL;
+  char *line = NULL;
+  size_t size = 0;
+
+  if (!keyring_path(keyring, path))
+    goto done;
+
+  fp = mutt_file_fopen(buf_string(path), "r");
+  if (!fp)
+    goto done;
+
+  line = mutt_file_read_line(NULL, &size, fp, NULL, MUTT_RL_NO_FLAGS);
+  const size_t hlen = mutt_str_len(KeyringCacheHeader);
+  if (!line || !mutt_strn_equal(line, KeyringCacheHeader, hlen))
+    goto done;
+
+  char *end = NULL;
+  const time_t built = strtoll(line + hlen, &end, 10);
+  if ((*end != '\t') || !mutt_str_equal(end + 1, stamp) || (built > now) ||
+      ((now - built) > PGP_KEYRING_MAX_AGE))
+  {
+    goto done;
+  }
+
+  kr = MUTT_MEM_CALLOC(1, struct PgpKeyring);
+  kr->text = buf_new(NULL);
+  kr->built = built;
+  ARRAY_INIT(&kr->groups);
+
+  char chunk[8192];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    buf_addstr_n(kr->text, chunk, n);
+
+  if (ferror(fp))
+    pgp_keyring_free(&kr);
+
+done:
+  FREE(&line);
+  mutt_file_fclose(&fp);
+  buf_pool_release(&path);
+  return kr;
+}
+
+/**
+ * keyring_save - Save a keyring listing to its cache file
+ * @param keyring Keyring type, e.g. #PGP_SECRING
+ * @param kr      Keyring
+ */
+static void keyring_save(enum PgpRing keyring, struct PgpKeyring *kr)
+{
+  struct Buffer *path = buf_pool_get();
+  struct Buffer *tmp = buf_pool_get();
+
+  if (!keyring_path(keyring, path))
+    goto done;
+
+  // Write a temporary file, then rename it, so readers never see half a file.
+  // mkstemp() creates a new file, readable only by the user.
+  buf_printf(tmp, "%s.XXXXXX", buf_string(path));
+  int fd = mkstemp(tmp->data);
+  if (fd == -1)
+  {
+    mutt_debug(LL_DEBUG1, "Can't create %s\n", buf_string(tmp));
+    goto done;
+  }
+
+  FILE *fp = fdopen(fd, "w");
+  if (!fp)
+  {
+    close(fd);
+    unlink(buf_string(tmp));
+    goto done;
+  }
+
+  fprintf(fp, "%s%lld\t%s\n", KeyringCacheHeader, (long long) kr->built, kr->stamp);
+  fwrite(buf_string(kr->text), 1, buf_len(kr->text), fp);
+
+  if ((mutt_file_fclose(&fp) != 0) || (rename(buf_string(tmp), buf_string(path)) != 0))
+  {
+    mutt_debug(LL_DEBUG1, "Can't save the keyring to %s\n", buf_string(path));
+    unlink(buf_string(tmp));
+  }
+
+done:
+  buf_pool_release(&path);
+  buf_pool_release(&tmp);
+}
+
+/**
+ * keyring_get - Get an up-to-date cached keyring
+ * @param keyring Keyring type, e.g. #PGP_SECRING
+ * @retval ptr  Keyring
+ * @retval NULL The keyring can't be cached
+ */
+static struct PgpKeyring *keyring_get(enum PgpRing keyring)
+{
+  struct Buffer *stamp = buf_pool_get();
+  struct PgpKeyring **kp = &Keyrings[keyring];
+  const time_t now = mutt_date_now();
+
+  if (!keyring_stamp(keyring, stamp))
+  {
+    pgp_keyring_free(kp);
+    goto done;
+  }
+
+  if (*kp && mutt_str_equal((*kp)->stamp, buf_string(stamp)) &&
+      ((*kp)->built <= now) && ((now - (*kp)->built) <= PGP_KEYRING_MAX_AGE))
+  {
+    goto done;
+  }
+
+  pgp_keyring_free(kp);
+
+  struct PgpKeyring *kr = keyring_load(keyring, buf_string(stamp), now);
+  if (!kr)
+  {
+    kr = MUTT_MEM_CALLOC(1, struct PgpKeyring);
+    kr->text = buf_new(NULL);
+    kr->built = now;
+    kr->stamp = buf_strdup(stamp);
+    ARRAY_INIT(&kr->groups);
+
+    if (!keyring_list(keyring, kr->text))
+    {
+      pgp_keyring_free(&kr);
+      goto done;
+    }
+    keyring_save(keyring, kr);
+  }
+  else
+  {
+    kr->stamp = buf_strdup(stamp);
+  }
+
+  keyring_index(kr);
+  *kp = kr;
+
+done:
+  buf_pool_release(&stamp);
+  return *kp;
+}
+
+/**
+ * is_key_id - Does a hint look like a key id or fingerprint?
+ * @param hint Hint, without any "0x" prefix
+ * @retval true It's 8, 16, 32 or 40 hex digits
+ */
+static bool is_key_id(const char *hint)
+{
+  const size_t len = mutt_str_len(hint);
+  if ((len != 8) && (len != 16) && (len != 32) && (len != 40))
+    return false;
+
+  for (size_t i = 0; i < len; i++)
+    if (!isxdigit((unsigned char) hint[i]))
+      return false;
+
+  return true;
+}
+
+/**
+ * select_hash - Select the key groups matching a hint in an index
+ * @param table    Index to search
+ * @param hint     Hint to look up
+ * @param selected Array of selected groups
+ * @retval true At least one group was found
+ */
+static bool select_hash(struct HashTable *table, const char *hint, bool *selected)
+{
+  bool found = false;
+
+  for (struct HashElem *he = mutt_hash_find_bucket(table, hint); he; he = he->next)
+  {
+    if (!mutt_istr_equal(he->key.strkey, hint))
+      continue;
+
+    selected[(intptr_t) he->data] = true;
+    found = true;
+  }
+
+  return found;
+}
+
+/**
+ * keyring_select - Find the key groups matching some hints
+ * @param kr       Keyring
+ * @param hints    List of strings to match, may be empty
+ * @param selected Array of selected groups
+ *
+ * Like gpg, a group matches if any hint does.  An empty list matches
+ * everything.
+ */
+static void keyring_select(struct PgpKeyring *kr, struct ListHead *hints, bool *selected)
+{
+  const size_t num = ARRAY_SIZE(&kr->groups);
+
+  if (STAILQ_EMPTY(hints))
+  {
+    for (size_t i = 0; i < num; i++)
+      selected[i] = true;
+    return;
+  }
+
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, hints, entries)
+  {
+    const char *hint = np->data;
+    if (!hint)
+      continue;
+
+    const char *id = mutt_istrn_equal(hint, "0x", 2) ? hint + 2 : hint;
+    if (is_key_id(id))
+    {
+      select_hash(kr->by_id, id, selected);
+      continue;
+    }
+
+    if (strchr(hint, '@') && select_hash(kr->by_addr, hint, selected))
+      continue;
+
+    for (size_t i = 0; i < num; i++)
+    {
+      if (selected[i])
+        continue;
+
+      struct KeyringGroup *grp = ARRAY_GET(&kr->groups, i);
+      for (struct PgpUid *uid = grp->keys ? grp->keys->address : NULL; uid; uid = uid->next)
+      {
+        if (mutt_istr_find(uid->addr, hint))
+        {
+          selected[i] = true;
+          break;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * pgp_keyring_select - Find the keys in a keyring matching a list of hints
+ * @param kr    Keyring
+ * @param hints List of strings to match, may be empty
+ * @retval ptr  Matching keys
+ * @retval NULL No keys match
+ *
+ * The keys are new copies and must be freed with pgp_key_free().
+ */
+struct PgpKeyInfo *pgp_keyring_select(struct PgpKeyring *kr, struct ListHead *hints)
+{
+  const size_t num = ARRAY_SIZE(&kr->groups);
+  bool *selected = MUTT_MEM_CALLOC(MAX(num, 1), bool);
+  keyring_select(kr, hints, selected);
+
+  // Reparse the matching groups, to give the caller its own copies
+  struct Buffer *text = buf_pool_get();
+  for (size_t i = 0; i < num; i++)
+  {
+    if (!selected[i])
+      continue;
+
+    struct KeyringGroup *grp = ARRAY_GET(&kr->groups, i);
+    buf_addstr_n(text, buf_string(kr->text) + grp->offset, grp->len);
+  }
+
+  struct PgpKeyInfo *keys = pgp_parse_keys(buf_string(text), buf_len(text));
+
+  buf_pool_release(&text);
+  FREE(&selected);
+  return keys;
+}
+
+/**
+ * pgp_keyring_candidates - Find PGP keys matching a list of hints, using the cache
+ * @param[in]  keyring Keyring type, e.g. #PGP_SECRING
+ * @param[in]  hints   List of strings to match
+ * @param[out] keys    Matching keys, may be NULL
+ * @retval true  The cache was used, keys has been set
+ * @retval false The cache isn't in use, use pgp_get_candidates()
+ *
+ * The keys are new copies and must be freed with pgp_key_free().
+ */
+bool pgp_keyring_candidates(enum PgpRing keyring, struct ListHead *hints,
+                            struct PgpKeyInfo **keys)
+{
+  const bool c_pgp_keyring_cache = cs_subset_bool(NeoMutt->sub, "pgp_keyring_cache");
+  if (!c_pgp_keyring_cache)
+    return false;
+
+  struct PgpKeyring *kr = keyring_get(keyring);
+  if (!kr)
+    return false;
+
+  *keys = pgp_keyring_select(kr, hints);
+  return true;
+}
+
+/**
+ * pgp_keyring_reset - Forget the cached keyrings
+ *
+ * This should be called after changing the keyring, e.g. importing a key.
+ */
+void pgp_keyring_reset(void)
+{
+  struct Buffer *path = buf_pool_get();
+
+  for (enum PgpRing i = PGP_PUBRING; i <= PGP_SECRING; i++)
+  {
+    pgp_keyring_free(&Keyrings[i]);
+    if (keyring_path(i, path))
+      unlink(buf_string(path));
+  }
+
+  buf_pool_release(&path);
+}
+
+/**
+ * pgp_keyring_cleanup - Free the cached keyrings - Implements CryptModuleSpecs::cleanup() - @ingroup crypto_cleanup
+ */
+void pgp_keyring_cleanup(void)
+{
+  pgp_keyring_free(&Keyrings[PGP_PUBRING]);
+  pgp_keyring_free(&Keyrings[PGP_SECRING]);
+}
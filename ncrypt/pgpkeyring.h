@@ -0,0 +1,42 @@
+/**
+ * @file
+ * Cache of the parsed PGP keyrings
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_NCRYPT_PGPKEYRING_H
+#define MUTT_NCRYPT_PGPKEYRING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "pgpkey.h"
+
+struct ListHead;
+struct PgpKeyInfo;
+struct PgpKeyring;
+
+bool                pgp_keyring_candidates(enum PgpRing keyring, struct ListHead *hints, struct PgpKeyInfo **keys);
+void                pgp_keyring_cleanup   (void);
+void                pgp_keyring_reset     (void);
+
+void                pgp_keyring_free      (struct PgpKeyring **ptr);
+struct PgpKeyring * pgp_keyring_new       (const char *text, size_t len);
+struct PgpKeyInfo * pgp_keyring_select    (struct PgpKeyring *kr, struct ListHead *hints);
+
+#endif /* MUTT_NCRYPT_PGPKEYRING_H */
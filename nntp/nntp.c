@@ -820,9 +820,7 @@ static int nntp_fetch_lines(struct NntpMboxData *mdata, char *query, size_t qlen
   while (!done)
   {
     char buf[1024] = { 0 };
-    char *line = NULL;
     unsigned int lines = 0;
-    size_t off = 0;
     struct Progress *progress = NULL;
 
     mutt_str_copy(buf, query, sizeof(buf));
@@ -834,7 +832,7 @@ static int nntp_fetch_lines(struct NntpMboxData *mdata, char *query, size_t qlen
       return 1;
     }
 
-    line = MUTT_MEM_MALLOC(sizeof(buf), char);
+    struct Buffer *line = buf_pool_get();
     rc = 0;
 
     if (msg)
@@ -845,44 +843,30 @@ static int nntp_fetch_lines(struct NntpMboxData *mdata, char *query, size_t qlen
 
     while (true)
     {
-      char *p = NULL;
-      int chunk = mutt_socket_readln_d(buf, sizeof(buf), mdata->adata->conn, MUTT_SOCK_LOG_FULL);
-      if (chunk < 0)
+      if (mutt_socket_buffer_readln_d(line, mdata->adata->conn, MUTT_SOCK_LOG_FULL) < 0)
       {
         mdata->adata->status = NNTP_NONE;
         break;
       }
 
-      p = buf;
-      if (!off && (buf[0] == '.'))
+      char *p = line->data;
+      if (p[0] == '.')
       {
-        if (buf[1] == '\0')
+        if (p[1] == '\0')
         {
           done = true;
           break;
         }
-        if (buf[1] == '.')
+        if (p[1] == '.')
           p++;
       }
 
-      mutt_str_copy(line + off, p, sizeof(buf));
+      progress_update(progress, ++lines, -1);
 
-      if (chunk >= sizeof(buf))
-      {
-        off += strlen(p);
-      }
-      else
-      {
-        progress_update(progress, ++lines, -1);
-
-        if ((rc == 0) && (func(line, data) < 0))
-          rc = -2;
-        off = 0;
-      }
-
-      MUTT_MEM_REALLOC(&line, off + sizeof(buf), char);
+      if ((rc == 0) && (func(p, data) < 0))
+        rc = -2;
     }
-    FREE(&line);
+    buf_pool_release(&line);
     func(NULL, data);
     progress_free(&progress);
   }
@@ -1228,6 +1212,10 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
     return -1;
   fc.hc = hc;
 
+#ifdef USE_HCACHE
+  hcache_begin_batch(fc.hc);
+#endif
+
   /* fetch list of articles */
   const bool c_nntp_listgroup = cs_subset_bool(NeoMutt->sub, "nntp_listgroup");
   if (c_nntp_listgroup && mdata->adata->hasLISTGROUP && !mdata->deleted)
@@ -1422,6 +1410,10 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
     }
   }
 
+#ifdef USE_HCACHE
+  hcache_commit_batch(fc.hc);
+#endif
+
   FREE(&fc.messages);
   progress_free(&fc.progress);
   if (rc != 0)
@@ -2728,7 +2720,10 @@ static bool nntp_msg_open(struct Mailbox *m, struct Message *msg, struct Email *
     }
 
     if (!acache->path)
+    {
+      fflush(msg->fp);
       mutt_bcache_commit(mdata->bcache, article);
+    }
   }
 
   /* replace envelope with new one
@@ -25,6 +25,7 @@
 
 #include <notmuch.h>
 #include <stdbool.h>
+#include <time.h>
 
 struct Mailbox;
 
@@ -36,6 +37,8 @@ struct NmAccountData
   notmuch_database_t *db; ///< Connection to Notmuch database
   bool longrun : 1;       ///< A long-lived action is in progress
   bool trans : 1;         ///< Atomic transaction in progress
+  bool writable : 1;      ///< Database was opened read/write
+  struct timespec mtime;  ///< Time the database last changed, when it was opened
 };
 
 void                  nm_adata_free(void **ptr);
@@ -122,6 +122,9 @@ static struct ConfigDef NotmuchVars[] = {
   { "nm_flagged_tag", DT_STRING, IP "flagged", 0, NULL,
     "(notmuch) Tag to use for flagged messages"
   },
+  { "nm_open_batch", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 0, 0, NULL,
+    "(notmuch) Number of messages to read at a time when opening a mailbox"
+  },
   { "nm_open_timeout", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 5, 0, NULL,
     "(notmuch) Database timeout"
   },
@@ -200,11 +200,60 @@ notmuch_database_t *nm_db_do_open(const char *filename, bool writable, bool verb
   return db;
 }
 
+/**
+ * db_stat - Find the Xapian directory of the Notmuch database
+ * @param[in]  m  Mailbox
+ * @param[out] st Save the stat of the directory
+ * @retval  0 Success
+ * @retval -1 Error
+ */
+static int db_stat(struct Mailbox *m, struct stat *st)
+{
+  char path[PATH_MAX] = { 0 };
+  const char *db_filename = nm_db_get_filename(m);
+
+  mutt_debug(LL_DEBUG2, "nm: checking database mtime '%s'\n", db_filename);
+
+  // See if the path we were given has a Xapian directory.
+  // After notmuch 0.32, a .notmuch folder isn't guaranteed.
+  snprintf(path, sizeof(path), "%s/xapian", db_filename);
+  if (stat(path, st) == 0)
+    return 0;
+
+  // Otherwise, check for a .notmuch directory.
+  snprintf(path, sizeof(path), "%s/.notmuch/xapian", db_filename);
+  if (stat(path, st) == 0)
+    return 0;
+
+  return -1;
+}
+
+/**
+ * db_is_current - Is the open database up to date?
+ * @param m     Mailbox
+ * @param adata Notmuch Account data
+ * @retval true The database hasn't changed since it was opened
+ *
+ * Every commit to the database rewrites files in its Xapian directory, so the
+ * directory's mtime acts as the database's revision, without having to open it.
+ */
+static bool db_is_current(struct Mailbox *m, struct NmAccountData *adata)
+{
+  struct stat st = { 0 };
+  if (db_stat(m, &st) != 0)
+    return false;
+
+  return mutt_file_stat_timespec_compare(&st, MUTT_STAT_MTIME, &adata->mtime) == 0;
+}
+
 /**
  * nm_db_get - Get the Notmuch database
  * @param m        Mailbox
  * @param writable Read/write?
  * @retval ptr Notmuch database
+ *
+ * A read-only database is kept open between calls, see nm_db_release().
+ * It's reopened if the database has changed since, or if write access is needed.
  */
 notmuch_database_t *nm_db_get(struct Mailbox *m, bool writable)
 {
@@ -215,12 +264,30 @@ notmuch_database_t *nm_db_get(struct Mailbox *m, bool writable)
 
   // Use an existing open db if we have one.
   if (adata->db)
-    return adata->db;
+  {
+    if (adata->writable || adata->longrun || adata->trans)
+      return adata->db;
+
+    if (!writable && db_is_current(m, adata))
+      return adata->db;
+
+    mutt_debug(LL_DEBUG1, "nm: db reopen %s\n", writable ? "[WRITE]" : "[CHANGED]");
+    nm_db_free(adata->db);
+    adata->db = NULL;
+  }
+
+  // Note the mtime before opening, so a concurrent change causes a reopen
+  struct stat st = { 0 };
+  if (db_stat(m, &st) == 0)
+    mutt_file_get_stat_timespec(&adata->mtime, &st, MUTT_STAT_MTIME);
+  else
+    adata->mtime = (struct timespec) { 0 };
 
   const char *db_filename = nm_db_get_filename(m);
   if (db_filename)
     adata->db = nm_db_do_open(db_filename, writable, true);
 
+  adata->writable = writable;
   return adata->db;
 }
 
@@ -229,6 +296,9 @@ notmuch_database_t *nm_db_get(struct Mailbox *m, bool writable)
  * @param m Mailbox
  * @retval  0 Success
  * @retval -1 Failure
+ *
+ * A writable database is closed, to release its lock.
+ * A read-only database is kept open for the next nm_db_get().
  */
 int nm_db_release(struct Mailbox *m)
 {
@@ -236,6 +306,9 @@ int nm_db_release(struct Mailbox *m)
   if (!adata || !adata->db || nm_db_is_longrun(m))
     return -1;
 
+  if (!adata->writable)
+    return 0;
+
   mutt_debug(LL_DEBUG1, "nm: db close\n");
   nm_db_free(adata->db);
   adata->db = NULL;
@@ -318,24 +391,7 @@ int nm_db_get_mtime(struct Mailbox *m, time_t *mtime)
     return -1;
 
   struct stat st = { 0 };
-  char path[PATH_MAX] = { 0 };
-  const char *db_filename = nm_db_get_filename(m);
-
-  mutt_debug(LL_DEBUG2, "nm: checking database mtime '%s'\n", db_filename);
-
-  // See if the path we were given has a Xapian directory.
-  // After notmuch 0.32, a .notmuch folder isn't guaranteed.
-  snprintf(path, sizeof(path), "%s/xapian", db_filename);
-  if (stat(path, &st) == 0)
-  {
-    *mtime = st.st_mtime;
-    return 0;
-  }
-
-  // Otherwise, check for a .notmuch directory.
-  snprintf(path, sizeof(path), "%s/.notmuch/xapian", db_filename);
-
-  if (stat(path, &st) != 0)
+  if (db_stat(m, &st) != 0)
     return -1;
 
   *mtime = st.st_mtime;
@@ -391,13 +447,15 @@ void nm_db_longrun_done(struct Mailbox *m)
 }
 
 /**
- * nm_db_debug_check - Check if the database is open
+ * nm_db_debug_check - Check if the database is open for writing
  * @param m Mailbox
+ *
+ * @note A read-only database is expected to stay open
  */
 void nm_db_debug_check(struct Mailbox *m)
 {
   struct NmAccountData *adata = nm_adata_get(m);
-  if (!adata || !adata->db)
+  if (!adata || !adata->db || !adata->writable)
     return;
 
   mutt_debug(LL_DEBUG1, "nm: ERROR: db is open, closing\n");
@@ -27,6 +27,8 @@
  */
 
 #include "config.h"
+#include <notmuch.h>
+#include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
@@ -51,12 +53,35 @@ void nm_mdata_free(void **ptr)
 
   mutt_debug(LL_DEBUG1, "nm: freeing context data %p\n", (void *) mdata);
 
+  nm_mdata_stream_close(mdata);
   url_free(&mdata->db_url);
   FREE(&mdata->db_query);
   progress_free(&mdata->progress);
   FREE(ptr);
 }
 
+/**
+ * nm_mdata_stream_close - Stop reading the results of a streaming open
+ * @param mdata Notmuch Mailbox data
+ *
+ * The query's results belong to the query, and the query to the database, so
+ * closing the stream's database frees them all.
+ */
+void nm_mdata_stream_close(struct NmMboxData *mdata)
+{
+  if (!mdata || !mdata->stream_db)
+    return;
+
+  mutt_debug(LL_DEBUG1, "nm: stream close\n");
+  if (mdata->stream_query)
+    notmuch_query_destroy(mdata->stream_query);
+  nm_db_free(mdata->stream_db);
+  mdata->stream_db = NULL;
+  mdata->stream_query = NULL;
+  mdata->stream_msgs = NULL;
+  mdata->stream_threads = NULL;
+}
+
 /**
  * nm_mdata_new - Create a new NmMboxData object from a query
  * @param url Notmuch query string
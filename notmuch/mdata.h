@@ -23,6 +23,7 @@
 #ifndef MUTT_NOTMUCH_MDATA_H
 #define MUTT_NOTMUCH_MDATA_H
 
+#include <notmuch.h>
 #include <time.h>
 #include "query.h"
 
@@ -42,9 +43,15 @@ struct NmMboxData
   int oldmsgcount;
   int ignmsgcount;             ///< Ignored messages
   struct timespec mtime;       ///< Time Mailbox was last changed
+
+  notmuch_database_t *stream_db;       ///< Read-only database for a streaming open, see $nm_open_batch
+  notmuch_query_t *stream_query;       ///< Query being streamed
+  notmuch_messages_t *stream_msgs;     ///< Next messages to read (Messages query)
+  notmuch_threads_t *stream_threads;   ///< Next threads to read (Threads query)
 };
 
 void                  nm_mdata_free(void **ptr);
+void                  nm_mdata_stream_close(struct NmMboxData *mdata);
 struct NmMboxData *   nm_mdata_get (struct Mailbox *m);
 struct NmMboxData *   nm_mdata_new (const char *url);
 
@@ -87,6 +87,9 @@
 
 struct stat;
 
+/// Time to spend reading the results of a query, each time the user is idle
+#define NM_STREAM_SLICE_MS 200
+
 /**
  * NmCommands - Notmuch Commands
  */
@@ -440,6 +443,29 @@ static void apply_exclude_tags(notmuch_query_t *query)
   nm_tag_array_free(&tags);
 }
 
+/**
+ * query_new - Create a new query on a database
+ * @param db    Notmuch database
+ * @param mdata Notmuch Mailbox data
+ * @retval ptr  Notmuch query
+ * @retval NULL Error
+ */
+static notmuch_query_t *query_new(notmuch_database_t *db, struct NmMboxData *mdata)
+{
+  const char *str = get_query_string(mdata, true);
+  if (!db || !str)
+    return NULL;
+
+  notmuch_query_t *q = notmuch_query_create(db, str);
+  if (!q)
+    return NULL;
+
+  apply_exclude_tags(q);
+  notmuch_query_set_sort(q, NOTMUCH_SORT_NEWEST_FIRST);
+  mutt_debug(LL_DEBUG2, "nm: query successfully initialized (%s)\n", str);
+  return q;
+}
+
 /**
  * get_query - Create a new query
  * @param m        Mailbox
@@ -454,22 +480,11 @@ static notmuch_query_t *get_query(struct Mailbox *m, bool writable)
     return NULL;
 
   notmuch_database_t *db = nm_db_get(m, writable);
-  const char *str = get_query_string(mdata, true);
-
-  if (!db || !str)
-    goto err;
-
-  notmuch_query_t *q = notmuch_query_create(db, str);
+  notmuch_query_t *q = query_new(db, mdata);
   if (!q)
-    goto err;
+    nm_db_release(m);
 
-  apply_exclude_tags(q);
-  notmuch_query_set_sort(q, NOTMUCH_SORT_NEWEST_FIRST);
-  mutt_debug(LL_DEBUG2, "nm: query successfully initialized (%s)\n", str);
   return q;
-err:
-  nm_db_release(m);
-  return NULL;
 }
 
 /**
@@ -952,36 +967,39 @@ static notmuch_messages_t *get_messages(notmuch_query_t *query)
 }
 
 /**
- * read_mesgs_query - Search for matching messages
+ * read_mesgs - Read the messages from the results of a query
  * @param m     Mailbox
- * @param q     Notmuch query
+ * @param msgs  Notmuch messages
  * @param dedup De-duplicate the results
- * @retval true  Success
- * @retval false Failure
+ * @param batch Maximum number of messages to read, 0 for all of them
+ * @retval  1 More messages are waiting to be read
+ * @retval  0 All the messages have been read
+ * @retval -1 Interrupted by the user
  */
-static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
+static int read_mesgs(struct Mailbox *m, notmuch_messages_t *msgs, bool dedup, int batch)
 {
   struct NmMboxData *mdata = nm_mdata_get(m);
   if (!mdata)
-    return false;
+    return -1;
 
   int limit = get_limit(mdata);
-
-  notmuch_messages_t *msgs = get_messages(q);
-
-  if (!msgs)
-    return false;
+  int rc = 0;
 
   struct HeaderCache *hc = nm_hcache_open(m);
 
-  for (; notmuch_messages_valid(msgs) && ((limit == 0) || (m->msg_count < limit));
-       notmuch_messages_move_to_next(msgs))
+  for (int i = 0; notmuch_messages_valid(msgs) && ((limit == 0) || (m->msg_count < limit));
+       notmuch_messages_move_to_next(msgs), i++)
   {
+    if ((batch > 0) && (i >= batch))
+    {
+      rc = 1;
+      break;
+    }
     if (SigInt)
     {
-      nm_hcache_close(&hc);
       SigInt = false;
-      return false;
+      rc = -1;
+      break;
     }
     notmuch_message_t *nm = notmuch_messages_get(msgs);
     append_message(hc, m, nm, dedup);
@@ -989,7 +1007,24 @@ static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
   }
 
   nm_hcache_close(&hc);
-  return true;
+  return rc;
+}
+
+/**
+ * read_mesgs_query - Search for matching messages
+ * @param m     Mailbox
+ * @param q     Notmuch query
+ * @param dedup De-duplicate the results
+ * @retval true  Success
+ * @retval false Failure
+ */
+static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
+{
+  notmuch_messages_t *msgs = get_messages(q);
+  if (!msgs)
+    return false;
+
+  return read_mesgs(m, msgs, dedup, 0) == 0;
 }
 
 /**
@@ -1020,6 +1055,49 @@ static notmuch_threads_t *get_threads(notmuch_query_t *query)
   return threads;
 }
 
+/**
+ * read_threads - Read the threads from the results of a query
+ * @param m       Mailbox
+ * @param q       Notmuch query
+ * @param threads Notmuch threads
+ * @param dedup   Should the results be de-duped?
+ * @param limit   Maximum number of results
+ * @param batch   Read whole threads until this many messages have been read, 0 for all of them
+ * @retval  1 More threads are waiting to be read
+ * @retval  0 All the threads have been read
+ * @retval -1 Interrupted by the user
+ */
+static int read_threads(struct Mailbox *m, notmuch_query_t *q,
+                        notmuch_threads_t *threads, bool dedup, int limit, int batch)
+{
+  const int start = m->msg_count;
+  int rc = 0;
+
+  struct HeaderCache *hc = nm_hcache_open(m);
+
+  for (; notmuch_threads_valid(threads) && ((limit == 0) || (m->msg_count < limit));
+       notmuch_threads_move_to_next(threads))
+  {
+    if ((batch > 0) && ((m->msg_count - start) >= batch))
+    {
+      rc = 1;
+      break;
+    }
+    if (SigInt)
+    {
+      SigInt = false;
+      rc = -1;
+      break;
+    }
+    notmuch_thread_t *thread = notmuch_threads_get(threads);
+    append_thread(hc, m, q, thread, dedup);
+    notmuch_thread_destroy(thread);
+  }
+
+  nm_hcache_close(&hc);
+  return rc;
+}
+
 /**
  * read_threads_query - Perform a query with threads
  * @param m     Mailbox
@@ -1039,26 +1117,83 @@ static bool read_threads_query(struct Mailbox *m, notmuch_query_t *q, bool dedup
   if (!threads)
     return false;
 
-  struct HeaderCache *hc = nm_hcache_open(m);
+  return read_threads(m, q, threads, dedup, limit, 0) == 0;
+}
 
-  for (; notmuch_threads_valid(threads) && ((limit == 0) || (m->msg_count < limit));
-       notmuch_threads_move_to_next(threads))
+/**
+ * stream_open - Start reading the results of a query in batches
+ * @param m     Mailbox
+ * @param mdata Notmuch Mailbox data
+ * @retval true Success
+ *
+ * The query is run on a read-only database of its own, which stays open until
+ * all the results have been read, see nm_mdata_stream_close().  Meanwhile, the
+ * Account's database is free to be reopened for writing.
+ */
+static bool stream_open(struct Mailbox *m, struct NmMboxData *mdata)
+{
+  const char *db_filename = nm_db_get_filename(m);
+  if (!db_filename)
+    return false;
+
+  // The results are a snapshot of the database, so check for changes since then
+  time_t mtime = 0;
+  nm_db_get_mtime(m, &mtime);
+
+  mdata->stream_db = nm_db_do_open(db_filename, false, true);
+  if (!mdata->stream_db)
+    return false;
+
+  mdata->stream_query = query_new(mdata->stream_db, mdata);
+  if (mdata->query_type == NM_QUERY_TYPE_THREADS)
+    mdata->stream_threads = get_threads(mdata->stream_query);
+  else
+    mdata->stream_msgs = get_messages(mdata->stream_query);
+
+  if (!mdata->stream_msgs && !mdata->stream_threads)
   {
-    if (SigInt)
-    {
-      nm_hcache_close(&hc);
-      SigInt = false;
-      return false;
-    }
-    notmuch_thread_t *thread = notmuch_threads_get(threads);
-    append_thread(hc, m, q, thread, dedup);
-    notmuch_thread_destroy(thread);
+    nm_mdata_stream_close(mdata);
+    return false;
   }
 
-  nm_hcache_close(&hc);
+  mdata->mtime.tv_sec = mtime;
+  mdata->mtime.tv_nsec = 0;
+
+  mutt_debug(LL_DEBUG1, "nm: stream open\n");
   return true;
 }
 
+/**
+ * stream_read - Read the next batch of results
+ * @param m     Mailbox
+ * @param mdata Notmuch Mailbox data
+ * @retval  1 More results are waiting to be read
+ * @retval  0 All the results have been read
+ * @retval -1 Interrupted by the user
+ *
+ * Once all the results have been read, the stream is closed.
+ */
+static int stream_read(struct Mailbox *m, struct NmMboxData *mdata)
+{
+  const short c_nm_open_batch = cs_subset_number(NeoMutt->sub, "nm_open_batch");
+
+  int rc;
+  if (mdata->stream_threads)
+  {
+    rc = read_threads(m, mdata->stream_query, mdata->stream_threads, false,
+                      get_limit(mdata), c_nm_open_batch);
+  }
+  else
+  {
+    rc = read_mesgs(m, mdata->stream_msgs, false, c_nm_open_batch);
+  }
+
+  if (rc != 1)
+    nm_mdata_stream_close(mdata);
+
+  return rc;
+}
+
 /**
  * get_nm_message - Find a Notmuch message
  * @param db  Notmuch database
@@ -2076,32 +2211,42 @@ static enum MxOpenReturns nm_mbox_open(struct Mailbox *m)
 
   mutt_debug(LL_DEBUG1, "nm: reading messages...[current count=%d]\n", m->msg_count);
 
+  nm_mdata_stream_close(mdata);
   progress_setup(m);
   enum MxOpenReturns rc = MX_OPEN_ERROR;
 
-  notmuch_query_t *q = get_query(m, false);
-  if (q)
+  // Read the first batch now, and the rest when the user is idle
+  const short c_nm_open_batch = cs_subset_number(NeoMutt->sub, "nm_open_batch");
+  if ((c_nm_open_batch > 0) && stream_open(m, mdata))
   {
-    rc = MX_OPEN_OK;
-    switch (mdata->query_type)
+    rc = (stream_read(m, mdata) < 0) ? MX_OPEN_ABORT : MX_OPEN_OK;
+  }
+  else
+  {
+    notmuch_query_t *q = get_query(m, false);
+    if (q)
     {
-      case NM_QUERY_TYPE_UNKNOWN: // UNKNOWN should never occur, but MESGS is default
-      case NM_QUERY_TYPE_MESGS:
-        if (!read_mesgs_query(m, q, false))
-          rc = MX_OPEN_ABORT;
-        break;
-      case NM_QUERY_TYPE_THREADS:
-        if (!read_threads_query(m, q, false, get_limit(mdata)))
-          rc = MX_OPEN_ABORT;
-        break;
+      rc = MX_OPEN_OK;
+      switch (mdata->query_type)
+      {
+        case NM_QUERY_TYPE_UNKNOWN: // UNKNOWN should never occur, but MESGS is default
+        case NM_QUERY_TYPE_MESGS:
+          if (!read_mesgs_query(m, q, false))
+            rc = MX_OPEN_ABORT;
+          break;
+        case NM_QUERY_TYPE_THREADS:
+          if (!read_threads_query(m, q, false, get_limit(mdata)))
+            rc = MX_OPEN_ABORT;
+          break;
+      }
+      notmuch_query_destroy(q);
     }
-    notmuch_query_destroy(q);
-  }
 
-  nm_db_release(m);
+    nm_db_release(m);
 
-  mdata->mtime.tv_sec = mutt_date_now();
-  mdata->mtime.tv_nsec = 0;
+    mdata->mtime.tv_sec = mutt_date_now();
+    mdata->mtime.tv_nsec = 0;
+  }
 
   mdata->oldmsgcount = 0;
 
@@ -2110,6 +2255,43 @@ static enum MxOpenReturns nm_mbox_open(struct Mailbox *m)
   return rc;
 }
 
+/**
+ * nm_stream_read - Read more of the results of opening a Mailbox
+ * @param m Mailbox
+ * @retval #MX_STATUS_NEW_MAIL Some messages were read
+ * @retval #MX_STATUS_OK       Nothing to do
+ *
+ * This is called when the user is idle in the Index.  If the Mailbox was opened
+ * in batches, see $nm_open_batch, it reads batches for up to #NM_STREAM_SLICE_MS.
+ */
+enum MxStatus nm_stream_read(struct Mailbox *m)
+{
+  struct NmMboxData *mdata = nm_mdata_get(m);
+  if (!mdata || !mdata->stream_db)
+    return MX_STATUS_OK;
+
+  const int old_count = m->msg_count;
+  const uint64_t end = mutt_date_now_ms() + NM_STREAM_SLICE_MS;
+
+  while ((stream_read(m, mdata) == 1) && (mutt_date_now_ms() < end))
+    ; // do nothing
+
+  mutt_debug(LL_DEBUG2, "nm: stream read %d messages [count=%d]\n",
+             m->msg_count - old_count, m->msg_count);
+
+  // Rebuilding the View after every batch would be quadratic, so just update
+  // the counts; the Index threads the new Emails.  After the last batch,
+  // rebuild it once, to hash, score and label all the Emails.
+  if (!mdata->stream_db)
+    mailbox_changed(m, NT_MAILBOX_INVALID);
+  else if (m->msg_count != old_count)
+    mailbox_changed(m, NT_MAILBOX_UPDATE);
+  else
+    return MX_STATUS_OK;
+
+  return MX_STATUS_NEW_MAIL;
+}
+
 /**
  * nm_mbox_check - Check for new mail - Implements MxOps::mbox_check() - @ingroup mx_mbox_check
  * @param m Mailbox
@@ -2122,6 +2304,13 @@ static enum MxStatus nm_mbox_check(struct Mailbox *m)
   if (!mdata || (nm_db_get_mtime(m, &mtime) != 0))
     return MX_STATUS_ERROR;
 
+  // Finish reading the results first, see nm_stream_read()
+  if (mdata->stream_db)
+  {
+    mutt_debug(LL_DEBUG2, "nm: check postponed, still reading\n");
+    return MX_STATUS_OK;
+  }
+
   int new_flags = 0;
   bool occult = false;
 
@@ -2374,11 +2563,10 @@ static enum MxStatus nm_mbox_sync(struct Mailbox *m)
 
 /**
  * nm_mbox_close - Close a Mailbox - Implements MxOps::mbox_close() - @ingroup mx_mbox_close
- *
- * Nothing to do.
  */
 static enum MxStatus nm_mbox_close(struct Mailbox *m)
 {
+  nm_mdata_stream_close(nm_mdata_get(m));
   return MX_STATUS_OK;
 }
 
@@ -2459,6 +2647,7 @@ static int nm_tags_commit(struct Mailbox *m, struct Email *e, const char *buf)
   update_email_flags(m, e, buf);
   update_email_tags(e, msg);
   email_set_color(m, e);
+  m->view_gen++;
 
   rc = 0;
   e->changed = true;
@@ -44,6 +44,7 @@
 #include "display.h"
 #include "lib.h"
 #include "color/lib.h"
+#include "lindex.h"
 #include "private_data.h"
 
 /**
@@ -827,6 +828,46 @@ static int fill_buffer(FILE *fp, LOFF_T *bytes_read, LOFF_T offset, unsigned cha
   return b_read;
 }
 
+/**
+ * skip_plain_line - Find the end of a plain line without reading it
+ * @param[in]  fp       File to read from
+ * @param[in]  priv     Private Pager data
+ * @param[out] lines    Line info
+ * @param[in]  line_num Line number (index into lines)
+ * @param[in]  flags    Flags, see #PagerFlags
+ * @param[in]  width    Width of screen (to wrap to)
+ * @retval true The line fits on screen and the next Line has been started
+ *
+ * If the LineIndex knows that the line is plain, and it's narrower than the
+ * screen, then it won't wrap.  The next line starts where the index says.
+ */
+static bool skip_plain_line(FILE *fp, struct PagerPrivateData *priv,
+                            struct Line *lines, int line_num, PagerFlags flags, int width)
+{
+  if (lines[line_num].cont_line)
+    return false;
+
+  if (!priv->lindex)
+  {
+    priv->lindex = lindex_new(fp);
+    if (!priv->lindex)
+      return false;
+  }
+
+  const int line = lindex_find(priv->lindex, lines[line_num].offset);
+  const int plain_width = lindex_plain_width(priv->lindex, line);
+  if (plain_width < 0)
+    return false;
+
+  const short c_wrap = cs_subset_number(NeoMutt->sub, "wrap");
+  const int wrap_cols = mutt_window_wrap_cols(width, (flags & MUTT_PAGER_NOWRAP) ? 0 : c_wrap);
+  if (plain_width > wrap_cols)
+    return false;
+
+  lines[line_num + 1].offset = priv->lindex->offsets[line + 1];
+  return true;
+}
+
 /**
  * format_line - Display a line of text in the pager
  * @param[in]  win       Window
@@ -1246,6 +1287,14 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
     goto out; /* fake display */
   }
 
+  /* Lines that aren't being displayed or classified, only need their length */
+  if (!(flags & (MUTT_SHOW | MUTT_TYPES | MUTT_SEARCH | MUTT_PAGER_LOGS)) &&
+      skip_plain_line(fp, priv, *lines, line_num, flags, win_pager->state.cols))
+  {
+    rc = 0;
+    goto out;
+  }
+
   b_read = fill_buffer(fp, bytes_read, cur_line->offset, &buf, &fmt, &buflen, &buf_ready);
   if (b_read < 0)
   {
@@ -50,6 +50,7 @@
 #include "lib.h"
 #include "color/lib.h"
 #include "expando/lib.h"
+#include "imap/lib.h"
 #include "index/lib.h"
 #include "key/lib.h"
 #include "menu/lib.h"
@@ -57,6 +58,7 @@
 #include "sidebar/lib.h"
 #include "display.h"
 #include "functions.h"
+#include "lindex.h"
 #include "mutt_logging.h"
 #include "mutt_mailbox.h"
 #include "mview.h"
@@ -505,6 +507,9 @@ int dlg_pager(struct PagerView *pview)
 
     mutt_debug(LL_DEBUG1, "Got op %s (%d)\n", opcodes_get_name(op), op);
 
+    if ((op == OP_TIMEOUT) && (pview->mode == PAGER_MODE_EMAIL))
+      imap_prefetch(shared->mailbox, shared->email);
+
     if (op < OP_NULL)
       continue;
 
@@ -545,6 +550,7 @@ int dlg_pager(struct PagerView *pview)
   //-------------------------------------------------------------------------
 
   mutt_file_fclose(&priv->fp);
+  lindex_free(&priv->lindex);
   if (pview->mode == PAGER_MODE_EMAIL)
   {
     if (shared->mailbox_view)
@@ -396,6 +396,35 @@ bool jump_to_bottom(struct PagerPrivateData *priv, struct PagerView *pview)
   return true;
 }
 
+/**
+ * search_line - Find the search matches in a Line
+ * @param priv     Private Pager data
+ * @param line_num Line number
+ * @retval true  The Line has been searched
+ * @retval false The end of the file was reached
+ *
+ * Any Lines before it, that haven't been read yet, are read first.
+ */
+static bool search_line(struct PagerPrivateData *priv, int line_num)
+{
+  struct PagerView *pview = priv->pview;
+  const PagerFlags flags = MUTT_SEARCH | (pview->flags & MUTT_PAGER_NOWRAP) |
+                           priv->has_types;
+
+  for (int i = MIN(priv->lines_used, line_num); i <= line_num; i++)
+  {
+    if (display_line(priv->fp, &priv->bytes_read, &priv->lines, i,
+                     &priv->lines_used, &priv->lines_max, flags, &priv->quote_list,
+                     &priv->q_level, &priv->force_redraw, &priv->search_re,
+                     pview->win_pager, &priv->ansi_list) < 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 
 /**
@@ -578,8 +607,6 @@ static int op_pager_prev_page(struct IndexSharedData *shared,
 static int op_pager_search(struct IndexSharedData *shared,
                            struct PagerPrivateData *priv, int op)
 {
-  struct PagerView *pview = priv->pview;
-
   int rc = FR_NO_ACTION;
   struct Buffer *buf = buf_pool_get();
 
@@ -644,51 +671,40 @@ static int op_pager_search(struct IndexSharedData *shared,
   else
   {
     priv->search_compiled = true;
-    /* update the search pointers */
-    int line_num = 0;
-    while (display_line(priv->fp, &priv->bytes_read, &priv->lines, line_num,
-                        &priv->lines_used, &priv->lines_max,
-                        MUTT_SEARCH | (pview->flags & MUTT_PAGER_NOWRAP) | priv->has_types,
-                        &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                        &priv->search_re, priv->pview->win_pager, &priv->ansi_list) == 0)
-    {
-      line_num++;
-    }
-
+    /* the Lines are searched as they're needed, stopping at the first match */
+    bool found = false;
+    int i;
     if (priv->search_back)
     {
       /* searching backward */
-      int i;
-      for (i = priv->top_line; i >= 0; i--)
+      for (i = priv->top_line; (i >= 0) && search_line(priv, i); i--)
       {
         if ((!priv->hide_quoted || !COLOR_QUOTED(priv->lines[i].cid)) &&
             !priv->lines[i].cont_line && (priv->lines[i].search_arr_size > 0))
         {
+          found = true;
           break;
         }
       }
-
-      if (i >= 0)
-        priv->top_line = i;
     }
     else
     {
       /* searching forward */
-      int i;
-      for (i = priv->top_line; i < priv->lines_used; i++)
+      for (i = priv->top_line; search_line(priv, i); i++)
       {
         if ((!priv->hide_quoted || !COLOR_QUOTED(priv->lines[i].cid)) &&
             !priv->lines[i].cont_line && (priv->lines[i].search_arr_size > 0))
         {
+          found = true;
           break;
         }
       }
-
-      if (i < priv->lines_used)
-        priv->top_line = i;
     }
 
-    if (priv->lines[priv->top_line].search_arr_size == 0)
+    if (found)
+      priv->top_line = i;
+
+    if (!found)
     {
       priv->search_flag = 0;
       mutt_error(_("Not found"));
@@ -740,19 +756,21 @@ static int op_pager_search_next(struct IndexSharedData *shared,
         (priv->search_back && (op == OP_SEARCH_OPPOSITE)))
     {
       /* searching forward */
+      bool found = false;
       int i;
       for (i = priv->wrapped ? 0 : priv->top_line + priv->searchctx + 1;
-           i < priv->lines_used; i++)
+           search_line(priv, i); i++)
       {
         if ((!priv->hide_quoted || !COLOR_QUOTED(priv->lines[i].cid)) &&
             !priv->lines[i].cont_line && (priv->lines[i].search_arr_size > 0))
         {
+          found = true;
           break;
         }
       }
 
       const bool c_wrap_search = cs_subset_bool(NeoMutt->sub, "wrap_search");
-      if (i < priv->lines_used)
+      if (found)
       {
         priv->top_line = i;
       }
@@ -770,20 +788,29 @@ static int op_pager_search_next(struct IndexSharedData *shared,
     else
     {
       /* searching backward */
+      /* wrapping to the bottom needs the whole file */
+      if (priv->wrapped)
+      {
+        while (search_line(priv, priv->lines_used))
+          ; // do nothing
+      }
+
+      bool found = false;
       int i;
-      for (i = priv->wrapped ? priv->lines_used : priv->top_line + priv->searchctx - 1;
-           i >= 0; i--)
+      for (i = priv->wrapped ? priv->lines_used - 1 : priv->top_line + priv->searchctx - 1;
+           (i >= 0) && search_line(priv, i); i--)
       {
         if ((!priv->hide_quoted ||
              (priv->has_types && !COLOR_QUOTED(priv->lines[i].cid))) &&
             !priv->lines[i].cont_line && (priv->lines[i].search_arr_size > 0))
         {
+          found = true;
           break;
         }
       }
 
       const bool c_wrap_search = cs_subset_bool(NeoMutt->sub, "wrap_search");
-      if (i >= 0)
+      if (found)
       {
         priv->top_line = i;
       }
@@ -33,6 +33,7 @@
  * | pager/dlg_pager.c    | @subpage pager_dlg_pager    |
  * | pager/do_pager.c     | @subpage pager_dopager      |
  * | pager/functions.c    | @subpage pager_functions    |
+ * | pager/lindex.c       | @subpage pager_lindex       |
  * | pager/message.c      | @subpage pager_message      |
  * | pager/pager.c        | @subpage pager_pager        |
  * | pager/pbar.c         | @subpage pager_pbar         |
@@ -0,0 +1,262 @@
+/**
+ * @file
+ * Index of the lines in a Pager file
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pager_lindex Index of the lines in a Pager file
+ *
+ * The Pager builds its Line array one line at a time, reading and formatting
+ * each line of the file to find where the next one starts.  For a huge
+ * attachment, jumping to the bottom, or searching, used to format every line.
+ *
+ * The LineIndex is built by a single pass over the file.  It records where
+ * each line starts and whether it's plain printable ASCII.  The display of a
+ * plain line can't wrap if it's narrower than the Window, so the Pager can
+ * skip over it without reading it again.
+ *
+ * The file is scanned 8 bytes at a time; a word with no control characters,
+ * DEL or 8-bit bytes, can't contain a newline either.
+ */
+
+#include "config.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "lindex.h"
+
+/// Size of the blocks read from the file
+#define LINDEX_BLOCK_SIZE (64 * 1024)
+
+/**
+ * word_is_plain - Does a word only contain printable ASCII?
+ * @param w 8 bytes of text
+ * @retval true No byte is a control character, DEL or 8-bit
+ */
+static inline bool word_is_plain(uint64_t w)
+{
+  const uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t high = 0x8080808080808080ULL;
+
+  const uint64_t ctrl = (w - (ones * 0x20)) & ~w & high; // byte < 0x20
+  const uint64_t v = w ^ (ones * 0x7f);
+  const uint64_t del = (v - ones) & ~v & high; // byte == 0x7f
+
+  return ((w & high) | ctrl | del) == 0;
+}
+
+/**
+ * lindex_add - Add a line to the index
+ * @param li    Line Index
+ * @param max   Capacity of the arrays
+ * @param start Offset of the start of the line
+ * @param plain true if the line is plain
+ */
+static void lindex_add(struct LineIndex *li, size_t *max, LOFF_T start, bool plain)
+{
+  // Keep a spare slot for the end of the file
+  if ((li->num_lines + 1) >= *max)
+  {
+    const size_t old_words = (*max + 63) / 64;
+    *max = MAX(1024, *max * 2);
+    const size_t new_words = (*max + 63) / 64;
+
+    MUTT_MEM_REALLOC(&li->offsets, *max, LOFF_T);
+    MUTT_MEM_REALLOC(&li->plain, new_words, uint64_t);
+    memset(li->plain + old_words, 0, (new_words - old_words) * sizeof(uint64_t));
+  }
+
+  li->offsets[li->num_lines] = start;
+  if (plain)
+    li->plain[li->num_lines / 64] |= (1ULL << (li->num_lines % 64));
+  li->num_lines++;
+}
+
+/**
+ * lindex_new - Index the lines of a file
+ * @param fp File to index
+ * @retval ptr  New LineIndex
+ * @retval NULL Error
+ *
+ * The file position is restored afterwards.
+ */
+struct LineIndex *lindex_new(FILE *fp)
+{
+  if (!fp)
+    return NULL;
+
+  const LOFF_T pos = ftello(fp);
+  if ((pos < 0) || !mutt_file_seek(fp, 0, SEEK_SET))
+    return NULL;
+
+  struct LineIndex *li = MUTT_MEM_CALLOC(1, struct LineIndex);
+  unsigned char *block = MUTT_MEM_MALLOC(LINDEX_BLOCK_SIZE, unsigned char);
+  size_t max = 0;
+  LOFF_T base = 0;  // Offset of the block
+  LOFF_T start = 0; // Start of the current line
+  bool plain = true;
+  size_t len;
+
+  while ((len = fread(block, 1, LINDEX_BLOCK_SIZE, fp)) > 0)
+  {
+    size_t i = 0;
+    while (i < len)
+    {
+      if ((i + sizeof(uint64_t)) <= len)
+      {
+        uint64_t w;
+        memcpy(&w, block + i, sizeof(w));
+        if (word_is_plain(w))
+        {
+          i += sizeof(w);
+          continue;
+        }
+      }
+
+      const size_t end = MIN(i + sizeof(uint64_t), len);
+      for (; i < end; i++)
+      {
+        const unsigned char c = block[i];
+        if (c == '\n')
+        {
+          lindex_add(li, &max, start, plain);
+          start = base + i + 1;
+          plain = true;
+        }
+        else if ((c < 0x20) || (c >= 0x7f))
+        {
+          plain = false;
+        }
+      }
+    }
+    base += len;
+  }
+
+  FREE(&block);
+
+  if (ferror(fp))
+  {
+    lindex_free(&li);
+    mutt_file_seek(fp, pos, SEEK_SET);
+    return NULL;
+  }
+
+  li->last_nl = (start == base);
+  if (!li->last_nl)
+    lindex_add(li, &max, start, plain);
+
+  if (max == 0)
+    MUTT_MEM_REALLOC(&li->offsets, 1, LOFF_T);
+  li->offsets[li->num_lines] = base;
+
+  mutt_file_seek(fp, pos, SEEK_SET);
+  mutt_debug(LL_DEBUG2, "indexed %zu lines, %lld bytes\n", li->num_lines, (long long) base);
+  return li;
+}
+
+/**
+ * lindex_free - Free a LineIndex
+ * @param ptr LineIndex to free
+ */
+void lindex_free(struct LineIndex **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct LineIndex *li = *ptr;
+  FREE(&li->offsets);
+  FREE(&li->plain);
+
+  FREE(ptr);
+}
+
+/**
+ * lindex_find - Find the line that starts at an offset
+ * @param li     Line Index
+ * @param offset Offset into the file
+ * @retval num Line number
+ * @retval -1  No line starts at this offset
+ *
+ * The Pager usually asks for consecutive lines, so the search starts after the
+ * last line found.
+ */
+int lindex_find(struct LineIndex *li, LOFF_T offset)
+{
+  if (!li || (li->num_lines == 0))
+    return -1;
+
+  size_t lo = 0;
+  size_t hi = li->num_lines;
+
+  for (size_t i = li->hint; (i < li->num_lines) && (i < (li->hint + 2)); i++)
+  {
+    if (li->offsets[i] == offset)
+    {
+      lo = i;
+      goto found;
+    }
+  }
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + ((hi - lo) / 2);
+    if (li->offsets[mid] < offset)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if ((lo == li->num_lines) || (li->offsets[lo] != offset))
+    return -1;
+
+found:
+  if (lo > INT_MAX)
+    return -1;
+  li->hint = lo;
+  return (int) lo;
+}
+
+/**
+ * lindex_plain_width - Get the screen width of a plain line
+ * @param li   Line Index
+ * @param line Line number
+ * @retval num Width of the line, not counting the newline
+ * @retval -1  The line isn't plain
+ */
+int lindex_plain_width(const struct LineIndex *li, int line)
+{
+  if (!li || (line < 0) || ((size_t) line >= li->num_lines))
+    return -1;
+
+  if (!(li->plain[line / 64] & (1ULL << (line % 64))))
+    return -1;
+
+  LOFF_T len = li->offsets[line + 1] - li->offsets[line];
+  if (((size_t) line < (li->num_lines - 1)) || li->last_nl)
+    len--;
+
+  if (len > INT_MAX)
+    return -1;
+
+  return (int) len;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file
+ * Index of the lines in a Pager file
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_PAGER_LINDEX_H
+#define MUTT_PAGER_LINDEX_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "mutt/lib.h"
+
+/**
+ * struct LineIndex - Index of the lines in a Pager file
+ *
+ * A line is "plain" if it only contains printable ASCII, so its width on
+ * screen is its length.
+ */
+struct LineIndex
+{
+  LOFF_T *offsets;      ///< Start of each line, plus the end of the file
+  uint64_t *plain;      ///< Bitmap of the plain lines
+  size_t num_lines;     ///< Number of lines in the file
+  size_t hint;          ///< Last line found, see lindex_find()
+  bool last_nl;         ///< The last line ends with a newline
+};
+
+void              lindex_free       (struct LineIndex **ptr);
+int               lindex_find       (struct LineIndex *li, LOFF_T offset);
+struct LineIndex *lindex_new        (FILE *fp);
+int               lindex_plain_width(const struct LineIndex *li, int line);
+
+#endif /* MUTT_PAGER_LINDEX_H */
@@ -279,6 +279,7 @@ static int email_to_file(struct Message *msg, struct Buffer *tempfile,
     /* Remove color cache for this message, in case there
      * are color patterns for both ~g and ~V */
     e->attr_color = NULL;
+    m->view_gen++;
 
     /* Process protected headers and autocrypt gossip headers */
     process_protected_headers(m, e);
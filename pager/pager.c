@@ -180,8 +180,7 @@ static int pager_repaint(struct MuttWindow *win)
       {
         if (!repopulate)
           priv->top_line = i;
-        if (!priv->search_flag)
-          break;
+        break;
       }
     }
   }
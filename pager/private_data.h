@@ -32,6 +32,7 @@
 #include "lib.h"
 #include "color/lib.h"
 
+struct LineIndex;
 struct MuttWindow;
 
 /**
@@ -44,6 +45,7 @@ struct PagerPrivateData
   FILE *fp;                    ///< File containing decrypted/decoded/weeded Email
   struct stat st;              ///< Stats about Email file
   LOFF_T bytes_read;           ///< Number of bytes read from file
+  struct LineIndex *lindex;    ///< Index of the lines in the file
 
   struct Line *lines;          ///< Array of text lines in pager
   int lines_used;              ///< Size of lines array (used entries)
@@ -0,0 +1,179 @@
+/**
+ * @file
+ * Match flag Patterns using bitmaps
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_bitmap Match flag Patterns using bitmaps
+ *
+ * A Pattern that only tests the Email flags, e.g. `~N | (~F !~D)`, can be
+ * answered for the whole Mailbox at once, using the Mailbox's FlagIndex.
+ * The logical operators become AND/OR/NOT of whole words.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+
+/**
+ * pattern_is_flag_only - Can a Pattern be answered from the FlagIndex?
+ * @param pat Pattern to check
+ * @retval true The Pattern only tests flags kept in the FlagIndex
+ */
+static bool pattern_is_flag_only(const struct Pattern *pat)
+{
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      const struct Pattern *np = NULL;
+      SLIST_FOREACH(np, pat->child, entries)
+      {
+        if (!pattern_is_flag_only(np))
+          return false;
+      }
+      return true;
+    }
+
+    case MUTT_ALL:
+    case MUTT_DELETED:
+    case MUTT_FLAG:
+    case MUTT_NEW:
+    case MUTT_OLD:
+    case MUTT_READ:
+    case MUTT_REPLIED:
+    case MUTT_TAG:
+    case MUTT_UNREAD:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * bitmap_eval - Evaluate a flag Pattern over the FlagIndex
+ * @param[in]  pat Pattern, see pattern_is_flag_only()
+ * @param[in]  fi  Flag Index
+ * @param[out] out Bitmap for the results, `fi->words` long
+ */
+static void bitmap_eval(const struct Pattern *pat, const struct FlagIndex *fi, uint64_t *out)
+{
+  const size_t words = fi->words;
+  const uint64_t *read = flag_index_bitmap(fi, FIB_READ);
+  const uint64_t *old = flag_index_bitmap(fi, FIB_OLD);
+  const uint64_t *other = NULL;
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      const bool is_and = (pat->op == MUTT_PAT_AND);
+      memset(out, is_and ? 0xff : 0, words * sizeof(uint64_t));
+
+      uint64_t *tmp = MUTT_MEM_MALLOC(words, uint64_t);
+      const struct Pattern *np = NULL;
+      SLIST_FOREACH(np, pat->child, entries)
+      {
+        bitmap_eval(np, fi, tmp);
+        for (size_t i = 0; i < words; i++)
+          out[i] = is_and ? (out[i] & tmp[i]) : (out[i] | tmp[i]);
+      }
+      FREE(&tmp);
+      break;
+    }
+
+    case MUTT_ALL:
+      memset(out, 0xff, words * sizeof(uint64_t));
+      break;
+    case MUTT_NEW:
+      for (size_t i = 0; i < words; i++)
+        out[i] = ~(read[i] | old[i]);
+      break;
+    case MUTT_OLD:
+      for (size_t i = 0; i < words; i++)
+        out[i] = old[i] & ~read[i];
+      break;
+    case MUTT_UNREAD:
+      for (size_t i = 0; i < words; i++)
+        out[i] = ~read[i];
+      break;
+
+    case MUTT_READ:
+      other = read;
+      break;
+    case MUTT_DELETED:
+      other = flag_index_bitmap(fi, FIB_DELETED);
+      break;
+    case MUTT_FLAG:
+      other = flag_index_bitmap(fi, FIB_FLAGGED);
+      break;
+    case MUTT_REPLIED:
+      other = flag_index_bitmap(fi, FIB_REPLIED);
+      break;
+    case MUTT_TAG:
+      other = flag_index_bitmap(fi, FIB_TAGGED);
+      break;
+  }
+
+  if (other)
+    memcpy(out, other, words * sizeof(uint64_t));
+
+  if (pat->pat_not)
+  {
+    for (size_t i = 0; i < words; i++)
+      out[i] = ~out[i];
+  }
+}
+
+/**
+ * pattern_exec_bitmap - Match a flag Pattern against every Email in a Mailbox
+ * @param pat Pattern to match
+ * @param m   Mailbox
+ * @retval ptr  Bitmap of the matches, bit `i` is `Mailbox.emails[i]`
+ * @retval NULL The Pattern tests more than the flags
+ *
+ * The caller must free the bitmap.
+ */
+uint64_t *pattern_exec_bitmap(const struct Pattern *pat, struct Mailbox *m)
+{
+  if (!pat || !m || !pattern_is_flag_only(pat))
+    return NULL;
+
+  const struct FlagIndex *fi = flag_index_get(m);
+  if (!fi || (fi->words == 0))
+    return NULL;
+
+  uint64_t *matches = MUTT_MEM_MALLOC(fi->words, uint64_t);
+  bitmap_eval(pat, fi, matches);
+
+  // Clear the bits past the end of the Mailbox
+  if (fi->count % 64)
+    matches[fi->words - 1] &= ((uint64_t) 1 << (fi->count % 64)) - 1;
+
+  return matches;
+}
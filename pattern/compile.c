@@ -895,7 +895,7 @@ static struct Pattern *attach_new_leaf(struct PatternList **curlist)
 }
 
 /**
- * mutt_pattern_comp - Create a Pattern
+ * pattern_comp - Create a Pattern
  * @param mv    Mailbox view
  * @param menu  Current Menu
  * @param s     Pattern string
@@ -903,9 +903,9 @@ static struct Pattern *attach_new_leaf(struct PatternList **curlist)
  * @param err   Buffer for error messages
  * @retval ptr Newly allocated Pattern
  */
-struct PatternList *mutt_pattern_comp(struct MailboxView *mv, struct Menu *menu,
-                                      const char *s, PatternCompFlags flags,
-                                      struct Buffer *err)
+static struct PatternList *pattern_comp(struct MailboxView *mv, struct Menu *menu,
+                                        const char *s, PatternCompFlags flags,
+                                        struct Buffer *err)
 {
   /* curlist when assigned will always point to a list containing at least one node
    * with a Pattern value.  */
@@ -1010,7 +1010,7 @@ struct PatternList *mutt_pattern_comp(struct MailboxView *mv, struct Menu *menu,
           is_alias = false;
           /* compile the sub-expression */
           buf = mutt_strn_dup(ps->dptr + 1, p - (ps->dptr + 1));
-          leaf->child = mutt_pattern_comp(mv, menu, buf, flags, err);
+          leaf->child = pattern_comp(mv, menu, buf, flags, err);
           if (!leaf->child)
           {
             FREE(&buf);
@@ -1102,7 +1102,7 @@ struct PatternList *mutt_pattern_comp(struct MailboxView *mv, struct Menu *menu,
         }
         /* compile the sub-expression */
         buf = mutt_strn_dup(ps->dptr + 1, p - (ps->dptr + 1));
-        struct PatternList *sub = mutt_pattern_comp(mv, menu, buf, flags, err);
+        struct PatternList *sub = pattern_comp(mv, menu, buf, flags, err);
         FREE(&buf);
         if (!sub)
           goto cleanup;
@@ -1153,3 +1153,25 @@ cleanup:
   buf_pool_release(&ps);
   return NULL;
 }
+
+/**
+ * mutt_pattern_comp - Create a Pattern
+ * @param mv    Mailbox view
+ * @param menu  Current Menu
+ * @param s     Pattern string
+ * @param flags Flags, e.g. #MUTT_PC_FULL_MSG
+ * @param err   Buffer for error messages
+ * @retval ptr Newly allocated Pattern
+ *
+ * The Pattern is optimised before it's returned, see pattern_optimize().
+ */
+struct PatternList *mutt_pattern_comp(struct MailboxView *mv, struct Menu *menu,
+                                      const char *s, PatternCompFlags flags,
+                                      struct Buffer *err)
+{
+  struct PatternList *pat = pattern_comp(mv, menu, s, flags, err);
+  if (pat)
+    pattern_optimize(SLIST_FIRST(pat), mv ? mv->mailbox : NULL);
+
+  return pat;
+}
@@ -62,6 +62,9 @@ static struct ConfigDef PatternVars[] = {
   { "pattern_format", DT_EXPANDO, IP "%2n %-15e  %d", IP &PatternFormatDef, NULL,
     "printf-like format string for the pattern completion menu"
   },
+  { "search_read_threads", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 4, 0, NULL,
+    "Number of threads used to search Maildir and MH messages"
+  },
   { "thorough_search", DT_BOOL, true, 0, NULL,
     "Decode headers and messages before searching them"
   },
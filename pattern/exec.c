@@ -31,6 +31,7 @@
  */
 
 #include "config.h"
+#include <limits.h>
 #include <stdarg.h> // IWYU pragma: keep
 #include <stdbool.h>
 #include <stdio.h>
@@ -60,7 +61,7 @@
 
 static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
                          struct Mailbox *m, struct Email *e,
-                         struct Message *msg, struct PatternCache *cache);
+                         struct Message **msg, struct PatternCache *cache);
 
 /**
  * patmatch - Compare a string to a Pattern
@@ -102,15 +103,34 @@ static void print_crypt_pattern_op_error(int op)
   }
 }
 
+/**
+ * msg_seek - Seek to a position in a Message
+ * @param fp     File to seek
+ * @param offset Offset to seek to
+ * @param flags  Flags, e.g. #MUTT_MATCH_WORKER
+ * @retval true Success
+ *
+ * A worker thread mustn't report errors, so it seeks quietly.
+ */
+static bool msg_seek(FILE *fp, LOFF_T offset, PatternExecFlags flags)
+{
+  if (flags & MUTT_MATCH_WORKER)
+    return (fseeko(fp, offset, SEEK_SET) == 0);
+
+  return mutt_file_seek(fp, offset, SEEK_SET);
+}
+
 /**
  * msg_search - Search an email
  * @param pat   Pattern to find
- * @param e   Email
- * @param msg Message
+ * @param flags Flags, e.g. #MUTT_MATCH_WORKER
+ * @param e     Email
+ * @param msg   Message
  * @retval true Pattern found
  * @retval false Error or pattern not found
  */
-static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg)
+static bool msg_search(struct Pattern *pat, PatternExecFlags flags,
+                       struct Email *e, struct Message *msg)
 {
   ASSERT(msg);
 
@@ -225,7 +245,7 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
     fp = msg->fp;
     if (needs_head)
     {
-      if (!mutt_file_seek(fp, e->offset, SEEK_SET))
+      if (!msg_seek(fp, e->offset, flags))
       {
         return false;
       }
@@ -235,7 +255,7 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
     {
       if (pat->op == MUTT_PAT_BODY)
       {
-        if (!mutt_file_seek(fp, e->body->offset, SEEK_SET))
+        if (!msg_seek(fp, e->body->offset, flags))
         {
           return false;
         }
@@ -247,7 +267,9 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
   /* search the file "fp" */
   if (pat->op == MUTT_PAT_HEADER)
   {
-    struct Buffer *buf = buf_pool_get();
+    /* The Buffer pool isn't shared with the worker threads */
+    const bool worker = (flags & MUTT_MATCH_WORKER);
+    struct Buffer *buf = worker ? buf_new(NULL) : buf_pool_get();
     while (len > 0)
     {
       if (mutt_rfc822_read_line(fp, buf) == 0)
@@ -261,7 +283,10 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
         break;
       }
     }
-    buf_pool_release(&buf);
+    if (worker)
+      buf_free(&buf);
+    else
+      buf_pool_release(&buf);
   }
   else
   {
@@ -297,12 +322,12 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
  * @param flags Optional flags, e.g. #MUTT_MATCH_FULL_ADDRESS
  * @param m   Mailbox
  * @param e   Email
- * @param msg Message
+ * @param msg Message, opened on demand
  * @param cache Cached Patterns
  * @retval true ALL of the Patterns evaluates to true
  */
 static bool perform_and(struct PatternList *pat, PatternExecFlags flags,
-                        struct Mailbox *m, struct Email *e, struct Message *msg,
+                        struct Mailbox *m, struct Email *e, struct Message **msg,
                         struct PatternCache *cache)
 {
   struct Pattern *p = NULL;
@@ -346,12 +371,12 @@ static bool perform_alias_and(struct PatternList *pat, PatternExecFlags flags,
  * @param flags Optional flags, e.g. #MUTT_MATCH_FULL_ADDRESS
  * @param m   Mailbox
  * @param e   Email
- * @param msg Message
+ * @param msg Message, opened on demand
  * @param cache Cached Patterns
  * @retval true ONE (or more) of the Patterns evaluates to true
  */
 static int perform_or(struct PatternList *pat, PatternExecFlags flags,
-                      struct Mailbox *m, struct Email *e, struct Message *msg,
+                      struct Mailbox *m, struct Email *e, struct Message **msg,
                       struct PatternCache *cache)
 {
   struct Pattern *p = NULL;
@@ -788,6 +813,29 @@ static int msg_search_sendmode(struct Email *e, struct Pattern *pat)
   return match;
 }
 
+/**
+ * pattern_msg_open - Open an Email's Message, if it isn't already open
+ * @param m     Mailbox
+ * @param e     Email
+ * @param flags Flags, e.g. #MUTT_MATCH_WORKER
+ * @param msg   Message, opened on demand
+ * @retval ptr  Open Message
+ * @retval NULL Error
+ *
+ * The Message is only opened when a Pattern needs it, so a cheaper Pattern
+ * that decides the result first saves reading the email.
+ *
+ * A worker thread can't use the Mailbox backend, see pattern_exec_worker().
+ */
+static struct Message *pattern_msg_open(struct Mailbox *m, struct Email *e,
+                                        PatternExecFlags flags, struct Message **msg)
+{
+  if (!*msg && m && !(flags & MUTT_MATCH_WORKER))
+    *msg = mx_msg_open(m, e);
+
+  return *msg;
+}
+
 /**
  * pattern_needs_msg - Check whether a pattern needs a full message
  * @param m Mailbox
@@ -795,7 +843,7 @@ static int msg_search_sendmode(struct Email *e, struct Pattern *pat)
  * @retval true The pattern needs a full message
  * @retval false The pattern does not need a full message
  */
-static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat)
+bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat)
 {
   if (!m)
   {
@@ -827,13 +875,179 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
   return false;
 }
 
+/**
+ * pattern_msg_wanted - Will matching a Pattern open the Email's Message?
+ * @param pat   Pattern
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param m     Mailbox
+ * @param e     Email
+ * @retval true The Message will (probably) be opened
+ *
+ * The Patterns that don't need the Message are tested first, in the order that
+ * pattern_exec() will test them.  e.g. `~N ~b foo` only wants the Messages of
+ * new Emails.  If in doubt, the Message is wanted.
+ */
+bool pattern_msg_wanted(struct Pattern *pat, PatternExecFlags flags,
+                        struct Mailbox *m, struct Email *e)
+{
+  if (!pattern_needs_msg(m, pat))
+    return false;
+
+  if ((pat->op != MUTT_PAT_AND) && (pat->op != MUTT_PAT_OR))
+    return true;
+
+  /* A cheap child can decide the result before the Message is needed */
+  const bool is_and = (pat->op == MUTT_PAT_AND);
+  struct Pattern *p = NULL;
+  SLIST_FOREACH(p, pat->child, entries)
+  {
+    if (pattern_needs_msg(m, p))
+      return true;
+
+    struct Message *msg = NULL;
+    if (pattern_exec(p, flags, m, e, &msg, NULL) != is_and)
+      return false;
+  }
+
+  return false;
+}
+
+/**
+ * pattern_is_thread_safe - Can a Pattern be matched by a worker thread?
+ * @param m   Mailbox
+ * @param pat Pattern
+ * @retval true The Pattern can be matched by pattern_exec_worker()
+ *
+ * The Pattern must only read the Email, and mustn't log, use the Buffer pool
+ * or talk to the user.  Searching the message text is only allowed for the raw
+ * Maildir and MH files, i.e. `$thorough_search` is unset.
+ */
+bool pattern_is_thread_safe(const struct Mailbox *m, const struct Pattern *pat)
+{
+  /* Group matching logs */
+  if (pat->group_match)
+    return false;
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      const struct Pattern *p = NULL;
+      SLIST_FOREACH(p, pat->child, entries)
+      {
+        if (!pattern_is_thread_safe(m, p))
+          return false;
+      }
+      return true;
+    }
+
+    case MUTT_ALL:
+    case MUTT_DELETED:
+    case MUTT_EXPIRED:
+    case MUTT_FLAG:
+    case MUTT_NEW:
+    case MUTT_OLD:
+    case MUTT_PAT_HORMEL:
+    case MUTT_PAT_ID:
+    case MUTT_PAT_ID_EXTERNAL:
+    case MUTT_PAT_MESSAGE:
+    case MUTT_PAT_NEWSGROUPS:
+    case MUTT_PAT_REFERENCE:
+    case MUTT_PAT_SCORE:
+    case MUTT_PAT_SIZE:
+    case MUTT_PAT_SUBJECT:
+    case MUTT_PAT_XLABEL:
+    case MUTT_READ:
+    case MUTT_REPLIED:
+    case MUTT_SUPERSEDED:
+    case MUTT_TAG:
+    case MUTT_UNREAD:
+      return true;
+
+    case MUTT_PAT_DATE:
+    case MUTT_PAT_DATE_RECEIVED:
+      return !pat->dynamic;
+
+    case MUTT_PAT_ADDRESS:
+    case MUTT_PAT_BCC:
+    case MUTT_PAT_CC:
+    case MUTT_PAT_FROM:
+    case MUTT_PAT_RECIPIENT:
+    case MUTT_PAT_SENDER:
+    case MUTT_PAT_TO:
+      return !pat->is_alias;
+
+    case MUTT_PAT_CRYPT_ENCRYPT:
+    case MUTT_PAT_CRYPT_SIGN:
+    case MUTT_PAT_CRYPT_VERIFIED:
+      return (WithCrypto != 0);
+
+    case MUTT_PAT_PGP_KEY:
+      return ((WithCrypto & APPLICATION_PGP) != 0);
+
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+      /* Decoding a message, for $thorough_search, runs the MIME parser and
+       * mutt_body_handler().  They use the Buffer pool, log, report errors,
+       * may ask for a passphrase and may run mailcap commands, so the
+       * decoded search stays on the main thread. */
+      if (pat->sendmode || !m || ((m->type != MUTT_MAILDIR) && (m->type != MUTT_MH)))
+        return false;
+      return !cs_subset_bool(NeoMutt->sub, "thorough_search");
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * pattern_exec_worker - Match a Pattern against an Email in a worker thread
+ * @param pat   Pattern to match, see pattern_is_thread_safe()
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param m     Mailbox, Maildir or MH
+ * @param e     Email
+ * @param cache Cache for common Patterns, owned by the worker
+ * @retval  1 Pattern matched
+ * @retval  0 Pattern did not match
+ * @retval -1 Message couldn't be read, the caller should use mutt_pattern_exec()
+ *
+ * The Mailbox backend isn't thread-safe, so the Message file is opened
+ * directly, and only if the Pattern will read it.
+ */
+int pattern_exec_worker(struct Pattern *pat, PatternExecFlags flags,
+                        struct Mailbox *m, struct Email *e, struct PatternCache *cache)
+{
+  flags |= MUTT_MATCH_WORKER;
+
+  struct Message local = { 0 };
+  struct Message *msg = NULL;
+  if (pattern_msg_wanted(pat, flags, m, e))
+  {
+    char path[PATH_MAX] = { 0 };
+    snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), NONULL(e->path));
+    local.fp = fopen(path, "r");
+    if (!local.fp)
+      return -1;
+    msg = &local;
+  }
+
+  const bool matched = pattern_exec(pat, flags, m, e, &msg, cache);
+
+  if (local.fp)
+    fclose(local.fp);
+
+  return matched;
+}
+
 /**
  * pattern_exec - Match a pattern against an email header
  * @param pat   Pattern to match
  * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
  * @param m     Mailbox
  * @param e     Email
- * @param msg   MEssage
+ * @param msg   Message, opened on demand
  * @param cache Cache for common Patterns
  * @retval true Success, pattern matched
  * @retval false Pattern did not match
@@ -844,7 +1058,7 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
  */
 static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
                          struct Mailbox *m, struct Email *e,
-                         struct Message *msg, struct PatternCache *cache)
+                         struct Message **msg, struct PatternCache *cache)
 {
   switch (pat->op)
   {
@@ -895,6 +1109,10 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
     case MUTT_PAT_BODY:
     case MUTT_PAT_HEADER:
     case MUTT_PAT_WHOLE_MSG:
+      /* Decoding a message, for $thorough_search, runs the MIME parser and
+       * mutt_body_handler().  They use the Buffer pool, log, report errors,
+       * may ask for a passphrase and may run mailcap commands, so the
+       * decoded search stays on the main thread. */
       if (pat->sendmode)
       {
         if (!e->body || !e->body->filename)
@@ -909,7 +1127,9 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       /* IMAP search sets e->matched at search compile time */
       if ((m->type == MUTT_IMAP) && pat->string_match)
         return e->matched;
-      return pat->pat_not ^ msg_search(pat, e, msg);
+      if (!pattern_msg_open(m, e, flags, msg))
+        return false;
+      return pat->pat_not ^ msg_search(pat, flags, e, *msg);
     case MUTT_PAT_SERVERSEARCH:
       if (!m)
         return false;
@@ -1110,14 +1330,16 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       return pat->pat_not ^ (e->thread && e->thread->duplicate_thread);
     case MUTT_PAT_MIMEATTACH:
     {
-      int count = msg ? mutt_count_body_parts(e, msg->fp) : 0;
+      int count = pattern_msg_open(m, e, flags, msg) ?
+                      mutt_count_body_parts(e, (*msg)->fp) :
+                      0;
       return pat->pat_not ^
              (count >= pat->min && (pat->max == MUTT_MAXRANGE || count <= pat->max));
     }
     case MUTT_PAT_MIMETYPE:
-      if (!m || !msg)
+      if (!pattern_msg_open(m, e, flags, msg))
         return false;
-      return pat->pat_not ^ match_mime_content_type(pat, e, msg->fp);
+      return pat->pat_not ^ match_mime_content_type(pat, e, (*msg)->fp);
     case MUTT_PAT_UNREFERENCED:
       return pat->pat_not ^ (e->thread && !e->thread->child);
     case MUTT_PAT_BROKEN:
@@ -1148,13 +1370,8 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
 bool mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
                        struct Mailbox *m, struct Email *e, struct PatternCache *cache)
 {
-  const bool needs_msg = pattern_needs_msg(m, pat);
-  struct Message *msg = needs_msg ? mx_msg_open(m, e) : NULL;
-  if (needs_msg && !msg)
-  {
-    return false;
-  }
-  const bool matched = pattern_exec(pat, flags, m, e, msg, cache);
+  struct Message *msg = NULL;
+  const bool matched = pattern_exec(pat, flags, m, e, &msg, cache);
   mx_msg_close(m, &msg);
   return matched;
 }
@@ -1198,6 +1415,8 @@ bool mutt_pattern_alias_exec(struct Pattern *pat, PatternExecFlags flags,
       return pat->pat_not ^ (perform_alias_and(pat->child, flags, av, cache) > 0);
     case MUTT_PAT_OR:
       return pat->pat_not ^ (perform_alias_or(pat->child, flags, av, cache) > 0);
+    case MUTT_ALL: /* e.g. `~f foo | ~A`, see pattern_optimize() */
+      return !pat->pat_not;
   }
 
   return false;
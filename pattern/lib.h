@@ -28,6 +28,7 @@
  *
  * | File                   | Description                   |
  * | :--------------------- | :---------------------------- |
+ * | pattern/bitmap.c       | @subpage pattern_bitmap       |
  * | pattern/compile.c      | @subpage pattern_compile      |
  * | pattern/complete.c     | @subpage pattern_complete     |
  * | pattern/config.c       | @subpage pattern_config       |
@@ -37,6 +38,7 @@
  * | pattern/flags.c        | @subpage pattern_flags        |
  * | pattern/functions.c    | @subpage pattern_functions    |
  * | pattern/message.c      | @subpage pattern_message      |
+ * | pattern/optimize.c     | @subpage pattern_optimize     |
  * | pattern/pattern.c      | @subpage pattern_pattern      |
  * | pattern/pattern_data.c | @subpage pattern_pattern_data |
  * | pattern/search_state.c | @subpage pattern_search_state |
@@ -104,6 +106,7 @@ SLIST_HEAD(PatternList, Pattern);
 typedef uint8_t PatternExecFlags;         ///< Flags for mutt_pattern_exec(), e.g. #MUTT_MATCH_FULL_ADDRESS
 #define MUTT_PAT_EXEC_NO_FLAGS         0  ///< No flags are set
 #define MUTT_MATCH_FULL_ADDRESS  (1 << 0) ///< Match the full address
+#define MUTT_MATCH_WORKER        (1 << 1) ///< Called from a worker thread, don't open Messages or use the UI
 
 /**
  * struct PatternCache - Cache commonly-used patterns
@@ -0,0 +1,350 @@
+/**
+ * @file
+ * Optimise a compiled Pattern
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_optimize Optimise a compiled Pattern
+ *
+ * mutt_pattern_comp() builds the Pattern tree in the order the user typed it.
+ * Evaluation of AND/OR stops at the first Pattern that decides the result, so
+ * the order matters: `~b foo ~N` would read the body of every message before
+ * checking the cheap "new" flag.
+ *
+ * This pass rewrites the tree, without changing its meaning:
+ * - Nested AND (or OR) lists are merged into their parent
+ * - Constant subtrees, e.g. `~A`, are folded away
+ * - Each AND/OR list is sorted by the cost of its Patterns, cheapest first
+ *
+ * Patterns of the same cost keep the order in which they were typed.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+
+/**
+ * enum PatternCost - Rough cost of evaluating a Pattern
+ *
+ * The values are ordered, cheapest first.
+ */
+enum PatternCost
+{
+  PAT_COST_FLAG,    ///< Test a flag or numeric field of the Email, e.g. `~N`, `~d`
+  PAT_COST_HEADER,  ///< Match a header string, e.g. `~s`, `~i`
+  PAT_COST_ADDRESS, ///< Match an Address list, e.g. `~f`, `~p`
+  PAT_COST_THREAD,  ///< Walk the thread, e.g. `~(...)`
+  PAT_COST_MESSAGE, ///< Read the message from the Mailbox, e.g. `~b`, `~X`
+};
+
+/**
+ * struct PatternCostEntry - A Pattern and its cost
+ */
+struct PatternCostEntry
+{
+  struct Pattern *pat;   ///< Pattern
+  enum PatternCost cost; ///< Cost of evaluating the Pattern
+};
+ARRAY_HEAD(PatternCostArray, struct PatternCostEntry);
+
+/**
+ * pattern_cost - Estimate the cost of evaluating a Pattern
+ * @param pat Pattern
+ * @param m   Mailbox, may be NULL
+ * @retval enum Cost class, e.g. #PAT_COST_HEADER
+ *
+ * The cost of an AND/OR is that of its most expensive child.
+ */
+static enum PatternCost pattern_cost(const struct Pattern *pat, const struct Mailbox *m)
+{
+  enum PatternCost cost = PAT_COST_HEADER;
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      cost = PAT_COST_FLAG;
+      const struct Pattern *np = NULL;
+      SLIST_FOREACH(np, pat->child, entries)
+      {
+        cost = MAX(cost, pattern_cost(np, m));
+      }
+      break;
+    }
+
+    case MUTT_PAT_THREAD:
+    case MUTT_PAT_PARENT:
+    case MUTT_PAT_CHILDREN:
+      cost = MAX(PAT_COST_THREAD, pattern_cost(SLIST_FIRST(pat->child), m));
+      break;
+
+    case MUTT_ALL:
+    case MUTT_EXPIRED:
+    case MUTT_SUPERSEDED:
+    case MUTT_FLAG:
+    case MUTT_TAG:
+    case MUTT_NEW:
+    case MUTT_UNREAD:
+    case MUTT_REPLIED:
+    case MUTT_OLD:
+    case MUTT_READ:
+    case MUTT_DELETED:
+    case MUTT_PAT_MESSAGE:
+    case MUTT_PAT_SCORE:
+    case MUTT_PAT_SIZE:
+    case MUTT_PAT_COLLAPSED:
+    case MUTT_PAT_CRYPT_SIGN:
+    case MUTT_PAT_CRYPT_VERIFIED:
+    case MUTT_PAT_CRYPT_ENCRYPT:
+    case MUTT_PAT_PGP_KEY:
+    case MUTT_PAT_DUPLICATED:
+    case MUTT_PAT_UNREFERENCED:
+    case MUTT_PAT_BROKEN:
+    case MUTT_PAT_SERVERSEARCH:
+      cost = PAT_COST_FLAG;
+      break;
+
+    case MUTT_PAT_DATE:
+    case MUTT_PAT_DATE_RECEIVED:
+      // Dynamic dates are re-parsed for every Email
+      cost = pat->dynamic ? PAT_COST_HEADER : PAT_COST_FLAG;
+      break;
+
+    case MUTT_PAT_FROM:
+    case MUTT_PAT_TO:
+    case MUTT_PAT_CC:
+    case MUTT_PAT_BCC:
+    case MUTT_PAT_SENDER:
+    case MUTT_PAT_ADDRESS:
+    case MUTT_PAT_RECIPIENT:
+    case MUTT_PAT_LIST:
+    case MUTT_PAT_SUBSCRIBED_LIST:
+    case MUTT_PAT_PERSONAL_RECIP:
+    case MUTT_PAT_PERSONAL_FROM:
+      cost = PAT_COST_ADDRESS;
+      break;
+
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+      // IMAP searches on the server and sets Email.matched in advance
+      if (m && (m->type == MUTT_IMAP) && pat->string_match && !pat->sendmode)
+        cost = PAT_COST_FLAG;
+      else
+        cost = PAT_COST_MESSAGE;
+      break;
+
+    case MUTT_PAT_MIMEATTACH:
+    case MUTT_PAT_MIMETYPE:
+      cost = PAT_COST_MESSAGE;
+      break;
+
+    default:
+      break;
+  }
+
+  return cost;
+}
+
+/**
+ * pattern_free_one - Free a single Pattern, and its children
+ * @param pat Pattern to free
+ *
+ * The Pattern must already have been removed from its list.
+ */
+static void pattern_free_one(struct Pattern *pat)
+{
+  struct PatternList *pl = MUTT_MEM_CALLOC(1, struct PatternList);
+  SLIST_INIT(pl);
+  SLIST_NEXT(pat, entries) = NULL;
+  SLIST_INSERT_HEAD(pl, pat, entries);
+  mutt_pattern_free(&pl);
+}
+
+/**
+ * pattern_set_const - Replace a Pattern with a constant
+ * @param pat   Pattern to replace
+ * @param value Value of the Pattern, before its `pat_not` is applied
+ *
+ * The Pattern becomes a `~A` (or `!~A`) with the same result.
+ */
+static void pattern_set_const(struct Pattern *pat, bool value)
+{
+  mutt_pattern_free(&pat->child);
+  pat->pat_not = !(pat->pat_not ^ value);
+  pat->op = MUTT_ALL;
+}
+
+/**
+ * pattern_hoist - Replace an AND/OR with its only child
+ * @param pat AND/OR Pattern with exactly one child
+ */
+static void pattern_hoist(struct Pattern *pat)
+{
+  struct PatternList *pl = pat->child;
+  struct Pattern *child = SLIST_FIRST(pl);
+  struct Pattern *next = SLIST_NEXT(pat, entries);
+
+#ifdef USE_DEBUG_GRAPHVIZ
+  FREE(&pat->raw_pattern);
+#endif
+  *pat = *child;
+  SLIST_NEXT(pat, entries) = next;
+
+  FREE(&child);
+  FREE(&pl);
+}
+
+/**
+ * pattern_collect - Optimise a list of Patterns and gather them in an Array
+ * @param pl   List of Patterns to gather, will be emptied
+ * @param op   Operation of the parent, #MUTT_PAT_AND or #MUTT_PAT_OR
+ * @param m    Mailbox, may be NULL
+ * @param pca  Array for the Patterns
+ *
+ * A child with the same operation as its parent is merged into the parent,
+ * e.g. `(a (b c))` becomes `(a b c)`.
+ */
+static void pattern_collect(struct PatternList *pl, short op,
+                            const struct Mailbox *m, struct PatternCostArray *pca)
+{
+  struct Pattern *np = SLIST_FIRST(pl);
+  SLIST_INIT(pl);
+
+  while (np)
+  {
+    struct Pattern *next = SLIST_NEXT(np, entries);
+    SLIST_NEXT(np, entries) = NULL;
+
+    pattern_optimize(np, m);
+
+    if ((np->op == op) && !np->pat_not)
+    {
+      // Its children have already been optimised and merged
+      struct Pattern *child = SLIST_FIRST(np->child);
+      while (child)
+      {
+        struct Pattern *child_next = SLIST_NEXT(child, entries);
+        SLIST_NEXT(child, entries) = NULL;
+        struct PatternCostEntry pce = { child, pattern_cost(child, m) };
+        ARRAY_ADD(pca, pce);
+        child = child_next;
+      }
+      SLIST_INIT(np->child);
+      pattern_free_one(np);
+    }
+    else
+    {
+      struct PatternCostEntry pce = { np, pattern_cost(np, m) };
+      ARRAY_ADD(pca, pce);
+    }
+
+    np = next;
+  }
+}
+
+/**
+ * pattern_optimize - Optimise a compiled Pattern
+ * @param pat Pattern to optimise
+ * @param m   Mailbox, may be NULL
+ *
+ * The Pattern is rewritten in place, see @ref pattern_optimize.
+ */
+void pattern_optimize(struct Pattern *pat, const struct Mailbox *m)
+{
+  if (!pat || !pat->child)
+    return;
+
+  if ((pat->op == MUTT_PAT_THREAD) || (pat->op == MUTT_PAT_PARENT) ||
+      (pat->op == MUTT_PAT_CHILDREN))
+  {
+    pattern_optimize(SLIST_FIRST(pat->child), m);
+    return;
+  }
+
+  if ((pat->op != MUTT_PAT_AND) && (pat->op != MUTT_PAT_OR))
+    return;
+
+  // An AND is decided by a false child, an OR by a true one
+  const bool decider = (pat->op == MUTT_PAT_OR);
+  bool decided = false;
+
+  struct PatternCostArray pca = ARRAY_HEAD_INITIALIZER;
+  pattern_collect(pat->child, pat->op, m, &pca);
+
+  // Fold the constants
+  struct PatternCostEntry *pce = NULL;
+  ARRAY_FOREACH(pce, &pca)
+  {
+    struct Pattern *np = pce->pat;
+    if (decided || (np->op != MUTT_ALL))
+      continue;
+
+    decided = ((!np->pat_not) == decider);
+    pattern_free_one(np);
+    pce->pat = NULL;
+  }
+
+  if (decided)
+  {
+    ARRAY_FOREACH(pce, &pca)
+    {
+      if (pce->pat)
+        pattern_free_one(pce->pat);
+    }
+    ARRAY_FREE(&pca);
+    pattern_set_const(pat, decider);
+    return;
+  }
+
+  // Stable insertion sort, cheapest first.  The lists are short.
+  struct PatternCostEntry *entries = ARRAY_GET(&pca, 0);
+  size_t count = 0;
+  for (size_t i = 0; i < ARRAY_SIZE(&pca); i++)
+  {
+    if (!entries[i].pat)
+      continue;
+
+    struct PatternCostEntry tmp = entries[i];
+    size_t j = count;
+    while ((j > 0) && (entries[j - 1].cost > tmp.cost))
+    {
+      entries[j] = entries[j - 1];
+      j--;
+    }
+    entries[j] = tmp;
+    count++;
+  }
+
+  for (size_t i = count; i > 0; i--)
+  {
+    SLIST_INSERT_HEAD(pat->child, entries[i - 1].pat, entries);
+  }
+  ARRAY_FREE(&pca);
+
+  if (count == 0)
+    pattern_set_const(pat, !decider);
+  else if ((count == 1) && !pat->pat_not)
+    pattern_hoist(pat);
+}
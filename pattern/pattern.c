@@ -31,8 +31,12 @@
  */
 
 #include "config.h"
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
 #include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -300,6 +304,173 @@ bail:
   return rc;
 }
 
+/// Number of messages read ahead by the worker threads at once
+#define PATTERN_PREFETCH_BATCH 256
+
+/**
+ * struct PrefetchJob - A batch of message files to be read by worker threads
+ */
+struct PrefetchJob
+{
+  char *paths[PATTERN_PREFETCH_BATCH]; ///< Paths of the message files
+  size_t count;                        ///< Number of files in the batch
+};
+
+/**
+ * prefetch_job - Read a message file - Implements ::worker_job_t - @ingroup worker_job_api
+ *
+ * The data is thrown away, it's only read so that it's in the page cache when
+ * the main thread opens the message.
+ */
+static void prefetch_job(size_t index, void *data)
+{
+  struct PrefetchJob *job = data;
+
+  int fd = open(job->paths[index], O_RDONLY);
+  if (fd < 0)
+    return;
+
+  char buf[16384];
+  while (read(fd, buf, sizeof(buf)) > 0)
+    ; // do nothing
+
+  close(fd);
+}
+
+/**
+ * prefetch_messages - Read a batch of messages ahead of the search
+ * @param pat     Pattern to match
+ * @param m       Mailbox
+ * @param first   Index of the first message
+ * @param virt    If true, the index is virtual, see mutt_get_virt_email()
+ * @param threads Number of threads to use
+ *
+ * Patterns that search the message text, e.g. `~b`, open every message in
+ * turn.  Reading the files in parallel first means the main thread doesn't
+ * have to wait for the disk.  Messages that the Pattern won't open, e.g. the
+ * old messages for `~N ~b foo`, are skipped.
+ */
+static void prefetch_messages(struct Pattern *pat, struct Mailbox *m, int first,
+                              bool virt, int threads)
+{
+  struct PrefetchJob job = { 0 };
+  struct Buffer *path = buf_pool_get();
+
+  const int last = virt ? m->vcount : m->msg_count;
+  for (int i = first; (i < last) && (job.count < PATTERN_PREFETCH_BATCH); i++)
+  {
+    struct Email *e = virt ? mutt_get_virt_email(m, i) : m->emails[i];
+    if (!e || !e->path)
+      continue;
+
+    if (!pattern_msg_wanted(pat, MUTT_MATCH_FULL_ADDRESS, m, e))
+      continue;
+
+    buf_concat_path(path, mailbox_path(m), e->path);
+    job.paths[job.count++] = buf_strdup(path);
+  }
+
+  mutt_worker_run(job.count, threads, prefetch_job, &job);
+
+  for (size_t i = 0; i < job.count; i++)
+    FREE(&job.paths[i]);
+  buf_pool_release(&path);
+}
+
+/// Number of Emails matched by a worker thread at once, a multiple of 64
+#define PATTERN_PARTITION_SIZE 256
+
+/**
+ * struct PartitionJob - Emails to be matched by worker threads
+ *
+ * Each partition covers whole words of the bitmaps, so the workers never
+ * write to the same word.
+ */
+struct PartitionJob
+{
+  struct Pattern *pat;    ///< Pattern to match
+  struct Mailbox *m;      ///< Mailbox
+  bool virt;              ///< If true, the indexes are virtual
+  int count;              ///< Number of Emails
+  uint64_t *matches;      ///< Bitmap of Emails that matched
+  uint64_t *retry;        ///< Bitmap of Emails that couldn't be read
+};
+
+/**
+ * partition_job - Match a partition of Emails - Implements ::worker_job_t - @ingroup worker_job_api
+ *
+ * Each worker has its own PatternCache and opens its own Message files.
+ */
+static void partition_job(size_t index, void *data)
+{
+  struct PartitionJob *job = data;
+  struct PatternCache cache = { 0 };
+
+  const int first = index * PATTERN_PARTITION_SIZE;
+  const int last = MIN(first + PATTERN_PARTITION_SIZE, job->count);
+  for (int i = first; i < last; i++)
+  {
+    if (SigInt)
+      return;
+
+    struct Email *e = job->virt ? mutt_get_virt_email(job->m, i) : job->m->emails[i];
+    if (!e)
+      continue;
+
+    memset(&cache, 0, sizeof(cache));
+    const int rc = pattern_exec_worker(job->pat, MUTT_MATCH_FULL_ADDRESS, job->m, e, &cache);
+    if (rc > 0)
+      job->matches[i / 64] |= (1ULL << (i % 64));
+    else if (rc < 0)
+      job->retry[i / 64] |= (1ULL << (i % 64));
+  }
+}
+
+/**
+ * pattern_exec_partitions - Match a Pattern against the Emails using worker threads
+ * @param pat     Pattern to match, see pattern_is_thread_safe()
+ * @param m       Mailbox
+ * @param virt    If true, match the visible Emails, see mutt_get_virt_email()
+ * @param threads Number of threads to use
+ * @retval ptr Bitmap of matching Emails, indexed like @a virt
+ *
+ * The Emails are split into partitions which are matched in parallel.
+ * Any Message that a worker couldn't read, e.g. a Maildir file that has been
+ * renamed, is matched by the main thread afterwards.
+ *
+ * @note The caller must free the bitmap
+ */
+static uint64_t *pattern_exec_partitions(struct Pattern *pat, struct Mailbox *m,
+                                         bool virt, int threads)
+{
+  const int count = virt ? m->vcount : m->msg_count;
+  const size_t words = (count + 63) / 64;
+
+  struct PartitionJob job = { 0 };
+  job.pat = pat;
+  job.m = m;
+  job.virt = virt;
+  job.count = count;
+  job.matches = MUTT_MEM_CALLOC(MAX(words, 1), uint64_t);
+  job.retry = MUTT_MEM_CALLOC(MAX(words, 1), uint64_t);
+
+  const size_t parts = (count + PATTERN_PARTITION_SIZE - 1) / PATTERN_PARTITION_SIZE;
+  mutt_worker_run(parts, threads, partition_job, &job);
+
+  for (int i = 0; (i < count) && !SigInt; i++)
+  {
+    if (!bitmap_test(job.retry, i))
+      continue;
+
+    struct Email *e = virt ? mutt_get_virt_email(m, i) : m->emails[i];
+    if (e && mutt_pattern_exec(pat, MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      job.matches[i / 64] |= (1ULL << (i % 64));
+  }
+
+  FREE(&job.retry);
+  return job.matches;
+}
+
 /**
  * mutt_pattern_func - Perform some Pattern matching
  * @param mv     Mailbox View
@@ -356,6 +527,23 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
   progress = progress_new(MUTT_PROGRESS_READ, (op == MUTT_LIMIT) ? m->msg_count : m->vcount);
   progress_set_message(progress, _("Executing command on matching messages..."));
 
+  /* A pattern that only tests flags can be matched in one go */
+  uint64_t *matches = match_all ? NULL : pattern_exec_bitmap(SLIST_FIRST(pat), m);
+
+  /* Messages stored one per file can be searched, or read ahead, by worker threads */
+  const short c_search_read_threads = cs_subset_number(NeoMutt->sub, "search_read_threads");
+  const bool use_threads = !match_all && !matches && (c_search_read_threads > 1) &&
+                           ((m->type == MUTT_MAILDIR) || (m->type == MUTT_MH)) &&
+                           pattern_needs_msg(m, SLIST_FIRST(pat));
+
+  uint64_t *found = NULL;
+  if (use_threads && pattern_is_thread_safe(m, SLIST_FIRST(pat)))
+  {
+    found = pattern_exec_partitions(SLIST_FIRST(pat), m, (op != MUTT_LIMIT),
+                                    c_search_read_threads);
+  }
+  const bool prefetch = use_threads && !found;
+
   if (op == MUTT_LIMIT)
   {
     m->vcount = 0;
@@ -376,6 +564,9 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
         break;
       }
       progress_update(progress, i, -1);
+      if (prefetch && ((i % PATTERN_PREFETCH_BATCH) == 0))
+        prefetch_messages(SLIST_FIRST(pat), m, i, false, c_search_read_threads);
+
       /* new limit pattern implicitly uncollapses all threads */
       e->vnum = -1;
       e->visible = false;
@@ -383,8 +574,15 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
       e->collapsed = false;
       e->num_hidden = 0;
 
-      if (match_all ||
-          mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      bool matched = match_all;
+      if (!matched && matches)
+        matched = bitmap_test(matches, i);
+      else if (!matched && found)
+        matched = bitmap_test(found, i);
+      else if (!matched)
+        matched = mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL);
+
+      if (matched)
       {
         e->vnum = m->vcount;
         e->visible = true;
@@ -410,7 +608,18 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
         break;
       }
       progress_update(progress, i, -1);
-      if (mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      if (prefetch && ((i % PATTERN_PREFETCH_BATCH) == 0))
+        prefetch_messages(SLIST_FIRST(pat), m, i, true, c_search_read_threads);
+
+      bool matched;
+      if (matches)
+        matched = bitmap_test(matches, m->v2r[i]);
+      else if (found)
+        matched = bitmap_test(found, i);
+      else
+        matched = mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL);
+
+      if (matched)
       {
         switch (op)
         {
@@ -430,6 +639,8 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
     }
   }
   progress_free(&progress);
+  FREE(&matches);
+  FREE(&found);
 
   mutt_clear_error();
 
@@ -24,10 +24,12 @@
 #define MUTT_PATTERN_PRIVATE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "mutt/lib.h"
 #include "email/lib.h"
 #include "lib.h"
 
+struct Mailbox;
 struct MailboxView;
 
 /**
@@ -138,6 +140,17 @@ static inline int email_msgno(struct Email *e)
   return e->msgno + 1;
 }
 
+/**
+ * bitmap_test - Test a bit in a bitmap
+ * @param bitmap Bitmap
+ * @param i      Index of the bit
+ * @retval true The bit is set
+ */
+static inline bool bitmap_test(const uint64_t *bitmap, int i)
+{
+  return (bitmap[i / 64] >> (i % 64)) & 1;
+}
+
 #define MUTT_MAXRANGE -1
 
 extern struct RangeRegex RangeRegexes[];
@@ -147,5 +160,11 @@ const struct PatternFlags *lookup_op(int op);
 const struct PatternFlags *lookup_tag(char tag);
 bool eval_date_minmax(struct Pattern *pat, const char *s, struct Buffer *err);
 bool eat_message_range(struct Pattern *pat, PatternCompFlags flags, struct Buffer *s, struct Buffer *err, struct MailboxView *mv);
+bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat);
+bool pattern_msg_wanted(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m, struct Email *e);
+bool pattern_is_thread_safe(const struct Mailbox *m, const struct Pattern *pat);
+int  pattern_exec_worker(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m, struct Email *e, struct PatternCache *cache);
+uint64_t *pattern_exec_bitmap(const struct Pattern *pat, struct Mailbox *m);
+void pattern_optimize(struct Pattern *pat, const struct Mailbox *m);
 
 #endif /* MUTT_PATTERN_PRIVATE_H */
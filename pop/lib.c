@@ -512,53 +512,38 @@ int pop_fetch_data(struct PopAccountData *adata, const char *query,
 {
   char buf[1024] = { 0 };
   long pos = 0;
-  size_t lenbuf = 0;
 
   mutt_str_copy(buf, query, sizeof(buf));
   int rc = pop_query(adata, buf, sizeof(buf));
   if (rc < 0)
     return rc;
 
-  char *inbuf = MUTT_MEM_MALLOC(sizeof(buf), char);
+  struct Buffer *line = buf_pool_get();
 
   while (true)
   {
-    const int chunk = mutt_socket_readln_d(buf, sizeof(buf), adata->conn, MUTT_SOCK_LOG_FULL);
-    if (chunk < 0)
+    if (mutt_socket_buffer_readln_d(line, adata->conn, MUTT_SOCK_LOG_FULL) < 0)
     {
       adata->status = POP_DISCONNECTED;
       rc = -1;
       break;
     }
 
-    char *p = buf;
-    if (!lenbuf && (buf[0] == '.'))
+    char *p = line->data;
+    if (p[0] == '.')
     {
-      if (buf[1] != '.')
+      if (p[1] != '.')
         break;
       p++;
     }
 
-    mutt_str_copy(inbuf + lenbuf, p, sizeof(buf));
-    pos += chunk;
-
-    /* cast is safe since we break out of the loop when chunk<=0 */
-    if ((size_t) chunk >= sizeof(buf))
-    {
-      lenbuf += strlen(p);
-    }
-    else
-    {
-      progress_update(progress, pos, -1);
-      if ((rc == 0) && (callback(inbuf, data) < 0))
-        rc = -3;
-      lenbuf = 0;
-    }
-
-    MUTT_MEM_REALLOC(&inbuf, lenbuf + sizeof(buf), char);
+    pos += buf_len(line) + 1;
+    progress_update(progress, pos, -1);
+    if ((rc == 0) && (callback(p, data) < 0))
+      rc = -3;
   }
 
-  FREE(&inbuf);
+  buf_pool_release(&line);
   return rc;
 }
 
@@ -330,6 +330,7 @@ static int pop_fetch_headers(struct Mailbox *m)
 
 #ifdef USE_HCACHE
   struct HeaderCache *hc = pop_hcache_open(adata, mailbox_path(m));
+  hcache_begin_batch(hc);
 #endif
 
   adata->check_time = mutt_date_now();
@@ -1075,6 +1076,7 @@ static bool pop_msg_open(struct Mailbox *m, struct Message *msg, struct Email *e
    * portion of the headers, those required for the main display.  */
   if (bcache)
   {
+    fflush(msg->fp);
     mutt_bcache_commit(adata->bcache, cache_id(edata->uid));
   }
   else
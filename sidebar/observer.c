@@ -230,9 +230,13 @@ static int sb_color_observer(struct NotifyCallback *nc)
     case MT_COLOR_SIDEBAR_SPOOLFILE:
     case MT_COLOR_SIDEBAR_UNREAD:
     case MT_COLOR_MAX: // Sent on `uncolor *`
+    {
+      struct SidebarWindowData *wdata = sb_wdata_get(win);
+      wdata->repaint_all = true;
       win->actions |= WA_REPAINT;
       mutt_debug(LL_DEBUG5, "color done, request WA_REPAINT\n");
       break;
+    }
 
     default:
       break;
@@ -305,8 +309,11 @@ static int sb_config_observer(struct NotifyCallback *nc)
     return 0;
   }
 
+  struct SidebarWindowData *wdata = sb_wdata_get(win);
+
   if (mutt_str_equal(ev_c->name, "spool_file"))
   {
+    wdata->repaint_all = true;
     win->actions |= WA_REPAINT;
     mutt_debug(LL_DEBUG5, "config done, request WA_REPAINT\n");
     return 0;
@@ -333,14 +340,15 @@ static int sb_config_observer(struct NotifyCallback *nc)
   if (mutt_str_equal(ev_c->name, "ascii_chars") ||
       mutt_str_equal(ev_c->name, "sidebar_divider_char"))
   {
-    struct SidebarWindowData *wdata = sb_wdata_get(win);
     calc_divider(wdata);
+    wdata->repaint_all = true;
     win->actions |= WA_RECALC;
     mutt_debug(LL_DEBUG5, "config done, request WA_RECALC\n");
     return 0;
   }
 
   // All the remaining config changes...
+  sb_invalidate_entries(wdata);
   win->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "config done, request WA_RECALC\n");
   return 0;
@@ -416,6 +424,8 @@ static int sb_window_observer(struct NotifyCallback *nc)
 
   if (nc->event_subtype == NT_WINDOW_STATE)
   {
+    struct SidebarWindowData *wdata = sb_wdata_get(win);
+    wdata->repaint_all = true;
     win->actions |= WA_RECALC;
     mutt_debug(LL_DEBUG5, "window state done, request WA_RECALC\n");
   }
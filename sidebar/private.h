@@ -34,6 +34,31 @@ struct MuttWindow;
 
 extern struct ListHead SidebarPinned;
 
+/// Re-sort all the entries if more than this many have changed
+#define SB_RESORT_MAX 16
+
+/**
+ * struct SbStats - Mailbox data that affects a Sidebar entry
+ *
+ * Each SbEntry keeps a copy, so that sb_recalc() can tell which entries have
+ * changed, without relying on notifications.
+ */
+struct SbStats
+{
+  int msg_count;      ///< Mailbox.msg_count
+  int msg_unread;     ///< Mailbox.msg_unread
+  int msg_flagged;    ///< Mailbox.msg_flagged
+  int msg_new;        ///< Mailbox.msg_new
+  int msg_deleted;    ///< Mailbox.msg_deleted, of the open Mailbox
+  int msg_tagged;     ///< Mailbox.msg_tagged, of the open Mailbox
+  int vcount;         ///< Mailbox.vcount, of the open Mailbox
+  const char *name;   ///< Mailbox.name
+  bool has_new;       ///< Mailbox.has_new
+  bool notify_user;   ///< Mailbox.notify_user
+  bool poll_new_mail; ///< Mailbox.poll_new_mail
+  bool is_open;       ///< Mailbox is open in the Index
+};
+
 /**
  * struct SbEntry - Info about folders in the sidebar
  */
@@ -45,6 +70,10 @@ struct SbEntry
   struct Mailbox *mailbox;        ///< Mailbox this represents
   bool is_hidden;                 ///< Don't show, e.g. $sidebar_new_mail_only
   const struct AttrColor *color;  ///< Colour to use
+  struct SbStats stats;           ///< Mailbox data when the entry was last checked
+  bool path_valid;                ///< box and depth are up to date
+  bool display_valid;             ///< display is up to date
+  bool painted;                   ///< display has been painted, with color
 };
 ARRAY_HEAD(SbEntryArray, struct SbEntry *);
 
@@ -89,6 +118,7 @@ struct SidebarWindowData
   struct MuttWindow *win;                 ///< Sidebar Window
   struct IndexSharedData *shared;         ///< Shared Index Data
   struct SbEntryArray entries;            ///< Items to display in the sidebar
+  struct SbEntryArray rows;               ///< Entries painted on each row of the Window
 
   int top_index;             ///< First mailbox visible in sidebar
   int opn_index;             ///< Current (open) mailbox
@@ -96,12 +126,16 @@ struct SidebarWindowData
   int bot_index;             ///< Last mailbox visible in sidebar
 
   short previous_sort;       ///< Old `$sidebar_sort`
+  bool resort;               ///< All the entries need sorting, e.g. a Mailbox was added
+  bool repaint_all;          ///< All the rows need repainting, e.g. the Window moved
+  int display_cols;          ///< Width the entries were formatted for
   enum DivType divider_type; ///< Type of divider to use, e.g. #SB_DIV_ASCII
   short divider_width;       ///< Width of the divider in screen columns
 };
 
 // sidebar.c
 void sb_add_mailbox        (struct SidebarWindowData *wdata, struct Mailbox *m);
+void sb_invalidate_entries (struct SidebarWindowData *wdata);
 void sb_remove_mailbox     (struct SidebarWindowData *wdata, const struct Mailbox *m);
 void sb_set_current_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m);
 struct Mailbox *sb_get_highlight(struct MuttWindow *win);
@@ -119,6 +153,7 @@ int sb_insertion_window_observer(struct NotifyCallback *nc);
 void sb_win_add_observers(struct MuttWindow *win);
 
 // sort.c
+int  sb_sort_entry  (struct SidebarWindowData *wdata, enum EmailSortType sort, int idx);
 void sb_sort_entries(struct SidebarWindowData *wdata, enum EmailSortType sort);
 
 // wdata.c
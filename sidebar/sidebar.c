@@ -118,6 +118,25 @@ void sb_add_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
   }
 
   ARRAY_ADD(&wdata->entries, entry);
+  wdata->resort = true;
+}
+
+/**
+ * sb_invalidate_entries - Discard the cached paths and strings of all entries
+ * @param wdata Sidebar data
+ *
+ * This is needed when the config that controls them changes, e.g. $folder.
+ */
+void sb_invalidate_entries(struct SidebarWindowData *wdata)
+{
+  struct SbEntry **sbep = NULL;
+  ARRAY_FOREACH(sbep, &wdata->entries)
+  {
+    (*sbep)->path_valid = false;
+    (*sbep)->display_valid = false;
+  }
+
+  wdata->repaint_all = true;
 }
 
 /**
@@ -31,6 +31,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 #include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -148,43 +149,86 @@ static int sb_sort_unsorted(const void *a, const void *b, void *sdata)
 }
 
 /**
- * sb_sort_entries - Sort the Sidebar entries
- * @param wdata Sidebar data
- * @param sort  Sort order, e.g. #SB_SORT_PATH
- *
- * Sort the `wdata->entries` array according to the current sort config option
- * `$sidebar_sort`. This calls qsort to do the work which calls our
- * callback function "cb_qsort_sbe".
- *
- * Once sorted, the prev/next links will be reconstructed.
+ * sb_sort_fn - Get the compare function for a Sidebar sort order
+ * @param sort Sort order, e.g. #SB_SORT_PATH
+ * @retval ptr Compare function
  */
-void sb_sort_entries(struct SidebarWindowData *wdata, enum EmailSortType sort)
+static sort_t sb_sort_fn(enum EmailSortType sort)
 {
-  sort_t fn = NULL;
-
   switch (sort & SORT_MASK)
   {
     case SB_SORT_COUNT:
-      fn = sb_sort_count;
-      break;
+      return sb_sort_count;
     case SB_SORT_DESC:
-      fn = sb_sort_desc;
-      break;
+      return sb_sort_desc;
     case SB_SORT_FLAGGED:
-      fn = sb_sort_flagged;
-      break;
+      return sb_sort_flagged;
     case SB_SORT_PATH:
-      fn = sb_sort_path;
-      break;
+      return sb_sort_path;
     case SB_SORT_UNREAD:
-      fn = sb_sort_unread;
-      break;
+      return sb_sort_unread;
     case SB_SORT_UNSORTED:
     default:
-      fn = sb_sort_unsorted;
-      break;
+      return sb_sort_unsorted;
+  }
+}
+
+/**
+ * sb_sort_entry - Move one Sidebar entry to its place in the sorted order
+ * @param wdata Sidebar data
+ * @param sort  Sort order, e.g. #SB_SORT_PATH
+ * @param idx   Index of the entry that has changed
+ * @retval num New index of the entry
+ *
+ * The other entries must already be sorted.  The new position is found with a
+ * binary search, so one changed Mailbox doesn't cause a full re-sort.
+ */
+int sb_sort_entry(struct SidebarWindowData *wdata, enum EmailSortType sort, int idx)
+{
+  const int count = ARRAY_SIZE(&wdata->entries);
+  if ((idx < 0) || (idx >= count))
+    return idx;
+
+  sort_t fn = sb_sort_fn(sort);
+  bool sort_reverse = (sort & SORT_REVERSE);
+  struct SbEntry **entries = wdata->entries.entries;
+  struct SbEntry *sbe = entries[idx];
+
+  // Find the first of the other entries that sorts after this one
+  int lo = 0;
+  int hi = count - 1;
+  while (lo < hi)
+  {
+    const int mid = lo + ((hi - lo) / 2);
+    struct SbEntry **sbep = &entries[(mid < idx) ? mid : mid + 1];
+    if (fn(&sbe, sbep, &sort_reverse) < 0)
+      hi = mid;
+    else
+      lo = mid + 1;
   }
 
+  if (lo < idx)
+    memmove(&entries[lo + 1], &entries[lo], (idx - lo) * sizeof(*entries));
+  else if (lo > idx)
+    memmove(&entries[idx], &entries[idx + 1], (lo - idx) * sizeof(*entries));
+
+  entries[lo] = sbe;
+  return lo;
+}
+
+/**
+ * sb_sort_entries - Sort the Sidebar entries
+ * @param wdata Sidebar data
+ * @param sort  Sort order, e.g. #SB_SORT_PATH
+ *
+ * Sort the `wdata->entries` array according to the current sort config option
+ * `$sidebar_sort`. This calls qsort to do the work which calls our
+ * callback function "cb_qsort_sbe".
+ *
+ * Once sorted, the prev/next links will be reconstructed.
+ */
+void sb_sort_entries(struct SidebarWindowData *wdata, enum EmailSortType sort)
+{
   bool sort_reverse = (sort & SORT_REVERSE);
-  ARRAY_SORT(&wdata->entries, fn, &sort_reverse);
+  ARRAY_SORT(&wdata->entries, sb_sort_fn(sort), &sort_reverse);
 }
@@ -47,6 +47,9 @@ struct SidebarWindowData *sb_wdata_new(struct MuttWindow *win, struct IndexShare
   wdata->win = win;
   wdata->shared = shared;
   ARRAY_INIT(&wdata->entries);
+  ARRAY_INIT(&wdata->rows);
+  wdata->resort = true;
+  wdata->repaint_all = true;
   return wdata;
 }
 
@@ -66,6 +69,7 @@ void sb_wdata_free(struct MuttWindow *win, void **ptr)
     FREE(sbep);
   }
   ARRAY_FREE(&wdata->entries);
+  ARRAY_FREE(&wdata->rows);
 
   FREE(ptr);
 }
@@ -405,6 +405,119 @@ static void update_entries_visibility(struct SidebarWindowData *wdata)
   }
 }
 
+/**
+ * stats_get - Get the Mailbox data that affects a Sidebar entry
+ * @param[out] stats Mailbox data
+ * @param[in]  m     Mailbox
+ * @param[in]  m_cur Mailbox open in the Index, may be NULL
+ */
+static void stats_get(struct SbStats *stats, const struct Mailbox *m,
+                      const struct Mailbox *m_cur)
+{
+  stats->is_open = m_cur && ((m == m_cur) || mutt_str_equal(m->realpath, m_cur->realpath));
+
+  const struct Mailbox *m_open = stats->is_open ? m_cur : m;
+
+  stats->msg_count = m->msg_count;
+  stats->msg_unread = m->msg_unread;
+  stats->msg_flagged = m->msg_flagged;
+  stats->msg_new = m->msg_new;
+  stats->msg_deleted = m_open->msg_deleted;
+  stats->msg_tagged = m_open->msg_tagged;
+  stats->vcount = m_open->vcount;
+  stats->name = m->name;
+  stats->has_new = m->has_new;
+  stats->notify_user = m->notify_user;
+  stats->poll_new_mail = m->poll_new_mail;
+}
+
+/**
+ * stats_equal - Compare two sets of Sidebar Mailbox data
+ * @param a First set
+ * @param b Second set
+ * @retval true They are equal
+ */
+static bool stats_equal(const struct SbStats *a, const struct SbStats *b)
+{
+  return (a->msg_count == b->msg_count) && (a->msg_unread == b->msg_unread) &&
+         (a->msg_flagged == b->msg_flagged) && (a->msg_new == b->msg_new) &&
+         (a->msg_deleted == b->msg_deleted) && (a->msg_tagged == b->msg_tagged) &&
+         (a->vcount == b->vcount) && (a->name == b->name) &&
+         (a->has_new == b->has_new) && (a->notify_user == b->notify_user) &&
+         (a->poll_new_mail == b->poll_new_mail) && (a->is_open == b->is_open);
+}
+
+/**
+ * update_entries_stats - Find the SbEntry's whose Mailboxes have changed
+ * @param[in]  wdata   Sidebar data
+ * @param[out] changed Entries that have changed
+ *
+ * The changed entries will need formatting again, and may need to move within
+ * the sort order.
+ */
+static void update_entries_stats(struct SidebarWindowData *wdata, struct SbEntryArray *changed)
+{
+  struct Mailbox *m_cur = wdata->shared->mailbox;
+
+  struct SbEntry **sbep = NULL;
+  ARRAY_FOREACH(sbep, &wdata->entries)
+  {
+    struct SbEntry *sbe = *sbep;
+    struct Mailbox *m = sbe->mailbox;
+
+    if (m_cur && (m != m_cur) && (m_cur->realpath[0] != '\0') &&
+        mutt_str_equal(m->realpath, m_cur->realpath))
+    {
+      m->msg_unread = m_cur->msg_unread;
+      m->msg_count = m_cur->msg_count;
+      m->msg_flagged = m_cur->msg_flagged;
+    }
+
+    struct SbStats stats = { 0 };
+    stats_get(&stats, m, m_cur);
+    if (stats_equal(&stats, &sbe->stats))
+      continue;
+
+    sbe->stats = stats;
+    sbe->display_valid = false;
+    ARRAY_ADD(changed, sbe);
+  }
+}
+
+/**
+ * sort_entries - Sort the SbEntry's, doing as little work as possible
+ * @param wdata   Sidebar data
+ * @param sort    Sort order, e.g. #SB_SORT_PATH
+ * @param changed Entries whose Mailboxes have changed
+ *
+ * If only a few entries have changed, they're moved to their new positions.
+ */
+static void sort_entries(struct SidebarWindowData *wdata, enum EmailSortType sort,
+                         struct SbEntryArray *changed)
+{
+  if (wdata->resort || (sort != wdata->previous_sort) ||
+      (ARRAY_SIZE(changed) > SB_RESORT_MAX))
+  {
+    sb_sort_entries(wdata, sort);
+    wdata->resort = false;
+    return;
+  }
+
+  struct SbEntry **sbep_changed = NULL;
+  ARRAY_FOREACH(sbep_changed, changed)
+  {
+    struct SbEntry **sbep = NULL;
+    ARRAY_FOREACH(sbep, &wdata->entries)
+    {
+      if (*sbep != *sbep_changed)
+        continue;
+
+      sb_sort_entry(wdata, sort, ARRAY_FOREACH_IDX_sbep);
+      break;
+    }
+  }
+}
+
 /**
  * prepare_sidebar - Prepare the list of SbEntry's for the sidebar display
  * @param wdata     Sidebar data
@@ -415,8 +528,9 @@ static void update_entries_visibility(struct SidebarWindowData *wdata)
  * Before painting the sidebar, we determine which are visible, sort
  * them and set up our page pointers.
  *
- * This is a lot of work to do each refresh, but there are many things that
- * can change outside of the sidebar that we don't hear about.
+ * There are many things that can change outside of the sidebar that we don't
+ * hear about, so every Mailbox is checked.  Only the entries that have changed
+ * are re-sorted and re-formatted.
  */
 static bool prepare_sidebar(struct SidebarWindowData *wdata, int page_size)
 {
@@ -432,9 +546,12 @@ static bool prepare_sidebar(struct SidebarWindowData *wdata, int page_size)
   sbep = (wdata->hil_index >= 0) ? ARRAY_GET(&wdata->entries, wdata->hil_index) : NULL;
   const struct SbEntry *hil_entry = sbep ? *sbep : NULL;
 
+  struct SbEntryArray changed = ARRAY_HEAD_INITIALIZER;
+  update_entries_stats(wdata, &changed);
   update_entries_visibility(wdata);
   const enum EmailSortType c_sidebar_sort = cs_subset_sort(NeoMutt->sub, "sidebar_sort");
-  sb_sort_entries(wdata, c_sidebar_sort);
+  sort_entries(wdata, c_sidebar_sort, &changed);
+  ARRAY_FREE(&changed);
 
   if (opn_entry || hil_entry)
   {
@@ -500,6 +617,55 @@ static bool prepare_sidebar(struct SidebarWindowData *wdata, int page_size)
   return (wdata->hil_index >= 0);
 }
 
+/**
+ * update_entry_path - Calculate the abbreviated path and depth of a SbEntry
+ * @param entry Sidebar entry
+ *
+ * These only depend on the Mailbox's path and the config, so they're cached.
+ *
+ * @sa sb_invalidate_entries()
+ */
+static void update_entry_path(struct SbEntry *entry)
+{
+  struct Mailbox *m = entry->mailbox;
+  const char *path = mailbox_path(m);
+
+  const char *const c_folder = cs_subset_string(NeoMutt->sub, "folder");
+  // Try to abbreviate the full path
+  const char *abbr = abbrev_folder(path, c_folder, m->type);
+  if (!abbr)
+    abbr = abbrev_url(path, m->type);
+  const char *short_path = abbr ? abbr : path;
+
+  /* Compute the depth */
+  const char *last_part = abbr;
+  const char *const c_sidebar_delim_chars = cs_subset_string(NeoMutt->sub, "sidebar_delim_chars");
+  entry->depth = calc_path_depth(abbr, c_sidebar_delim_chars, &last_part);
+
+  const bool short_path_is_abbr = (short_path == abbr);
+  const bool c_sidebar_short_path = cs_subset_bool(NeoMutt->sub, "sidebar_short_path");
+  if (c_sidebar_short_path)
+  {
+    short_path = last_part;
+  }
+
+  // Don't indent if we were unable to create an abbreviation.
+  // Otherwise, the full path will be indent, and it looks unusual.
+  const bool c_sidebar_folder_indent = cs_subset_bool(NeoMutt->sub, "sidebar_folder_indent");
+  if (c_sidebar_folder_indent && short_path_is_abbr)
+  {
+    const short c_sidebar_component_depth = cs_subset_number(NeoMutt->sub, "sidebar_component_depth");
+    if (c_sidebar_component_depth > 0)
+      entry->depth -= c_sidebar_component_depth;
+  }
+  else if (!c_sidebar_folder_indent)
+  {
+    entry->depth = 0;
+  }
+
+  mutt_str_copy(entry->box, short_path, sizeof(entry->box));
+}
+
 /**
  * sb_recalc - Recalculate the Sidebar display - Implements MuttWindow::recalc() - @ingroup window_recalc
  */
@@ -507,6 +673,7 @@ int sb_recalc(struct MuttWindow *win)
 {
   struct SidebarWindowData *wdata = sb_wdata_get(win);
   struct IndexSharedData *shared = wdata->shared;
+  const int old_top = wdata->top_index;
 
   if (ARRAY_EMPTY(&wdata->entries))
   {
@@ -536,9 +703,18 @@ int sb_recalc(struct MuttWindow *win)
   if (wdata->top_index < 0)
     return 0;
 
+  // Everything has moved
+  if (wdata->top_index != old_top)
+    wdata->repaint_all = true;
+
   int width = num_cols - wdata->divider_width;
+  if (width != wdata->display_cols)
+  {
+    sb_invalidate_entries(wdata);
+    wdata->display_cols = width;
+  }
+
   int row = 0;
-  struct Mailbox *m_cur = shared->mailbox;
   struct SbEntry **sbep = NULL;
   ARRAY_FOREACH_FROM(sbep, &wdata->entries, wdata->top_index)
   {
@@ -552,54 +728,27 @@ int sb_recalc(struct MuttWindow *win)
     struct Mailbox *m = entry->mailbox;
 
     const int entryidx = ARRAY_FOREACH_IDX_sbep;
-    entry->color = calc_color(m, (entryidx == wdata->opn_index),
-                              (entryidx == wdata->hil_index));
-
-    if (m_cur && (m_cur->realpath[0] != '\0') &&
-        mutt_str_equal(m->realpath, m_cur->realpath))
+    const struct AttrColor *color = calc_color(m, (entryidx == wdata->opn_index),
+                                               (entryidx == wdata->hil_index));
+    if (color != entry->color)
     {
-      m->msg_unread = m_cur->msg_unread;
-      m->msg_count = m_cur->msg_count;
-      m->msg_flagged = m_cur->msg_flagged;
+      entry->color = color;
+      entry->painted = false;
     }
 
-    const char *path = mailbox_path(m);
-
-    const char *const c_folder = cs_subset_string(NeoMutt->sub, "folder");
-    // Try to abbreviate the full path
-    const char *abbr = abbrev_folder(path, c_folder, m->type);
-    if (!abbr)
-      abbr = abbrev_url(path, m->type);
-    const char *short_path = abbr ? abbr : path;
-
-    /* Compute the depth */
-    const char *last_part = abbr;
-    const char *const c_sidebar_delim_chars = cs_subset_string(NeoMutt->sub, "sidebar_delim_chars");
-    entry->depth = calc_path_depth(abbr, c_sidebar_delim_chars, &last_part);
-
-    const bool short_path_is_abbr = (short_path == abbr);
-    const bool c_sidebar_short_path = cs_subset_bool(NeoMutt->sub, "sidebar_short_path");
-    if (c_sidebar_short_path)
+    if (!entry->path_valid)
     {
-      short_path = last_part;
+      update_entry_path(entry);
+      entry->path_valid = true;
+      entry->display_valid = false;
     }
 
-    // Don't indent if we were unable to create an abbreviation.
-    // Otherwise, the full path will be indent, and it looks unusual.
-    const bool c_sidebar_folder_indent = cs_subset_bool(NeoMutt->sub, "sidebar_folder_indent");
-    if (c_sidebar_folder_indent && short_path_is_abbr)
-    {
-      const short c_sidebar_component_depth = cs_subset_number(NeoMutt->sub, "sidebar_component_depth");
-      if (c_sidebar_component_depth > 0)
-        entry->depth -= c_sidebar_component_depth;
-    }
-    else if (!c_sidebar_folder_indent)
+    if (!entry->display_valid)
     {
-      entry->depth = 0;
+      make_sidebar_entry(entry->display, sizeof(entry->display), width, entry, shared);
+      entry->display_valid = true;
+      entry->painted = false;
     }
-
-    mutt_str_copy(entry->box, short_path, sizeof(entry->box));
-    make_sidebar_entry(entry->display, sizeof(entry->display), width, entry, shared);
     row++;
   }
 
@@ -691,6 +840,9 @@ static void fill_empty_space(struct MuttWindow *win, int first_row,
 
 /**
  * sb_repaint - Repaint the Sidebar display - Implements MuttWindow::repaint() - @ingroup window_repaint
+ *
+ * Only the rows that have changed since the last repaint are painted, unless
+ * SidebarWindowData::repaint_all is set.
  */
 int sb_repaint(struct MuttWindow *win)
 {
@@ -700,6 +852,11 @@ int sb_repaint(struct MuttWindow *win)
   int row = 0;
   int num_rows = win->state.rows;
   int num_cols = win->state.cols;
+  const bool repaint_all = wdata->repaint_all;
+  const int old_rows = repaint_all ? num_rows : ARRAY_SIZE(&wdata->rows);
+
+  if (repaint_all)
+    ARRAY_SHRINK(&wdata->rows, ARRAY_SIZE(&wdata->rows));
 
   if (wdata->top_index >= 0)
   {
@@ -717,18 +874,35 @@ int sb_repaint(struct MuttWindow *win)
         continue;
 
       struct SbEntry *entry = (*sbep);
+      struct SbEntry **sbep_row = ARRAY_GET(&wdata->rows, row);
+      if (sbep_row && (*sbep_row == entry) && entry->painted)
+      {
+        row++;
+        continue;
+      }
+
       mutt_window_move(win, row, col);
       mutt_curses_set_color(entry->color);
       mutt_window_printf(win, "%s", entry->display);
-      mutt_refresh();
+      entry->painted = true;
+      ARRAY_SET(&wdata->rows, row, entry);
       row++;
     }
   }
 
-  fill_empty_space(win, row, num_rows - row, wdata->divider_width,
-                   num_cols - wdata->divider_width);
-  draw_divider(wdata, win, num_rows, num_cols);
+  if (ARRAY_SIZE(&wdata->rows) > row)
+    ARRAY_SHRINK(&wdata->rows, ARRAY_SIZE(&wdata->rows) - row);
+
+  if (old_rows > row)
+  {
+    fill_empty_space(win, row, MIN(old_rows, num_rows) - row, wdata->divider_width,
+                     num_cols - wdata->divider_width);
+  }
+
+  if (repaint_all)
+    draw_divider(wdata, win, num_rows, num_cols);
 
-  mutt_debug(LL_DEBUG5, "repaint done\n");
+  wdata->repaint_all = false;
+  mutt_debug(LL_DEBUG5, "repaint done, %s\n", repaint_all ? "all rows" : "changed rows");
   return 0;
 }
@@ -250,6 +250,33 @@ static int store_bdb_delete_record(StoreHandle *store, const char *key, size_t k
   return sdata->db->del(sdata->db, NULL, &dkey, 0);
 }
 
+/**
+ * store_bdb_begin_batch - Start a batch of writes - Implements StoreOps::begin_batch() - @ingroup store_begin_batch
+ *
+ * The environment is opened without DB_INIT_TXN, so there are no transactions.
+ */
+static int store_bdb_begin_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  return 0;
+}
+
+/**
+ * store_bdb_commit_batch - Commit a batch of writes - Implements StoreOps::commit_batch() - @ingroup store_commit_batch
+ */
+static int store_bdb_commit_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct BdbStoreData *sdata = store;
+
+  return sdata->db->sync(sdata->db, 0);
+}
+
 /**
  * store_bdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -131,6 +131,34 @@ static int store_gdbm_delete_record(StoreHandle *store, const char *key, size_t
   return gdbm_delete(db, dkey);
 }
 
+/**
+ * store_gdbm_begin_batch - Start a batch of writes - Implements StoreOps::begin_batch() - @ingroup store_begin_batch
+ *
+ * GDBM doesn't have transactions, and doesn't sync after each write.
+ */
+static int store_gdbm_begin_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  return 0;
+}
+
+/**
+ * store_gdbm_commit_batch - Commit a batch of writes - Implements StoreOps::commit_batch() - @ingroup store_commit_batch
+ */
+static int store_gdbm_commit_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  GDBM_FILE db = store;
+  gdbm_sync(db);
+
+  return 0;
+}
+
 /**
  * store_gdbm_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -128,6 +128,47 @@ static int store_kyotocabinet_delete_record(StoreHandle *store, const char *key,
   return 0;
 }
 
+/**
+ * store_kyotocabinet_begin_batch - Start a batch of writes - Implements StoreOps::begin_batch() - @ingroup store_begin_batch
+ */
+static int store_kyotocabinet_begin_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  KCDB *db = store;
+
+  /* Don't sync the file system when the transaction ends */
+  if (!kcdbbegintran(db, 0))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+
+  return 0;
+}
+
+/**
+ * store_kyotocabinet_commit_batch - Commit a batch of writes - Implements StoreOps::commit_batch() - @ingroup store_commit_batch
+ */
+static int store_kyotocabinet_commit_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  KCDB *db = store;
+
+  if (!kcdbendtran(db, 1))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+
+  return 0;
+}
+
 /**
  * store_kyotocabinet_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -137,6 +137,36 @@ struct StoreOps
    */
   int (*delete_record)(StoreHandle *store, const char *key, size_t klen);
 
+  /**
+   * @defgroup store_begin_batch begin_batch()
+   * @ingroup store_api
+   *
+   * begin_batch - Start a batch of writes
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Subsequent calls to store() and delete_record() may be grouped into a
+   * single transaction, until commit_batch() is called.  Records written
+   * during the batch can be read back using fetch().
+   *
+   * Backends without transactions may treat this as a no-op.
+   */
+  int (*begin_batch)(StoreHandle *store);
+
+  /**
+   * @defgroup store_commit_batch commit_batch()
+   * @ingroup store_api
+   *
+   * commit_batch - Commit a batch of writes
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Write all the changes made since begin_batch() to the Store.
+   */
+  int (*commit_batch)(StoreHandle *store);
+
   /**
    * @defgroup store_close close()
    * @ingroup store_api
@@ -168,6 +198,8 @@ bool                   store_is_valid_backend(const char *str);
     .free           = store_##_name##_free,                                    \
     .store          = store_##_name##_store,                                   \
     .delete_record  = store_##_name##_delete_record,                           \
+    .begin_batch    = store_##_name##_begin_batch,                             \
+    .commit_batch   = store_##_name##_commit_batch,                            \
     .close          = store_##_name##_close,                                   \
     .version        = store_##_name##_version,                                 \
   };
@@ -44,6 +44,7 @@ struct RocksDbStoreData
   rocksdb_options_t *options;
   rocksdb_readoptions_t *read_options;
   rocksdb_writeoptions_t *write_options;
+  rocksdb_writebatch_wi_t *batch; ///< Writes waiting for commit_batch()
   char *err;
 };
 
@@ -129,7 +130,17 @@ static void *store_rocksdb_fetch(StoreHandle *store, const char *key, size_t kle
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = store;
 
-  void *rv = rocksdb_get(sdata->db, sdata->read_options, key, klen, vlen, &sdata->err);
+  void *rv = NULL;
+  if (sdata->batch)
+  {
+    rv = rocksdb_writebatch_wi_get_from_batch_and_db(sdata->batch, sdata->db,
+                                                     sdata->read_options, key,
+                                                     klen, vlen, &sdata->err);
+  }
+  else
+  {
+    rv = rocksdb_get(sdata->db, sdata->read_options, key, klen, vlen, &sdata->err);
+  }
   if (sdata->err)
   {
     rocksdb_free(sdata->err);
@@ -160,6 +171,12 @@ static int store_rocksdb_store(StoreHandle *store, const char *key, size_t klen,
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = store;
 
+  if (sdata->batch)
+  {
+    rocksdb_writebatch_wi_put(sdata->batch, key, klen, value, vlen);
+    return 0;
+  }
+
   rocksdb_put(sdata->db, sdata->write_options, key, klen, value, vlen, &sdata->err);
   if (sdata->err)
   {
@@ -182,6 +199,12 @@ static int store_rocksdb_delete_record(StoreHandle *store, const char *key, size
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = store;
 
+  if (sdata->batch)
+  {
+    rocksdb_writebatch_wi_delete(sdata->batch, key, klen);
+    return 0;
+  }
+
   rocksdb_delete(sdata->db, sdata->write_options, key, klen, &sdata->err);
   if (sdata->err)
   {
@@ -193,6 +216,54 @@ static int store_rocksdb_delete_record(StoreHandle *store, const char *key, size
   return 0;
 }
 
+/**
+ * store_rocksdb_begin_batch - Start a batch of writes - Implements StoreOps::begin_batch() - @ingroup store_begin_batch
+ *
+ * Writes are collected in an indexed WriteBatch, so they're visible to fetch()
+ * before the batch is committed.
+ */
+static int store_rocksdb_begin_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct RocksDbStoreData *sdata = store;
+
+  if (!sdata->batch)
+    sdata->batch = rocksdb_writebatch_wi_create(0, 1);
+
+  return 0;
+}
+
+/**
+ * store_rocksdb_commit_batch - Commit a batch of writes - Implements StoreOps::commit_batch() - @ingroup store_commit_batch
+ */
+static int store_rocksdb_commit_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct RocksDbStoreData *sdata = store;
+
+  if (!sdata->batch)
+    return 0;
+
+  rocksdb_write_writebatch_wi(sdata->db, sdata->write_options, sdata->batch, &sdata->err);
+  rocksdb_writebatch_wi_destroy(sdata->batch);
+  sdata->batch = NULL;
+
+  if (sdata->err)
+  {
+    rocksdb_free(sdata->err);
+    sdata->err = NULL;
+    return -1;
+  }
+
+  return 0;
+}
+
 /**
  * store_rocksdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -204,6 +275,8 @@ static void store_rocksdb_close(StoreHandle **ptr)
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = *ptr;
 
+  store_rocksdb_commit_batch(sdata);
+
   /* close database and free resources */
   rocksdb_close(sdata->db);
   rocksdb_options_destroy(sdata->options);
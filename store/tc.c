@@ -122,6 +122,46 @@ static int store_tokyocabinet_delete_record(StoreHandle *store, const char *key,
   return 0;
 }
 
+/**
+ * store_tokyocabinet_begin_batch - Start a batch of writes - Implements StoreOps::begin_batch() - @ingroup store_begin_batch
+ */
+static int store_tokyocabinet_begin_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TCBDB *db = store;
+
+  if (!tcbdbtranbegin(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+
+  return 0;
+}
+
+/**
+ * store_tokyocabinet_commit_batch - Commit a batch of writes - Implements StoreOps::commit_batch() - @ingroup store_commit_batch
+ */
+static int store_tokyocabinet_commit_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TCBDB *db = store;
+
+  if (!tcbdbtrancommit(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+
+  return 0;
+}
+
 /**
  * store_tokyocabinet_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
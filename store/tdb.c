@@ -128,6 +128,34 @@ static int store_tdb_delete_record(StoreHandle *store, const char *key, size_t k
   return tdb_delete(db, dkey);
 }
 
+/**
+ * store_tdb_begin_batch - Start a batch of writes - Implements StoreOps::begin_batch() - @ingroup store_begin_batch
+ */
+static int store_tdb_begin_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TDB_CONTEXT *db = store;
+
+  return tdb_transaction_start(db);
+}
+
+/**
+ * store_tdb_commit_batch - Commit a batch of writes - Implements StoreOps::commit_batch() - @ingroup store_commit_batch
+ */
+static int store_tdb_commit_batch(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TDB_CONTEXT *db = store;
+
+  return tdb_transaction_commit(db);
+}
+
 /**
  * store_tdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * Test code for alias_names_lookup()
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "alias/alias.h"
+#include "alias/names.h"
+#include "common.h"
+#include "test_common.h"
+
+void test_alias_names_lookup(void)
+{
+  // struct Alias *alias_names_lookup(const char *name);
+
+  MuttLogger = log_disp_null;
+  alias_names_init();
+
+  {
+    TEST_CHECK(alias_names_lookup(NULL) == NULL);
+    TEST_CHECK(alias_names_lookup("") == NULL);
+    TEST_CHECK(alias_names_lookup("bob") == NULL);
+  }
+
+  {
+    // Lookups ignore case
+    struct Alias *bob = test_alias_add("Bob");
+    struct Alias *alice = test_alias_add("alice");
+
+    TEST_CHECK(alias_names_lookup("Bob") == bob);
+    TEST_CHECK(alias_names_lookup("bob") == bob);
+    TEST_CHECK(alias_names_lookup("BOB") == bob);
+    TEST_CHECK(alias_names_lookup("ALICE") == alice);
+    TEST_CHECK(alias_names_lookup("bo") == NULL);
+    TEST_CHECK(alias_names_lookup("bobby") == NULL);
+
+    test_alias_clear();
+  }
+
+  {
+    // Deleted Aliases can't be found
+    struct Alias *bob = test_alias_add("bob");
+    struct Alias *carol = test_alias_add("carol");
+
+    test_alias_delete(bob);
+    TEST_CHECK(alias_names_lookup("bob") == NULL);
+    TEST_CHECK(alias_names_lookup("carol") == carol);
+
+    // An Alias that has been added, then deleted, is gone
+    test_alias_delete(test_alias_add("dave"));
+    TEST_CHECK(alias_names_lookup("dave") == NULL);
+    TEST_CHECK(alias_names_lookup("carol") == carol);
+
+    test_alias_clear();
+    TEST_CHECK(alias_names_lookup("carol") == NULL);
+  }
+
+  alias_names_shutdown();
+}
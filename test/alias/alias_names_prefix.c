@@ -0,0 +1,159 @@
+/**
+ * @file
+ * Test code for alias_names_prefix()
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "alias/alias.h"
+#include "alias/names.h"
+#include "common.h"
+#include "test_common.h"
+
+/**
+ * prefix_matches - Check the result of a prefix search
+ * @param prefix   Start of the Alias names
+ * @param expected Expected names, in order, ending with NULL
+ * @retval true The names match
+ */
+static bool prefix_matches(const char *prefix, const char **expected)
+{
+  size_t num = 0;
+  struct Alias **ap = alias_names_prefix(prefix, &num);
+
+  size_t count = 0;
+  while (expected[count])
+    count++;
+
+  TEST_CASE(prefix);
+  if (!TEST_CHECK(num == count))
+  {
+    TEST_MSG("Expected: %zu", count);
+    TEST_MSG("Actual  : %zu", num);
+    return false;
+  }
+
+  if (num == 0)
+    return TEST_CHECK(ap == NULL);
+
+  for (size_t i = 0; i < num; i++)
+  {
+    if (!TEST_CHECK_STR_EQ(ap[i]->name, expected[i]))
+      return false;
+  }
+
+  return true;
+}
+
+void test_alias_names_prefix(void)
+{
+  // struct Alias **alias_names_prefix(const char *prefix, size_t *num);
+
+  MuttLogger = log_disp_null;
+  alias_names_init();
+
+  {
+    size_t num = 42;
+    TEST_CHECK(alias_names_prefix(NULL, &num) == NULL);
+    TEST_CHECK(num == 0);
+
+    const char *none[] = { NULL };
+    TEST_CHECK(prefix_matches("", none));
+    TEST_CHECK(prefix_matches("a", none));
+  }
+
+  {
+    // Added in order
+    test_alias_add("alice");
+    test_alias_add("bob");
+    test_alias_add("bobby");
+    test_alias_add("carol");
+
+    const char *all[] = { "alice", "bob", "bobby", "carol", NULL };
+    const char *bob[] = { "bob", "bobby", NULL };
+    const char *none[] = { NULL };
+    TEST_CHECK(prefix_matches("", all));
+    TEST_CHECK(prefix_matches("b", bob));
+    TEST_CHECK(prefix_matches("bob", bob));
+    TEST_CHECK(prefix_matches("bobb", (const char *[]) { "bobby", NULL }));
+    TEST_CHECK(prefix_matches("aardvark", none));
+    TEST_CHECK(prefix_matches("bz", none));
+    TEST_CHECK(prefix_matches("zebra", none));
+
+    // The prefix is the last name
+    TEST_CHECK(prefix_matches("carol", (const char *[]) { "carol", NULL }));
+    TEST_CHECK(prefix_matches("caroline", none));
+
+    // Prefix searches are case-sensitive
+    TEST_CHECK(prefix_matches("B", none));
+
+    test_alias_clear();
+  }
+
+  {
+    // Added out of order
+    test_alias_add("dave");
+    test_alias_add("bob");
+    test_alias_add("erin");
+    test_alias_add("alice");
+
+    const char *all[] = { "alice", "bob", "dave", "erin", NULL };
+    TEST_CHECK(prefix_matches("", all));
+
+    // Adding after a search, still out of order
+    test_alias_add("carol");
+    const char *all2[] = { "alice", "bob", "carol", "dave", "erin", NULL };
+    TEST_CHECK(prefix_matches("", all2));
+
+    // Adding after a search, in order
+    test_alias_add("frank");
+    TEST_CHECK(prefix_matches("f", (const char *[]) { "frank", NULL }));
+    TEST_CHECK(prefix_matches("frank", (const char *[]) { "frank", NULL }));
+
+    test_alias_clear();
+  }
+
+  {
+    // Deleting, then searching
+    struct Alias *bob = test_alias_add("bob");
+    test_alias_add("bobby");
+    struct Alias *carol = test_alias_add("carol");
+
+    const char *bob_names[] = { "bob", "bobby", NULL };
+    TEST_CHECK(prefix_matches("bob", bob_names));
+
+    test_alias_delete(bob);
+    TEST_CHECK(prefix_matches("bob", (const char *[]) { "bobby", NULL }));
+
+    test_alias_delete(carol);
+    TEST_CHECK(prefix_matches("c", (const char *[]) { NULL }));
+    TEST_CHECK(prefix_matches("", (const char *[]) { "bobby", NULL }));
+
+    test_alias_clear();
+    TEST_CHECK(prefix_matches("", (const char *[]) { NULL }));
+  }
+
+  alias_names_shutdown();
+}
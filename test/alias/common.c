@@ -0,0 +1,72 @@
+/**
+ * @file
+ * Common code for the Alias tests
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "alias/alias.h"
+#include "alias/names.h"
+#include "common.h"
+
+/**
+ * test_alias_add - Create an Alias and add it to the name indexes
+ * @param name Name of the Alias
+ * @retval ptr New Alias
+ */
+struct Alias *test_alias_add(const char *name)
+{
+  struct Alias *alias = MUTT_MEM_CALLOC(1, struct Alias);
+  alias->name = mutt_str_dup(name);
+  TAILQ_INIT(&alias->addr);
+  STAILQ_INIT(&alias->tags);
+  TAILQ_INSERT_TAIL(&Aliases, alias, entries);
+  alias_names_add(alias);
+  return alias;
+}
+
+/**
+ * test_alias_delete - Remove an Alias from the name indexes and free it
+ * @param alias Alias to delete
+ */
+void test_alias_delete(struct Alias *alias)
+{
+  alias_names_delete(alias);
+  TAILQ_REMOVE(&Aliases, alias, entries);
+  FREE(&alias->name);
+  FREE(&alias);
+}
+
+/**
+ * test_alias_clear - Delete all the Aliases
+ */
+void test_alias_clear(void)
+{
+  struct Alias *np = NULL;
+  struct Alias *tmp = NULL;
+  TAILQ_FOREACH_SAFE(np, &Aliases, entries, tmp)
+  {
+    test_alias_delete(np);
+  }
+}
@@ -0,0 +1,33 @@
+/**
+ * @file
+ * Common code for the Alias tests
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_ALIAS_COMMON_H
+#define TEST_ALIAS_COMMON_H
+
+struct Alias;
+
+struct Alias *test_alias_add   (const char *name);
+void          test_alias_delete(struct Alias *alias);
+void          test_alias_clear (void);
+
+#endif /* TEST_ALIAS_COMMON_H */
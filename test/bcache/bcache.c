@@ -0,0 +1,266 @@
+/**
+ * @file
+ * Test code for the Body Cache
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "bcache/lib.h"
+#include "conn/lib.h"
+#ifdef USE_HCACHE_COMPRESSION
+#include "compress/lib.h"
+#endif
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "message_cache_compress_level",  DT_NUMBER, 0, 0, NULL },
+  { "message_cache_compress_method", DT_STRING, 0, 0, NULL },
+  { "message_cache_dir",             DT_PATH|D_PATH_DIR, 0, 0, NULL },
+  { "message_cache_size",            DT_LONG,   0, 0, NULL },
+  { NULL },
+  // clang-format on
+};
+
+static const char *Message = "From: alice@example.com\n"
+                             "Subject: hello\n"
+                             "\n"
+                             "The quick brown fox jumps over the lazy dog.\n"
+                             "The quick brown fox jumps over the lazy dog.\n";
+
+/**
+ * cache_put - Add a message to the Body Cache
+ */
+static bool cache_put(struct BodyCache *bc, const char *id, const char *data, size_t len)
+{
+  FILE *fp = mutt_bcache_put(bc, id);
+  if (!TEST_CHECK(fp != NULL))
+    return false;
+
+  TEST_CHECK(fwrite(data, 1, len, fp) == len);
+  mutt_file_fclose(&fp);
+  return TEST_CHECK(mutt_bcache_commit(bc, id) == 0);
+}
+
+/**
+ * cache_matches - Does a message in the Body Cache match?
+ */
+static bool cache_matches(struct BodyCache *bc, const char *id, const char *data, size_t len)
+{
+  FILE *fp = mutt_bcache_get(bc, id);
+  if (!fp)
+    return false;
+
+  char *buf = MUTT_MEM_CALLOC(len + 2, char);
+  const size_t got = fread(buf, 1, len + 1, fp);
+  mutt_file_fclose(&fp);
+
+  const bool rc = (got == len) && (memcmp(buf, data, len) == 0);
+  FREE(&buf);
+  return rc;
+}
+
+/**
+ * write_file - Create a file containing some data
+ */
+static void write_file(const char *path, const void *data, size_t len)
+{
+  FILE *fp = fopen(path, "w");
+  if (!TEST_CHECK(fp != NULL))
+    return;
+  TEST_CHECK(fwrite(data, 1, len, fp) == len);
+  fclose(fp);
+}
+
+/**
+ * set_atime - Set the access time of a file
+ */
+static void set_atime(const char *path, time_t t)
+{
+  struct timeval tv[2] = { { t, 0 }, { t, 0 } };
+  TEST_CHECK(utimes(path, tv) == 0);
+}
+
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * write_compressed - Create a compressed cache file by hand
+ * @param path   Path of the file
+ * @param method Name of the compression method to record
+ * @param dlen   Uncompressed length to record
+ * @param data   Data to compress
+ * @param len    Length of the data
+ */
+static void write_compressed(const char *path, const char *method, uint64_t dlen,
+                             const char *data, size_t len)
+{
+  static const char magic[4] = { '\211', 'N', 'B', 'C' };
+
+  const struct ComprOps *cops = compress_get_ops("zlib");
+  ComprHandle *handle = cops->open(cops->min_level);
+  size_t clen = 0;
+  void *cdata = cops->compress(handle, data, len, &clen);
+
+  FILE *fp = fopen(path, "w");
+  if (TEST_CHECK(fp != NULL))
+  {
+    fwrite(magic, 1, sizeof(magic), fp);
+    fwrite(method, 1, strlen(method) + 1, fp);
+    for (int i = 0; i < 8; i++)
+      fputc((dlen >> (8 * i)) & 0xff, fp);
+    fwrite(cdata, 1, clen, fp);
+    fclose(fp);
+  }
+
+  cops->close(&handle);
+}
+#endif
+
+void test_mutt_bcache(void)
+{
+  // FILE *mutt_bcache_get(struct BodyCache *bcache, const char *id);
+  // FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id);
+  // int   mutt_bcache_commit(struct BodyCache *bcache, const char *id);
+
+  MuttLogger = log_disp_null;
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+
+  char dir[] = "/tmp/neomutt-bcache-XXXXXX";
+  if (!TEST_CHECK(mkdtemp(dir) != NULL))
+    return;
+  cs_str_string_set(NeoMutt->sub->cs, "message_cache_dir", dir, NULL);
+
+  struct ConnAccount cac = { 0 };
+  cac.type = MUTT_ACCT_TYPE_IMAP;
+  mutt_str_copy(cac.host, "example.com", sizeof(cac.host));
+
+  struct BodyCache *bc = mutt_bcache_open(&cac, "INBOX");
+  if (!TEST_CHECK(bc != NULL))
+    return;
+
+  struct Buffer *path = buf_pool_get();
+  const size_t len = strlen(Message);
+
+  {
+    // Round trip, uncompressed
+    TEST_CHECK(cache_put(bc, "1", Message, len));
+    TEST_CHECK(cache_matches(bc, "1", Message, len));
+    TEST_CHECK(mutt_bcache_exists(bc, "1") == 0);
+  }
+
+#ifdef USE_HCACHE_COMPRESSION
+  {
+    // Round trip, compressed
+    cs_str_string_set(NeoMutt->sub->cs, "message_cache_compress_method", "zlib", NULL);
+    TEST_CHECK(cache_put(bc, "2", Message, len));
+    TEST_CHECK(cache_matches(bc, "2", Message, len));
+
+    // The file on disk isn't the plain message
+    buf_printf(path, "%s/imap:example.com/INBOX/2", dir);
+    FILE *fp = fopen(buf_string(path), "r");
+    char magic[4] = { 0 };
+    TEST_CHECK((fp != NULL) && (fread(magic, 1, sizeof(magic), fp) == sizeof(magic)));
+    TEST_CHECK(memcmp(magic, "\211NBC", 4) == 0);
+    if (fp)
+      fclose(fp);
+
+    cs_str_reset(NeoMutt->sub->cs, "message_cache_compress_method", NULL);
+
+    // A compressed entry can still be read
+    TEST_CHECK(cache_matches(bc, "2", Message, len));
+  }
+
+  {
+    // Corrupt headers are rejected
+    buf_printf(path, "%s/imap:example.com/INBOX/3", dir);
+
+    write_compressed(buf_string(path), "zlib", len, Message, len);
+    TEST_CHECK(cache_matches(bc, "3", Message, len));
+
+    write_compressed(buf_string(path), "zlib", len + 100000, Message, len);
+    TEST_CHECK(mutt_bcache_get(bc, "3") == NULL);
+
+    write_compressed(buf_string(path), "zlib", len - 1, Message, len);
+    TEST_CHECK(mutt_bcache_get(bc, "3") == NULL);
+
+    write_compressed(buf_string(path), "bogus", len, Message, len);
+    TEST_CHECK(mutt_bcache_get(bc, "3") == NULL);
+
+    write_file(buf_string(path), "\211NBCzlib", 9);
+    TEST_CHECK(mutt_bcache_get(bc, "3") == NULL);
+
+    write_file(buf_string(path), "\211NBCzlib\0\1\0\0\0\0\0\0\0garbage", 24);
+    TEST_CHECK(mutt_bcache_get(bc, "3") == NULL);
+  }
+#endif
+
+  {
+    // Only the Body Cache's own files are evicted
+    const size_t big = 600 * 1024;
+    char *data = MUTT_MEM_CALLOC(big, char);
+    memset(data, 'x', big);
+
+    buf_printf(path, "%s/precious", dir);
+    write_file(buf_string(path), data, big);
+    set_atime(buf_string(path), 1000);
+
+    buf_printf(path, "%s/other", dir);
+    TEST_CHECK(mkdir(buf_string(path), 0700) == 0);
+    buf_printf(path, "%s/other/file", dir);
+    write_file(buf_string(path), data, big);
+    set_atime(buf_string(path), 1000);
+
+    cs_str_native_set(NeoMutt->sub->cs, "message_cache_size", 1, NULL);
+
+    TEST_CHECK(cache_put(bc, "old", data, big));
+    buf_printf(path, "%s/imap:example.com/INBOX/old", dir);
+    set_atime(buf_string(path), 2000);
+
+    TEST_CHECK(cache_put(bc, "new", data, big));
+
+    TEST_CHECK(mutt_bcache_exists(bc, "old") != 0);
+    TEST_CHECK(mutt_bcache_exists(bc, "new") == 0);
+
+    buf_printf(path, "%s/precious", dir);
+    TEST_CHECK(access(buf_string(path), F_OK) == 0);
+    buf_printf(path, "%s/other/file", dir);
+    TEST_CHECK(access(buf_string(path), F_OK) == 0);
+
+    cs_str_reset(NeoMutt->sub->cs, "message_cache_size", NULL);
+    FREE(&data);
+  }
+
+  mutt_bcache_close(&bc);
+
+  buf_printf(path, "rm -rf '%s'", dir);
+  TEST_CHECK(system(buf_string(path)) == 0);
+  buf_pool_release(&path);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file
+ * Common code for the benchmarks
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * The benchmarks are standalone programs, built and run by 'make <name>-bench'.
+ * They aren't part of 'make test'.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+#include "bench.h"
+
+/**
+ * bench_now - Get the time in seconds
+ * @retval num Seconds since an arbitrary point
+ */
+double bench_now(void)
+{
+  struct timespec ts = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/**
+ * bench_report - Print the throughput of one operation
+ * @param name  Name of the operation
+ * @param num   Number of operations
+ * @param unit  Name of the throughput, e.g. "Mops/s"
+ * @param start Start time, from bench_now()
+ * @retval num Seconds taken
+ */
+double bench_report(const char *name, size_t num, const char *unit, double start)
+{
+  const double secs = bench_now() - start;
+  printf("  %-12s %8.1f ms %8.2f %s\n", name, secs * 1000, (num / secs) / 1e6, unit);
+  return secs;
+}
@@ -23,9 +23,28 @@
 #define TEST_NO_MAIN
 #include "config.h"
 #include "acutest.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include "mutt/lib.h"
 
+/// Charsets opened by the worker threads
+static const char *ThreadCharsets[] = {
+  "iso-8859-1", "ISO-8859-2", "utf8", "us-ascii", "latin1", "cp1252", "koi8-r", "8859-15",
+};
+
+/**
+ * iconv_open_job - Open a converter from a worker thread - Implements ::worker_job_t - @ingroup worker_job_api
+ */
+static void iconv_open_job(size_t index, void *data)
+{
+  bool *results = data;
+  const char *cs = ThreadCharsets[index % mutt_array_size(ThreadCharsets)];
+
+  iconv_t cd = mutt_ch_iconv_open("utf-8", cs, MUTT_ICONV_NO_FLAGS);
+  results[index] = iconv_t_valid(cd) &&
+                   (mutt_ch_iconv_open("utf-8", cs, MUTT_ICONV_NO_FLAGS) == cd);
+}
+
 void test_mutt_ch_iconv_open(void)
 {
   // iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t flags);
@@ -37,4 +56,82 @@ void test_mutt_ch_iconv_open(void)
   {
     TEST_CHECK(mutt_ch_iconv_open("apple", NULL, MUTT_ICONV_NO_FLAGS) != NULL);
   }
+
+  {
+    // The converters are cached under the canonical names
+    iconv_t cd1 = mutt_ch_iconv_open("utf-8", "iso-8859-1", MUTT_ICONV_NO_FLAGS);
+    TEST_CHECK(iconv_t_valid(cd1));
+    TEST_CHECK(mutt_ch_iconv_open("utf-8", "iso-8859-1", MUTT_ICONV_NO_FLAGS) == cd1);
+    TEST_CHECK(mutt_ch_iconv_open("UTF8", "ISO_8859-1", MUTT_ICONV_NO_FLAGS) == cd1);
+    TEST_CHECK(mutt_ch_iconv_open("utf-8", "latin1", MUTT_ICONV_NO_FLAGS) == cd1);
+    TEST_CHECK(mutt_ch_iconv_open("utf-8", "iso-8859-2", MUTT_ICONV_NO_FLAGS) != cd1);
+    TEST_CHECK(!iconv_t_valid(mutt_ch_iconv_open("utf-8", "banana", MUTT_ICONV_NO_FLAGS)));
+
+    // The flags are part of the key
+    iconv_t cd2 = mutt_ch_iconv_open("utf-8", "iso-8859-1", MUTT_ICONV_HOOK_FROM);
+    TEST_CHECK(iconv_t_valid(cd2));
+    TEST_CHECK(cd2 != cd1);
+    TEST_CHECK(mutt_ch_iconv_open("utf-8", "iso-8859-1", MUTT_ICONV_HOOK_FROM) == cd2);
+  }
+
+  {
+    // The cache is limited, the most recently used converters are kept
+    static const char *charsets[] = { "utf-8", "iso-8859-1", "iso-8859-2", "iso-8859-5",
+                                      "iso-8859-15", "koi8-r", "cp1251", "cp1252",
+                                      "us-ascii", "utf-16", "utf-32" };
+    iconv_t cd = ICONV_T_INVALID;
+    for (size_t i = 0; i < mutt_array_size(charsets); i++)
+    {
+      for (size_t j = 0; j < mutt_array_size(charsets); j++)
+      {
+        cd = mutt_ch_iconv_open(charsets[i], charsets[j], MUTT_ICONV_NO_FLAGS);
+        TEST_CHECK(iconv_t_valid(cd));
+        TEST_MSG("%s <- %s", charsets[i], charsets[j]);
+      }
+    }
+    TEST_CHECK(mutt_ch_iconv_open("utf-32", "utf-32", MUTT_ICONV_NO_FLAGS) == cd);
+    TEST_CHECK(iconv_t_valid(mutt_ch_iconv_open("utf-8", "utf-8", MUTT_ICONV_NO_FLAGS)));
+  }
+
+  {
+    // Failures are cached, until a new iconv-hook applies
+    struct Buffer *err = buf_pool_get();
+    TEST_CHECK(!iconv_t_valid(mutt_ch_iconv_open("utf-8", "x-banana", MUTT_ICONV_NO_FLAGS)));
+    TEST_CHECK(!iconv_t_valid(mutt_ch_iconv_open("utf-8", "x-banana", MUTT_ICONV_NO_FLAGS)));
+    TEST_CHECK(mutt_ch_lookup_add(MUTT_LOOKUP_ICONV, "^x-banana$", "iso-8859-1", err));
+    iconv_t cd = mutt_ch_iconv_open("utf-8", "x-banana", MUTT_ICONV_NO_FLAGS);
+    TEST_CHECK(iconv_t_valid(cd));
+    TEST_CHECK(mutt_ch_iconv_open("utf-8", "x-banana", MUTT_ICONV_NO_FLAGS) == cd);
+    mutt_ch_lookup_remove();
+    buf_pool_release(&err);
+  }
+
+  {
+    // A new charset-hook applies to names that were cached before it
+    struct Buffer *err = buf_pool_get();
+    iconv_t cd1 = mutt_ch_iconv_open("utf-8", "iso-8859-1", MUTT_ICONV_HOOK_FROM);
+    iconv_t cd2 = mutt_ch_iconv_open("utf-8", "x-apple", MUTT_ICONV_HOOK_FROM);
+    TEST_CHECK(!iconv_t_valid(cd2));
+
+    TEST_CHECK(mutt_ch_lookup_add(MUTT_LOOKUP_CHARSET, "^x-apple$", "iso-8859-1", err));
+    TEST_CHECK(mutt_ch_iconv_open("utf-8", "x-apple", MUTT_ICONV_HOOK_FROM) == cd1);
+    TEST_CHECK(!iconv_t_valid(mutt_ch_iconv_open("utf-8", "x-apple", MUTT_ICONV_NO_FLAGS)));
+
+    mutt_ch_lookup_remove();
+    TEST_CHECK(!iconv_t_valid(mutt_ch_iconv_open("utf-8", "x-apple", MUTT_ICONV_HOOK_FROM)));
+    buf_pool_release(&err);
+  }
+
+  {
+    // Each thread has its own converters
+    bool results[64] = { false };
+    mutt_worker_run(mutt_array_size(results), 8, iconv_open_job, results);
+    for (size_t i = 0; i < mutt_array_size(results); i++)
+    {
+      TEST_CHECK(results[i]);
+      TEST_MSG("%s", ThreadCharsets[i % mutt_array_size(ThreadCharsets)]);
+    }
+  }
+
+  mutt_ch_cache_cleanup();
 }
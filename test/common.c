@@ -44,6 +44,7 @@
 #include "mx.h"
 
 struct AddressList;
+struct Alias;
 struct Email;
 struct Envelope;
 struct MuttWindow;
@@ -59,6 +60,9 @@ bool MonitorContextChanged = false;
 
 const struct CompleteOps CompleteMailboxOps = { 0 };
 
+TAILQ_HEAD(AliasList, Alias);
+struct AliasList Aliases = TAILQ_HEAD_INITIALIZER(Aliases);
+
 static struct ConfigDef Vars[] = {
   // clang-format off
   { "assumed_charset", DT_SLIST|D_SLIST_SEP_COLON|D_SLIST_ALLOW_EMPTY, 0, 0, NULL, },
@@ -255,6 +259,7 @@ bool mx_mbox_ac_link(struct Mailbox *m)
 
 void mutt_encode_path(struct Buffer *buf, const char *src)
 {
+  buf_strcpy(buf, src);
 }
 
 void mutt_set_header_color(struct Mailbox *m, struct Email *e)
@@ -0,0 +1,114 @@
+/**
+ * @file
+ * Test code for the Flag Index
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+
+static bool fi_bit(const struct FlagIndex *fi, enum FlagIndexBit bit, int i)
+{
+  return (flag_index_bitmap(fi, bit)[i / 64] >> (i % 64)) & 1;
+}
+
+void test_flag_index(void)
+{
+  // struct FlagIndex *flag_index_get(struct Mailbox *m);
+  // void flag_index_update(struct Mailbox *m, const struct Email *e);
+  // void flag_index_invalidate(struct Mailbox *m);
+
+  {
+    TEST_CHECK(flag_index_get(NULL) == NULL);
+    flag_index_update(NULL, NULL);
+    flag_index_invalidate(NULL);
+  }
+
+  {
+    const int count = 150;
+    struct Mailbox *m = mailbox_new();
+    m->email_max = count + 1;
+    MUTT_MEM_REALLOC(&m->emails, m->email_max, struct Email *);
+    for (int i = 0; i < count; i++)
+    {
+      struct Email *e = email_new();
+      e->msgno = i;
+      e->read = ((i % 2) == 0);
+      e->old = ((i % 3) == 0);
+      e->flagged = ((i % 5) == 0);
+      e->deleted = ((i % 7) == 0);
+      m->emails[i] = e;
+    }
+    m->msg_count = count;
+
+    struct FlagIndex *fi = flag_index_get(m);
+    TEST_CHECK(fi != NULL);
+    TEST_CHECK(fi->count == count);
+    TEST_CHECK(fi->words == 3);
+    for (int i = 0; i < count; i++)
+    {
+      TEST_CASE_("%d", i);
+      TEST_CHECK(fi_bit(fi, FIB_READ, i) == ((i % 2) == 0));
+      TEST_CHECK(fi_bit(fi, FIB_OLD, i) == ((i % 3) == 0));
+      TEST_CHECK(fi_bit(fi, FIB_FLAGGED, i) == ((i % 5) == 0));
+      TEST_CHECK(fi_bit(fi, FIB_DELETED, i) == ((i % 7) == 0));
+      TEST_CHECK(!fi_bit(fi, FIB_TAGGED, i));
+    }
+
+    // Cached
+    TEST_CHECK(flag_index_get(m) == fi);
+
+    // Updated in place
+    struct Email *e = m->emails[130];
+    e->tagged = true;
+    flag_index_update(m, e);
+    TEST_CHECK(m->flag_index == fi);
+    TEST_CHECK(fi_bit(fi, FIB_TAGGED, 130));
+
+    // Email isn't where the index expects it
+    e->msgno = 3;
+    flag_index_update(m, e);
+    TEST_CHECK(m->flag_index == NULL);
+    e->msgno = 130;
+
+    // New Email
+    fi = flag_index_get(m);
+    e = email_new();
+    e->msgno = count;
+    e->flagged = true;
+    m->emails[count] = e;
+    m->msg_count++;
+    fi = flag_index_get(m);
+    TEST_CHECK(fi->count == (count + 1));
+    TEST_CHECK(fi_bit(fi, FIB_FLAGGED, count));
+    TEST_CHECK(fi_bit(fi, FIB_TAGGED, 130));
+
+    mailbox_changed(m, NT_MAILBOX_RESORT);
+    TEST_CHECK(m->flag_index == NULL);
+
+    flag_index_get(m);
+    mailbox_free(&m);
+  }
+}
@@ -0,0 +1,340 @@
+/**
+ * @file
+ * Benchmark the rendering of Expandos
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Compare the speed of the two Expando renderers: walking the tree,
+ * node_render(), and running the compiled Program, expando_render().
+ *
+ * Usage: expando-bench [NUM_EMAILS...]
+ *
+ * By default, mailboxes of 1k, 10k and 100k synthetic Emails are rendered with
+ * some Index-like formats.  The renderers must produce the same lines.
+ * The renderers are tested by test/expando/program.c
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "expando/lib.h"
+#include "protos.h"
+#include "bench.h"
+
+bool StartupComplete = true;
+
+/// Width of the rendered lines
+#define BENCH_COLS 120
+
+/**
+ * email_number - Index: Index number - Implements ::get_number_t
+ */
+static long email_number(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct Email *e = data;
+  return e->msgno + 1;
+}
+
+/**
+ * email_lines - Index: Number of lines - Implements ::get_number_t
+ */
+static long email_lines(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct Email *e = data;
+  return e->lines;
+}
+
+/**
+ * email_size_num - Index: Size of message - Implements ::get_number_t
+ */
+static long email_size_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct Email *e = data;
+  return e->body->length;
+}
+
+/**
+ * email_size - Index: Size of message - Implements ::get_string_t
+ */
+static void email_size(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct Email *e = data;
+  buf_printf(buf, "%ldK", (long) ((e->body->length + 1023) / 1024));
+}
+
+/**
+ * email_date - Index: Sent date - Implements ::get_string_t
+ */
+static void email_date(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct Email *e = data;
+  mutt_date_localtime_format(buf->data, buf->dsize, "%b %d", e->date_sent);
+  buf_fix_dptr(buf);
+}
+
+/**
+ * email_flags - Index: Message flags - Implements ::get_string_t
+ */
+static void email_flags(const struct ExpandoNode *node, void *data,
+                        MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct Email *e = data;
+  buf_addch(buf, e->read ? ' ' : 'N');
+  buf_addch(buf, e->flagged ? '!' : ' ');
+  buf_addch(buf, e->replied ? 'r' : ' ');
+}
+
+/**
+ * email_from - Index: Author's name - Implements ::get_string_t
+ */
+static void email_from(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct Email *e = data;
+  const struct Address *a = TAILQ_FIRST(&e->env->from);
+  if (!a)
+    return;
+
+  if (a->personal)
+    buf_copy(buf, a->personal);
+  else
+    buf_copy(buf, a->mailbox);
+}
+
+/**
+ * email_subject - Index: Subject - Implements ::get_string_t
+ */
+static void email_subject(const struct ExpandoNode *node, void *data,
+                          MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct Email *e = data;
+  buf_strcpy(buf, e->env->subject);
+}
+
+/**
+ * BenchFormatDef - Expando definitions, a subset of the Index's
+ */
+static const struct ExpandoDefinition BenchFormatDef[] = {
+  // clang-format off
+  { "*", "padding-soft", ED_GLOBAL,   ED_GLO_PADDING_SOFT, node_padding_parse },
+  { ">", "padding-hard", ED_GLOBAL,   ED_GLO_PADDING_HARD, node_padding_parse },
+  { "|", "padding-eol",  ED_GLOBAL,   ED_GLO_PADDING_EOL,  node_padding_parse },
+  { "a", "from",         ED_ENVELOPE, ED_ENV_FROM,         NULL },
+  { "c", "size",         ED_EMAIL,    ED_EMA_SIZE,         NULL },
+  { "C", "number",       ED_EMAIL,    ED_EMA_NUMBER,       NULL },
+  { "d", "date-format",  ED_EMAIL,    ED_EMA_DATE_FORMAT,  NULL },
+  { "l", "lines",        ED_EMAIL,    ED_EMA_LINES,        NULL },
+  { "s", "subject",      ED_ENVELOPE, ED_ENV_SUBJECT,      NULL },
+  { "Z", "combined-flags", ED_EMAIL,  ED_EMA_FLAG_CHARS,   NULL },
+  { NULL, NULL, 0, -1, NULL }
+  // clang-format on
+};
+
+/**
+ * BenchRenderCallbacks - Callbacks for the benchmark Expandos
+ */
+static const struct ExpandoRenderCallback BenchRenderCallbacks[] = {
+  // clang-format off
+  { ED_ENVELOPE, ED_ENV_FROM,        email_from,    NULL },
+  { ED_EMAIL,    ED_EMA_SIZE,        email_size,    email_size_num },
+  { ED_EMAIL,    ED_EMA_NUMBER,      NULL,          email_number },
+  { ED_EMAIL,    ED_EMA_DATE_FORMAT, email_date,    NULL },
+  { ED_EMAIL,    ED_EMA_LINES,       NULL,          email_lines },
+  { ED_ENVELOPE, ED_ENV_SUBJECT,     email_subject, NULL },
+  { ED_EMAIL,    ED_EMA_FLAG_CHARS,  email_flags,   NULL },
+  { -1, -1, NULL, NULL },
+  // clang-format on
+};
+
+/// Formats to render, like $index_format
+static const char *BenchFormats[] = {
+  "%4C %Z %d %-15.15a (%<l?%4l&%4c>) %s",
+  "%4C %Z %d %-20.20a %<l?%5l&%5c> %s%* %c",
+};
+
+/// Authors of the synthetic Emails
+static const char *BenchNames[] = {
+  "Richard Russon <rich@flatcap.org>",
+  "Tóth János <janos@example.hu>",
+  "alice@example.com",
+  "\"Bob, the Builder\" <bob@example.org>",
+};
+
+/// Subjects of the synthetic Emails
+static const char *BenchSubjects[] = {
+  "Hello World",
+  "Re: [neomutt] Render the index faster (#4321)",
+  "日本語の件名",
+  "Fwd: Re: Re: Minutes of the meeting",
+};
+
+/**
+ * emails_create - Create a synthetic mailbox
+ * @param num Number of Emails
+ * @retval ptr Array of Emails
+ */
+static struct Email **emails_create(size_t num)
+{
+  struct Email **emails = MUTT_MEM_CALLOC(num, struct Email *);
+
+  for (size_t i = 0; i < num; i++)
+  {
+    struct Email *e = email_new();
+    e->env = mutt_env_new();
+    e->body = mutt_body_new();
+
+    mutt_addrlist_parse(&e->env->from, BenchNames[i % mutt_array_size(BenchNames)]);
+    mutt_str_replace((char **) &e->env->subject,
+                     BenchSubjects[(i / 3) % mutt_array_size(BenchSubjects)]);
+    e->msgno = i;
+    e->lines = (i * 7) % 23;
+    e->body->length = (i * 2654435761U) % 500000;
+    e->date_sent = 1700000000 + (i * 3600);
+    e->read = (i % 5) != 0;
+    e->flagged = (i % 11) == 0;
+    e->replied = (i % 3) == 0;
+
+    emails[i] = e;
+  }
+
+  return emails;
+}
+
+/**
+ * emails_free - Free a synthetic mailbox
+ * @param emails Array of Emails
+ * @param num    Number of Emails
+ */
+static void emails_free(struct Email **emails, size_t num)
+{
+  for (size_t i = 0; i < num; i++)
+    email_free(&emails[i]);
+  FREE(&emails);
+}
+
+/**
+ * bench_format - Benchmark one format against a mailbox
+ * @param str    Format string
+ * @param emails Array of Emails
+ * @param num    Number of Emails
+ * @retval true The renderers produced the same lines
+ */
+static bool bench_format(const char *str, struct Email **emails, size_t num)
+{
+  bool rc = false;
+  struct Buffer *err = buf_pool_get();
+  struct Buffer *expected = buf_pool_get();
+  struct Buffer *actual = buf_pool_get();
+
+  struct Expando *exp = expando_parse(str, BenchFormatDef, err);
+  if (!exp)
+  {
+    printf("%s: %s\n", str, buf_string(err));
+    goto done;
+  }
+
+  // The compiled Program must produce the same lines as the tree
+  for (size_t i = 0; i < num; i++)
+  {
+    buf_reset(expected);
+    buf_reset(actual);
+    node_render(exp->node, BenchRenderCallbacks, expected, BENCH_COLS,
+                emails[i], MUTT_FORMAT_INDEX);
+    expando_render(exp, BenchRenderCallbacks, emails[i], MUTT_FORMAT_INDEX,
+                   BENCH_COLS, actual);
+    if (!mutt_str_equal(buf_string(actual), buf_string(expected)))
+    {
+      printf("%s: email %zu\n  tree:    '%s'\n  program: '%s'\n", str, i,
+             buf_string(expected), buf_string(actual));
+      goto done;
+    }
+  }
+
+  printf("\nformat: \"%s\", emails: %zu\n", str, num);
+
+  double start = bench_now();
+  for (size_t i = 0; i < num; i++)
+  {
+    buf_reset(expected);
+    node_render(exp->node, BenchRenderCallbacks, expected, BENCH_COLS,
+                emails[i], MUTT_FORMAT_INDEX);
+  }
+  const double secs_tree = bench_report("tree", num, "Mlines/s", start);
+
+  start = bench_now();
+  for (size_t i = 0; i < num; i++)
+  {
+    buf_reset(actual);
+    expando_render(exp, BenchRenderCallbacks, emails[i], MUTT_FORMAT_INDEX,
+                   BENCH_COLS, actual);
+  }
+  const double secs_prog = bench_report("program", num, "Mlines/s", start);
+
+  printf("  speedup      %8.2fx\n", secs_tree / secs_prog);
+  rc = true;
+
+done:
+  expando_free(&exp);
+  buf_pool_release(&err);
+  buf_pool_release(&expected);
+  buf_pool_release(&actual);
+  return rc;
+}
+
+/**
+ * main - Benchmark the Expando renderers
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments: the number of Emails to render
+ * @retval 0 Success
+ * @retval 1 The renderers disagreed
+ */
+int main(int argc, char *argv[])
+{
+  static const size_t DefaultSizes[] = { 1000, 10000, 100000 };
+  bool ok = true;
+
+  struct ConfigSet *cs = cs_new(16);
+  NeoMutt = neomutt_new(cs);
+  init_config(cs);
+
+  const int count = (argc > 1) ? (argc - 1) : mutt_array_size(DefaultSizes);
+  for (int i = 0; ok && (i < count); i++)
+  {
+    const size_t num = (argc > 1) ? strtoul(argv[i + 1], NULL, 10) : DefaultSizes[i];
+    struct Email **emails = emails_create(num);
+
+    for (size_t j = 0; ok && (j < mutt_array_size(BenchFormats)); j++)
+      ok = bench_format(BenchFormats[j], emails, num);
+
+    emails_free(emails, num);
+  }
+
+  neomutt_free(&NeoMutt);
+  cs_free(&cs);
+  return ok ? 0 : 1;
+}
@@ -118,4 +118,26 @@ void test_expando_node(void)
 
     node_free(&root);
   }
+
+  // bool node_find_type(const struct ExpandoNode *node, enum ExpandoNodeType type);
+  {
+    TEST_CHECK(!node_find_type(NULL, ENT_TEXT));
+
+    struct ExpandoNode *root = node_new();
+    root->type = ENT_CONTAINER;
+    struct ExpandoNode *child0 = node_new();
+    child0->type = ENT_CONDITION;
+    node_add_child(root, child0);
+
+    ARRAY_SET(&child0->children, 0, node_new());
+    ARRAY_SET(&child0->children, 2, node_new());
+    (*ARRAY_GET(&child0->children, 2))->type = ENT_CONDDATE;
+
+    TEST_CHECK(node_find_type(root, ENT_CONTAINER));
+    TEST_CHECK(node_find_type(root, ENT_CONDITION));
+    TEST_CHECK(node_find_type(root, ENT_CONDDATE));
+    TEST_CHECK(!node_find_type(root, ENT_EXPANDO));
+
+    node_free(&root);
+  }
 }
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * Test code for Compiled Expando Programs
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "expando/lib.h"
+#include "common.h" // IWYU pragma: keep
+#include "test_common.h"
+
+struct ProgramData
+{
+  const char *name;
+  const char *subject;
+  long num;
+};
+
+static void program_name(const struct ExpandoNode *node, void *data,
+                         MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct ProgramData *pd = data;
+  buf_strcpy(buf, pd->name);
+}
+
+static void program_subject(const struct ExpandoNode *node, void *data,
+                            MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct ProgramData *pd = data;
+  buf_strcpy(buf, pd->subject);
+}
+
+static long program_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct ProgramData *pd = data;
+  return pd->num;
+}
+
+void test_expando_program(void)
+{
+  // struct ExpandoProgram *program_new(void);
+  // void program_free(struct ExpandoProgram **ptr);
+  // void program_compile(struct ExpandoProgram *prog, const struct ExpandoNode *root, const struct ExpandoRenderCallback *erc);
+  // int program_render(const struct ExpandoProgram *prog, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+
+  static const struct ExpandoDefinition FormatDef[] = {
+    // clang-format off
+    { "*", "padding-soft", ED_GLOBAL, ED_GLO_PADDING_SOFT, node_padding_parse },
+    { ">", "padding-hard", ED_GLOBAL, ED_GLO_PADDING_HARD, node_padding_parse },
+    { "|", "padding-eol",  ED_GLOBAL, ED_GLO_PADDING_EOL,  node_padding_parse },
+    { "a", "name",         1,         0,                   NULL },
+    { "n", "number",       1,         1,                   NULL },
+    { "s", "subject",      1,         2,                   NULL },
+    { NULL, NULL, 0, -1, NULL }
+    // clang-format on
+  };
+
+  static const struct ExpandoRenderCallback RenderCallbacks[] = {
+    // clang-format off
+    { 1, 0, program_name,    NULL },
+    { 1, 1, NULL,            program_num },
+    { 1, 2, program_subject, NULL },
+    { -1, -1, NULL, NULL },
+    // clang-format on
+  };
+
+  {
+    TEST_CASE("program_free");
+    program_free(NULL);
+
+    struct ExpandoProgram *prog = NULL;
+    program_free(&prog);
+
+    prog = program_new();
+    TEST_CHECK(prog != NULL);
+    program_free(&prog);
+    TEST_CHECK(prog == NULL);
+  }
+
+  {
+    TEST_CASE("program_render");
+    struct Buffer *buf = buf_pool_get();
+    TEST_CHECK(program_render(NULL, buf, 80, NULL, MUTT_FORMAT_NO_FLAGS) == 0);
+    buf_pool_release(&buf);
+  }
+
+  // The compiled Program must match the tree, whatever the width
+  static const char *Formats[] = {
+    "plain text",
+    "%4n %-10.10a %s",
+    "%<n?[%n]&none> %a%* %s",
+    "%-20a%>.%s",
+    "%=12s|%|-",
+    "%10<n?%a&%s>%_s",
+    "x%?n?%a?y %03n",
+    "%.3a%*=%-8.8s%>-%n",
+    "%<n?%<n?%a%|.&x>&y>",
+  };
+
+  static const struct ProgramData Data[] = {
+    { "Richard Russon", "Hello World", 42 },
+    { "", "Re: Re: A much longer subject line", 0 },
+    { "Tóth János", "日本語の件名", -7 },
+  };
+
+  static const int Widths[] = { 0, 1, 3, 8, 13, 20, 37, 80 };
+
+  struct Buffer *err = buf_pool_get();
+  struct Buffer *expected = buf_pool_get();
+  struct Buffer *actual = buf_pool_get();
+
+  for (size_t i = 0; i < mutt_array_size(Formats); i++)
+  {
+    struct Expando *exp = expando_parse(Formats[i], FormatDef, err);
+    TEST_CHECK(exp != NULL);
+    TEST_MSG("%s", buf_string(err));
+    if (!exp)
+      continue;
+
+    for (size_t j = 0; j < mutt_array_size(Data); j++)
+    {
+      for (size_t k = 0; k < mutt_array_size(Widths); k++)
+      {
+        struct ProgramData data = Data[j];
+        buf_reset(expected);
+        buf_reset(actual);
+
+        int cols_expected = node_render(exp->node, RenderCallbacks, expected,
+                                        Widths[k], &data, MUTT_FORMAT_NO_FLAGS);
+        int cols_actual = expando_render(exp, RenderCallbacks, &data,
+                                         MUTT_FORMAT_NO_FLAGS, Widths[k], actual);
+
+        TEST_CASE_("%s, %zu, %d", Formats[i], j, Widths[k]);
+        TEST_CHECK_STR_EQ(buf_string(actual), buf_string(expected));
+        TEST_CHECK_NUM_EQ(cols_actual, cols_expected);
+      }
+    }
+
+    TEST_CHECK(exp->program->erc == RenderCallbacks);
+    TEST_CHECK(ARRAY_SIZE(&exp->program->ops) > 0);
+
+    expando_free(&exp);
+  }
+
+  buf_pool_release(&err);
+  buf_pool_release(&expected);
+  buf_pool_release(&actual);
+}
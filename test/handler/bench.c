@@ -0,0 +1,217 @@
+/**
+ * @file
+ * Benchmark the base64 and quoted-printable decoders
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Measure the throughput of mutt_decode_attachment(), for base64 and
+ * quoted-printable attachments.
+ *
+ * Usage: handler-bench [MEGABYTES...]
+ *
+ * By default, 1MB, 16MB and 64MB attachments are decoded.
+ * The size is of the decoded data.  The output is discarded.
+ * Each attachment is decoded several times and the fastest run is reported.
+ *
+ * The decoders are checked against the originals by fuzz/decode.c
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mutt.h"
+#include "globals.h"
+#include "handler.h"
+#include "protos.h"
+#include "bench.h"
+
+bool StartupComplete = true;
+
+/// Length of an encoded line, as recommended by RFC2045
+#define LINE_LEN 76
+
+/// Number of times to decode each attachment; the fastest is reported
+#define BENCH_RUNS 5
+
+/**
+ * log_disp_null - Discard log lines - Implements ::log_dispatcher_t - @ingroup logging_api
+ */
+static int log_disp_null(time_t stamp, const char *file, int line, const char *function,
+                         enum LogLevel level, const char *format, ...)
+{
+  return 0;
+}
+
+/**
+ * write_base64 - Write random binary data, base64-encoded
+ * @param fp   File to write to
+ * @param size Number of bytes to encode
+ */
+static void write_base64(FILE *fp, size_t size)
+{
+  unsigned char in[(LINE_LEN / 4) * 3];
+  char out[LINE_LEN + 8];
+
+  for (size_t done = 0; done < size; done += sizeof(in))
+  {
+    const size_t len = MIN(sizeof(in), size - done);
+    for (size_t i = 0; i < len; i++)
+      in[i] = rand();
+
+    const size_t olen = mutt_b64_encode((const char *) in, len, out, sizeof(out));
+    fwrite(out, 1, olen, fp);
+    fputs("\r\n", fp);
+  }
+}
+
+/**
+ * write_quoted - Write random text, quoted-printable-encoded
+ * @param fp   File to write to
+ * @param size Number of bytes to encode
+ *
+ * The text is mostly ASCII, with about one character in twenty encoded.
+ */
+static void write_quoted(FILE *fp, size_t size)
+{
+  int col = 0;
+
+  for (size_t i = 0; i < size; i++)
+  {
+    const int r = rand() % 100;
+    if (r < 2)
+    {
+      fputs("\r\n", fp);
+      col = 0;
+      continue;
+    }
+
+    if (col > (LINE_LEN - 4))
+    {
+      fputs("=\r\n", fp);
+      col = 0;
+    }
+
+    if (r < 7)
+    {
+      fprintf(fp, "=%02X", 0x80 + (rand() % 0x80));
+      col += 3;
+    }
+    else if (r < 20)
+    {
+      fputc(' ', fp);
+      col++;
+    }
+    else
+    {
+      fputc('a' + (rand() % 26), fp);
+      col++;
+    }
+  }
+  fputs("\r\n", fp);
+}
+
+/**
+ * bench_decode - Decode an attachment and report the throughput
+ * @param name     Name of the encoding
+ * @param encoding Encoding, e.g. #ENC_BASE64
+ * @param size     Size of the decoded data
+ */
+static void bench_decode(const char *name, enum ContentEncoding encoding, size_t size)
+{
+  FILE *fp_in = tmpfile();
+  FILE *fp_out = fopen("/dev/null", "w");
+  if (!fp_in || !fp_out)
+  {
+    perror("handler-bench");
+    exit(1);
+  }
+
+  if (encoding == ENC_BASE64)
+    write_base64(fp_in, size);
+  else
+    write_quoted(fp_in, size);
+
+  struct Body *b = mutt_body_new();
+  b->type = TYPE_APPLICATION;
+  b->subtype = mutt_str_dup("octet-stream");
+  b->disposition = DISP_ATTACH;
+  b->encoding = encoding;
+  b->offset = 0;
+  b->length = ftell(fp_in);
+
+  double secs = 0;
+  for (int i = 0; i < BENCH_RUNS; i++)
+  {
+    struct State state = { 0 };
+    state.fp_in = fp_in;
+    state.fp_out = fp_out;
+
+    const double start = bench_now();
+    mutt_decode_attachment(b, &state);
+    const double run = bench_now() - start;
+    if ((i == 0) || (run < secs))
+      secs = run;
+  }
+
+  printf("  %-17s %8.1f ms %8.1f MB/s\n", name, secs * 1000, (b->length / secs) / 1e6);
+
+  mutt_body_free(&b);
+  fclose(fp_in);
+  fclose(fp_out);
+}
+
+/**
+ * main - Benchmark the decoders
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments: the sizes to test, in megabytes
+ * @retval 0 Success
+ */
+int main(int argc, char *argv[])
+{
+  static const size_t DefaultSizes[] = { 1, 16, 64 };
+
+  MuttLogger = log_disp_null;
+  struct ConfigSet *cs = cs_new(16);
+  NeoMutt = neomutt_new(cs);
+  init_config(cs);
+  OptNoCurses = true;
+
+  const int num = (argc > 1) ? (argc - 1) : mutt_array_size(DefaultSizes);
+  for (int i = 0; i < num; i++)
+  {
+    const size_t mb = (argc > 1) ? strtoul(argv[i + 1], NULL, 10) : DefaultSizes[i];
+    printf("\n%zu MB\n", mb);
+
+    srand(42);
+    bench_decode("base64", ENC_BASE64, mb * 1024 * 1024);
+    bench_decode("quoted-printable", ENC_QUOTED_PRINTABLE, mb * 1024 * 1024);
+  }
+
+  neomutt_free(&NeoMutt);
+  cs_free(&cs);
+  return 0;
+}
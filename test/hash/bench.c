@@ -0,0 +1,151 @@
+/**
+ * @file
+ * Benchmark the Hash Table
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Measure the throughput of the Hash Table, for string and integer keys.
+ *
+ * Usage: hash-bench [NUM_KEYS...]
+ *
+ * By default, tables of 10k, 100k, 1M and 10M keys are tested.
+ * Each table starts small, as mutt_hash_new(100) would, so the cost of growing
+ * is included in the insert times.
+ *
+ * The string keys look like Message-IDs.
+ */
+
+#include "config.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "mutt/lib.h"
+#include "bench.h"
+
+/// Length of each generated key, including the NUL
+#define KEY_LEN 32
+
+/**
+ * bench_string - Benchmark a Hash Table with string keys
+ * @param num Number of keys
+ * @retval num Checksum, to stop the work being optimised away
+ */
+static size_t bench_string(size_t num)
+{
+  char *keys = mutt_mem_malloc(num * KEY_LEN);
+  for (size_t i = 0; i < num; i++)
+  {
+    snprintf(keys + (i * KEY_LEN), KEY_LEN, "%08x.%u@example.com",
+             (unsigned int) (i * 2654435761U), (unsigned int) i);
+  }
+
+  size_t sum = 0;
+  printf("string keys: %zu\n", num);
+
+  struct HashTable *table = mutt_hash_new(100, MUTT_HASH_NO_FLAGS);
+  double start = bench_now();
+  for (size_t i = 0; i < num; i++)
+    mutt_hash_insert(table, keys + (i * KEY_LEN), keys);
+  bench_report("insert", num, "Mops/s", start);
+
+  start = bench_now();
+  for (size_t i = 0; i < num; i++)
+    sum += (mutt_hash_find(table, keys + (i * KEY_LEN)) != NULL);
+  bench_report("find", num, "Mops/s", start);
+
+  char miss[64] = { 0 };
+  start = bench_now();
+  for (size_t i = 0; i < num; i++)
+  {
+    snprintf(miss, sizeof(miss), "%08zx.%zu@example.org", i, i);
+    sum += (mutt_hash_find(table, miss) != NULL);
+  }
+  bench_report("find (miss)", num, "Mops/s", start);
+
+  start = bench_now();
+  for (size_t i = 0; i < num; i++)
+    mutt_hash_delete(table, keys + (i * KEY_LEN), NULL);
+  bench_report("delete", num, "Mops/s", start);
+
+  mutt_hash_free(&table);
+  FREE(&keys);
+  return sum;
+}
+
+/**
+ * bench_int - Benchmark a Hash Table with integer keys
+ * @param num Number of keys
+ * @retval num Checksum, to stop the work being optimised away
+ *
+ * The keys are ascending, like IMAP UIDs.
+ */
+static size_t bench_int(size_t num)
+{
+  size_t sum = 0;
+  printf("integer keys: %zu\n", num);
+
+  struct HashTable *table = mutt_hash_int_new(100, MUTT_HASH_NO_FLAGS);
+  double start = bench_now();
+  for (size_t i = 0; i < num; i++)
+    mutt_hash_int_insert(table, i + 1, table);
+  bench_report("insert", num, "Mops/s", start);
+
+  start = bench_now();
+  for (size_t i = 0; i < num; i++)
+    sum += (mutt_hash_int_find(table, i + 1) != NULL);
+  bench_report("find", num, "Mops/s", start);
+
+  start = bench_now();
+  for (size_t i = 0; i < num; i++)
+    mutt_hash_int_delete(table, i + 1, NULL);
+  bench_report("delete", num, "Mops/s", start);
+
+  mutt_hash_free(&table);
+  return sum;
+}
+
+/**
+ * main - Benchmark the Hash Table
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments: the number of keys to test
+ * @retval 0 Success
+ */
+int main(int argc, char *argv[])
+{
+  static const size_t defaults[] = { 10000, 100000, 1000000, 10000000 };
+  size_t sum = 0;
+
+  if (argc > 1)
+  {
+    for (int i = 1; i < argc; i++)
+    {
+      const size_t num = strtoul(argv[i], NULL, 10);
+      sum += bench_string(num) + bench_int(num);
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < mutt_array_size(defaults); i++)
+      sum += bench_string(defaults[i]) + bench_int(defaults[i]);
+  }
+
+  printf("checksum: %zu\n", sum);
+  return 0;
+}
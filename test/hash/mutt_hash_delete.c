@@ -24,6 +24,8 @@
 #include "config.h"
 #include "acutest.h"
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include "mutt/lib.h"
 
 void test_mutt_hash_delete(void)
@@ -61,4 +63,75 @@ void test_mutt_hash_delete(void)
     mutt_hash_delete(table, "banana", NULL);
     mutt_hash_free(&table);
   }
+
+  {
+    // Deleting keys mustn't hide the keys that collided with them
+    struct HashTable *table = mutt_hash_new(10, MUTT_HASH_STRDUP_KEYS);
+    char key[32] = { 0 };
+    for (int i = 0; i < 5000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      mutt_hash_insert(table, key, (void *) (intptr_t) i);
+    }
+
+    for (int i = 0; i < 5000; i += 3)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      mutt_hash_delete(table, key, NULL);
+    }
+
+    for (int i = 0; i < 5000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      TEST_CASE(key);
+      if ((i % 3) == 0)
+        TEST_CHECK(mutt_hash_find(table, key) == NULL);
+      else
+        TEST_CHECK(mutt_hash_find(table, key) == (void *) (intptr_t) i);
+    }
+    TEST_CHECK(table->num_keys == 3333);
+    mutt_hash_free(&table);
+  }
+
+  {
+    // Only the matching duplicate is removed
+    struct HashTable *table = mutt_hash_new(10, MUTT_HASH_ALLOW_DUPS);
+    mutt_hash_insert(table, "apple", &dummy1);
+    mutt_hash_insert(table, "apple", &dummy2);
+    mutt_hash_delete(table, "apple", &dummy2);
+    TEST_CHECK(mutt_hash_find(table, "apple") == &dummy1);
+    mutt_hash_delete(table, "apple", &dummy1);
+    TEST_CHECK(mutt_hash_find(table, "apple") == NULL);
+    TEST_CHECK(table->num_keys == 0);
+    mutt_hash_free(&table);
+  }
+
+  {
+    // Deleting a missing key leaves the table intact
+    struct HashTable *table = mutt_hash_new(10, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_insert(table, "a", &dummy1);
+    mutt_hash_delete(table, "b", NULL);
+    mutt_hash_delete(table, "c", NULL);
+    mutt_hash_delete(table, "a", &dummy2);
+    TEST_CHECK(table->num_keys == 1);
+    TEST_CHECK(mutt_hash_find(table, "a") == &dummy1);
+
+    char key[32] = { 0 };
+    for (int i = 0; i < 1000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      mutt_hash_insert(table, key, (void *) (intptr_t) i);
+    }
+    TEST_CHECK(table->num_keys == 1001);
+
+    for (int i = 0; i < 1000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      TEST_CASE(key);
+      TEST_CHECK(mutt_hash_find(table, key) == (void *) (intptr_t) i);
+    }
+    TEST_CHECK(mutt_hash_find(table, "a") == &dummy1);
+    TEST_CHECK(mutt_hash_find(table, "b") == NULL);
+    mutt_hash_free(&table);
+  }
 }
@@ -25,6 +25,7 @@
 #include "acutest.h"
 #include <stddef.h>
 #include "mutt/lib.h"
+#include "test_common.h"
 
 void test_mutt_hash_find_bucket(void)
 {
@@ -50,7 +51,14 @@ void test_mutt_hash_find_bucket(void)
     mutt_hash_insert(table, "banana", &dummy2);
     mutt_hash_insert(table, "banana", &dummy3);
     mutt_hash_insert(table, "cherry", &dummy3);
-    mutt_hash_find_bucket(table, "banana");
+    struct HashElem *he = mutt_hash_find_bucket(table, "banana");
+    int count = 0;
+    for (; he; he = he->next)
+    {
+      TEST_CHECK_STR_EQ(he->key.strkey, "banana");
+      count++;
+    }
+    TEST_CHECK(count == 3);
     mutt_hash_free(&table);
   }
 }
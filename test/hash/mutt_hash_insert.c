@@ -24,6 +24,8 @@
 #include "config.h"
 #include "acutest.h"
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include "mutt/lib.h"
 
 void test_mutt_hash_insert(void)
@@ -51,4 +53,30 @@ void test_mutt_hash_insert(void)
     TEST_CHECK(mutt_hash_insert(table, "", NULL) != NULL);
     mutt_hash_free(&table);
   }
+
+  {
+    // The table grows as it fills
+    struct HashTable *table = mutt_hash_new(10, MUTT_HASH_STRDUP_KEYS);
+    char key[32] = { 0 };
+    for (int i = 0; i < 10000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      TEST_CHECK(mutt_hash_insert(table, key, (void *) (intptr_t) i) != NULL);
+    }
+    TEST_CHECK(table->num_keys == 10000);
+    TEST_CHECK((table->num_elems & (table->num_elems - 1)) == 0);
+    TEST_CHECK((table->num_keys * 4) <= (table->num_elems * 3));
+
+    for (int i = 0; i < 10000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      TEST_CASE(key);
+      TEST_CHECK(mutt_hash_find(table, key) == (void *) (intptr_t) i);
+    }
+
+    // Duplicates are refused
+    TEST_CHECK(mutt_hash_insert(table, "key42", NULL) == NULL);
+    TEST_CHECK(table->num_keys == 10000);
+    mutt_hash_free(&table);
+  }
 }
@@ -78,6 +78,10 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_write_list)                             \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_write_wrap)                             \
                                                                                \
+  /* alias */                                                                  \
+  NEOMUTT_TEST_ITEM(test_alias_names_lookup)                                   \
+  NEOMUTT_TEST_ITEM(test_alias_names_prefix)                                   \
+                                                                               \
   /* array */                                                                  \
   NEOMUTT_TEST_ITEM(test_mutt_array_api)                                       \
                                                                                \
@@ -95,6 +99,9 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_b64_decode)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_b64_encode)                                      \
                                                                                \
+  /* bcache */                                                                 \
+  NEOMUTT_TEST_ITEM(test_mutt_bcache)                                          \
+                                                                               \
   /* body */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_body_cmp_strict)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_body_free)                                       \
@@ -215,6 +222,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_buf_mktemp_full)                                      \
   NEOMUTT_TEST_ITEM(test_config_cache)                                         \
   NEOMUTT_TEST_ITEM(test_dispatcher_get_retval_name)                           \
+  NEOMUTT_TEST_ITEM(test_flag_index)                                           \
   NEOMUTT_TEST_ITEM(test_mutt_file_mkstemp_full)                               \
                                                                                \
   /* date */                                                                   \
@@ -337,6 +345,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_expando_parser)                                       \
   NEOMUTT_TEST_ITEM(test_expando_parse_short_name)                             \
   NEOMUTT_TEST_ITEM(test_expando_percent_sign_text)                            \
+  NEOMUTT_TEST_ITEM(test_expando_program)                                      \
   NEOMUTT_TEST_ITEM(test_expando_simple_expando)                               \
   NEOMUTT_TEST_ITEM(test_expando_simple_expando_render)                        \
   NEOMUTT_TEST_ITEM(test_expando_simple_text)                                  \
@@ -523,6 +532,10 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_mem_malloc)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_mem_realloc)                                     \
                                                                                \
+  /* ncrypt */                                                                 \
+  NEOMUTT_TEST_ITEM(test_pgp_keyring_select)                                   \
+  NEOMUTT_TEST_ITEM(test_pgp_parse_keys)                                       \
+                                                                               \
   /* neomutt */                                                                \
   NEOMUTT_TEST_ITEM(test_neomutt_account_add)                                  \
   NEOMUTT_TEST_ITEM(test_neomutt_account_remove)                               \
@@ -539,6 +552,9 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_notify_send)                                          \
   NEOMUTT_TEST_ITEM(test_notify_set_parent)                                    \
                                                                                \
+  /* pager */                                                                  \
+  NEOMUTT_TEST_ITEM(test_lindex)                                               \
+                                                                               \
   /* parameter */                                                              \
   NEOMUTT_TEST_ITEM(test_mutt_param_cmp_strict)                                \
   NEOMUTT_TEST_ITEM(test_mutt_param_delete)                                    \
@@ -569,8 +585,10 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_path_to_absolute)                                \
                                                                                \
   /* pattern */                                                                \
+  NEOMUTT_TEST_ITEM(test_mutt_pattern_alias_exec)                              \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_comp)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_leak)                                    \
+  NEOMUTT_TEST_ITEM(test_mutt_pattern_worker)                                  \
                                                                                \
   /* prex */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_prex_capture)                                    \
@@ -633,6 +651,7 @@ void test_fini(void);
                                                                                \
   /* sort */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_qsort_r)                                         \
+  NEOMUTT_TEST_ITEM(test_mutt_radix_sort)                                      \
                                                                                \
   /* string */                                                                 \
   NEOMUTT_TEST_ITEM(test_mutt_istr_equal)                                      \
@@ -697,7 +716,10 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_url_pct_decode)                                       \
   NEOMUTT_TEST_ITEM(test_url_pct_encode)                                       \
   NEOMUTT_TEST_ITEM(test_url_tobuffer)                                         \
-  NEOMUTT_TEST_ITEM(test_url_tostring)
+  NEOMUTT_TEST_ITEM(test_url_tostring)                                         \
+                                                                               \
+  /* worker */                                                                 \
+  NEOMUTT_TEST_ITEM(test_mutt_worker_run)
 
 /******************************************************************************
  * You probably don't need to touch what follows.
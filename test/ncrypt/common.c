@@ -0,0 +1,69 @@
+/**
+ * @file
+ * Common code for the PGP tests
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "ncrypt/pgplib.h"
+#include "common.h"
+#include "test_common.h"
+
+/// Output of `gpg --with-colons --list-keys`: two keys, the first with a subkey
+const char *TestKeyListing =
+    "pub:u:255:22:1111111111111111:1600000000:::u:::scESC::::::ed25519:::0:\n"
+    "fpr:::::::::AAAAAAAAAAAAAAAAAAAAAAAA1111111111111111:\n"
+    "uid:u::::1600000000::HASH1::Alice Example <alice@example.com>::::::::::0:\n"
+    "sub:u:255:18:2222222222222222:1600000000::::::e::::::cv25519::\n"
+    "fpr:::::::::BBBBBBBBBBBBBBBBBBBBBBBB2222222222222222:\n"
+    "pub:f:2048:1:3333333333333333:1600000000:::f:::scESC:::\n"
+    "fpr:::::::::CCCCCCCCCCCCCCCCCCCCCCCC3333333333333333:\n"
+    "uid:f::::1600000000::HASH2::Bob Builder <bob@example.org>::::::::::0:\n"
+    "uid:f::::1600000000::HASH3::bob@work.example.net::::::::::0:\n";
+
+static struct ConfigDef PgpVars[] = {
+  // clang-format off
+  { "pgp_ignore_subkeys", DT_BOOL, true, 0, NULL },
+  { NULL },
+  // clang-format on
+};
+
+bool test_pgp_init(void)
+{
+  if (cs_get_elem(NeoMutt->sub->cs, "pgp_ignore_subkeys"))
+    return true;
+
+  MuttLogger = log_disp_null;
+  return cs_register_variables(NeoMutt->sub->cs, PgpVars);
+}
+
+size_t test_pgp_count_keys(struct PgpKeyInfo *keys)
+{
+  size_t count = 0;
+  for (; keys; keys = keys->next)
+    count++;
+  return count;
+}
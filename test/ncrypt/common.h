@@ -0,0 +1,36 @@
+/**
+ * @file
+ * Common code for the PGP tests
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_NCRYPT_COMMON_H
+#define TEST_NCRYPT_COMMON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+struct PgpKeyInfo;
+
+extern const char *TestKeyListing;
+
+bool   test_pgp_init      (void);
+size_t test_pgp_count_keys(struct PgpKeyInfo *keys);
+
+#endif /* TEST_NCRYPT_COMMON_H */
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * Test code for pgp_keyring_select()
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "ncrypt/pgpkeyring.h"
+#include "ncrypt/pgplib.h"
+#include "common.h"
+#include "list/common.h"
+#include "test_common.h"
+
+/**
+ * select_keys - Find the keys matching some hints
+ * @param kr    Keyring
+ * @param items Hints, NULL-terminated
+ * @param ids   Expected key ids, space-separated
+ * @retval true The keys match
+ */
+static bool select_keys(struct PgpKeyring *kr, const char *items[], const char *ids)
+{
+  struct ListHead hints = test_list_create(items, true);
+  struct PgpKeyInfo *keys = pgp_keyring_select(kr, &hints);
+
+  struct Buffer *buf = buf_pool_get();
+  for (struct PgpKeyInfo *k = keys; k; k = k->next)
+  {
+    if (!buf_is_empty(buf))
+      buf_addch(buf, ' ');
+    buf_addstr(buf, k->keyid);
+  }
+
+  const bool rc = mutt_str_equal(buf_string(buf), ids);
+  TEST_MSG("Expected: '%s'", ids);
+  TEST_MSG("Actual  : '%s'", buf_string(buf));
+
+  buf_pool_release(&buf);
+  pgp_key_free(&keys);
+  mutt_list_free(&hints);
+  return rc;
+}
+
+void test_pgp_keyring_select(void)
+{
+  // struct PgpKeyring *pgp_keyring_new   (const char *text, size_t len);
+  // struct PgpKeyInfo *pgp_keyring_select(struct PgpKeyring *kr, struct ListHead *hints);
+  // void               pgp_keyring_free  (struct PgpKeyring **ptr);
+
+  if (!TEST_CHECK(test_pgp_init()))
+    return;
+
+  const char *alice = "1111111111111111";
+  const char *bob = "3333333333333333";
+  const char *both = "1111111111111111 3333333333333333";
+
+  {
+    pgp_keyring_free(NULL);
+    struct PgpKeyring *kr = NULL;
+    pgp_keyring_free(&kr);
+  }
+
+  {
+    struct PgpKeyring *kr = pgp_keyring_new("", 0);
+    const char *items[] = { NULL };
+    TEST_CHECK(select_keys(kr, items, ""));
+    pgp_keyring_free(&kr);
+    TEST_CHECK(kr == NULL);
+  }
+
+  struct PgpKeyring *kr = pgp_keyring_new(TestKeyListing, mutt_str_len(TestKeyListing));
+  if (!TEST_CHECK(kr != NULL))
+    return;
+
+  {
+    // No hints match everything
+    const char *items[] = { NULL };
+    TEST_CHECK(select_keys(kr, items, both));
+  }
+
+  {
+    // Email addresses
+    const char *items1[] = { "alice@example.com", NULL };
+    TEST_CHECK(select_keys(kr, items1, alice));
+    const char *items2[] = { "ALICE@Example.COM", NULL };
+    TEST_CHECK(select_keys(kr, items2, alice));
+    const char *items3[] = { "bob@work.example.net", NULL };
+    TEST_CHECK(select_keys(kr, items3, bob));
+    const char *items4[] = { "nobody@example.com", NULL };
+    TEST_CHECK(select_keys(kr, items4, ""));
+  }
+
+  {
+    // Key ids and fingerprints, of keys and subkeys
+    const char *items1[] = { "3333333333333333", NULL };
+    TEST_CHECK(select_keys(kr, items1, bob));
+    const char *items2[] = { "0x33333333", NULL };
+    TEST_CHECK(select_keys(kr, items2, bob));
+    const char *items3[] = { "CCCCCCCCCCCCCCCCCCCCCCCC3333333333333333", NULL };
+    TEST_CHECK(select_keys(kr, items3, bob));
+    const char *items4[] = { "2222222222222222", NULL };
+    TEST_CHECK(select_keys(kr, items4, alice));
+    const char *items5[] = { "bbbbbbbbbbbbbbbbbbbbbbbb2222222222222222", NULL };
+    TEST_CHECK(select_keys(kr, items5, alice));
+    const char *items6[] = { "4444444444444444", NULL };
+    TEST_CHECK(select_keys(kr, items6, ""));
+  }
+
+  {
+    // Parts of the user ids
+    const char *items1[] = { "builder", NULL };
+    TEST_CHECK(select_keys(kr, items1, bob));
+    const char *items2[] = { "example", NULL };
+    TEST_CHECK(select_keys(kr, items2, both));
+    const char *items3[] = { "carol", NULL };
+    TEST_CHECK(select_keys(kr, items3, ""));
+  }
+
+  {
+    // A key matches if any hint does
+    const char *items[] = { "alice@example.com", "Builder", "carol", NULL };
+    TEST_CHECK(select_keys(kr, items, both));
+  }
+
+  pgp_keyring_free(&kr);
+}
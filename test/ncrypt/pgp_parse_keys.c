@@ -0,0 +1,118 @@
+/**
+ * @file
+ * Test code for pgp_parse_keys()
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "ncrypt/gnupgparse.h"
+#include "ncrypt/pgplib.h"
+#include "common.h"
+#include "test_common.h"
+
+/**
+ * find_uid - Does a key have a user id?
+ */
+static bool find_uid(struct PgpKeyInfo *k, const char *addr)
+{
+  for (struct PgpUid *uid = k->address; uid; uid = uid->next)
+  {
+    if (mutt_str_equal(uid->addr, addr))
+      return true;
+  }
+  return false;
+}
+
+void test_pgp_parse_keys(void)
+{
+  // struct PgpKeyInfo *pgp_parse_keys(const char *text, size_t len);
+
+  if (!TEST_CHECK(test_pgp_init()))
+    return;
+
+  {
+    TEST_CHECK(pgp_parse_keys(NULL, 0) == NULL);
+    TEST_CHECK(pgp_parse_keys("", 0) == NULL);
+    TEST_CHECK(pgp_parse_keys("bogus:line\n", 11) == NULL);
+  }
+
+  {
+    // The subkeys are merged into their principal keys
+    struct PgpKeyInfo *keys = pgp_parse_keys(TestKeyListing, mutt_str_len(TestKeyListing));
+    TEST_CHECK(test_pgp_count_keys(keys) == 2);
+
+    struct PgpKeyInfo *k = keys;
+    if (TEST_CHECK(k != NULL))
+    {
+      TEST_CHECK_STR_EQ(k->keyid, "1111111111111111");
+      TEST_CHECK_STR_EQ(k->fingerprint, "AAAAAAAAAAAAAAAAAAAAAAAA1111111111111111");
+      TEST_CHECK(k->keylen == 255);
+      TEST_CHECK(k->gen_time == 1600000000);
+      TEST_CHECK(find_uid(k, "Alice Example <alice@example.com>"));
+      TEST_CHECK(k->flags & KEYFLAG_CANENCRYPT);
+      TEST_CHECK(k->flags & KEYFLAG_CANSIGN);
+      k = k->next;
+    }
+
+    if (TEST_CHECK(k != NULL))
+    {
+      TEST_CHECK_STR_EQ(k->keyid, "3333333333333333");
+      TEST_CHECK_STR_EQ(k->fingerprint, "CCCCCCCCCCCCCCCCCCCCCCCC3333333333333333");
+      TEST_CHECK(k->keylen == 2048);
+      TEST_CHECK(find_uid(k, "Bob Builder <bob@example.org>"));
+      TEST_CHECK(find_uid(k, "bob@work.example.net"));
+      TEST_CHECK(!(k->flags & KEYFLAG_SUBKEY));
+    }
+
+    pgp_key_free(&keys);
+  }
+
+  {
+    // The subkeys are listed separately
+    cs_str_native_set(NeoMutt->sub->cs, "pgp_ignore_subkeys", false, NULL);
+    struct PgpKeyInfo *keys = pgp_parse_keys(TestKeyListing, mutt_str_len(TestKeyListing));
+    TEST_CHECK(test_pgp_count_keys(keys) == 3);
+
+    struct PgpKeyInfo *sub = keys ? keys->next : NULL;
+    if (TEST_CHECK(sub != NULL))
+    {
+      TEST_CHECK_STR_EQ(sub->keyid, "2222222222222222");
+      TEST_CHECK(sub->flags & KEYFLAG_SUBKEY);
+      TEST_CHECK(sub->parent == keys);
+      TEST_CHECK(find_uid(sub, "Alice Example <alice@example.com>"));
+    }
+
+    pgp_key_free(&keys);
+    cs_str_reset(NeoMutt->sub->cs, "pgp_ignore_subkeys", NULL);
+  }
+
+  {
+    // A listing without a trailing newline
+    const size_t len = mutt_str_len(TestKeyListing) - 1;
+    struct PgpKeyInfo *keys = pgp_parse_keys(TestKeyListing, len);
+    TEST_CHECK(test_pgp_count_keys(keys) == 2);
+    pgp_key_free(&keys);
+  }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file
+ * Test code for the Pager's LineIndex
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdio.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "pager/lindex.h"
+#include "test_common.h"
+
+static FILE *file_with(const char *text)
+{
+  FILE *fp = tmpfile();
+  if (!fp)
+    return NULL;
+  fputs(text, fp);
+  rewind(fp);
+  return fp;
+}
+
+void test_lindex(void)
+{
+  // struct LineIndex *lindex_new(FILE *fp);
+  // void lindex_free(struct LineIndex **ptr);
+  // int lindex_find(struct LineIndex *li, LOFF_T offset);
+  // int lindex_plain_width(const struct LineIndex *li, int line);
+
+  {
+    TEST_CHECK(lindex_new(NULL) == NULL);
+    lindex_free(NULL);
+    TEST_CHECK(lindex_find(NULL, 0) == -1);
+    TEST_CHECK(lindex_plain_width(NULL, 0) == -1);
+  }
+
+  {
+    FILE *fp = file_with("");
+    struct LineIndex *li = lindex_new(fp);
+    TEST_CHECK(li != NULL);
+    TEST_CHECK(li->num_lines == 0);
+    TEST_CHECK(lindex_find(li, 0) == -1);
+    TEST_CHECK(lindex_plain_width(li, 0) == -1);
+    lindex_free(&li);
+    TEST_CHECK(li == NULL);
+    fclose(fp);
+  }
+
+  {
+    // Lines that straddle the 8-byte words, with and without a final newline
+    const char *text = "apple\n"
+                       "\n"
+                       "a long line of plain text\n"
+                       "tab\there\n"
+                       "caf\xc3\xa9\n"
+                       "cr\r\n"
+                       "no newline";
+    FILE *fp = file_with(text);
+    fseek(fp, 7, SEEK_SET);
+
+    struct LineIndex *li = lindex_new(fp);
+    TEST_CHECK(li != NULL);
+    TEST_CHECK(ftell(fp) == 7);
+    TEST_CHECK(li->num_lines == 7);
+    TEST_CHECK(!li->last_nl);
+
+    static const LOFF_T offsets[] = { 0, 6, 7, 33, 42, 48, 52, 62 };
+    for (int i = 0; i < mutt_array_size(offsets); i++)
+    {
+      TEST_CHECK(li->offsets[i] == offsets[i]);
+      TEST_MSG("line %d: expected %lld, got %lld", i, offsets[i], li->offsets[i]);
+    }
+
+    TEST_CHECK(lindex_plain_width(li, 0) == 5);
+    TEST_CHECK(lindex_plain_width(li, 1) == 0);
+    TEST_CHECK(lindex_plain_width(li, 2) == 25);
+    TEST_CHECK(lindex_plain_width(li, 3) == -1);
+    TEST_CHECK(lindex_plain_width(li, 4) == -1);
+    TEST_CHECK(lindex_plain_width(li, 5) == -1);
+    TEST_CHECK(lindex_plain_width(li, 6) == 10);
+    TEST_CHECK(lindex_plain_width(li, 7) == -1);
+
+    TEST_CHECK(lindex_find(li, 0) == 0);
+    TEST_CHECK(lindex_find(li, 6) == 1);
+    TEST_CHECK(lindex_find(li, 7) == 2);
+    TEST_CHECK(lindex_find(li, 52) == 6);
+    TEST_CHECK(lindex_find(li, 33) == 3);
+    TEST_CHECK(lindex_find(li, 8) == -1);
+    TEST_CHECK(lindex_find(li, 62) == -1);
+
+    lindex_free(&li);
+    fclose(fp);
+  }
+
+  {
+    // Lines that straddle the blocks read from the file
+    FILE *fp = tmpfile();
+    TEST_CHECK(fp != NULL);
+    char line[128];
+    memset(line, 'x', sizeof(line));
+    line[sizeof(line) - 1] = '\n';
+    const int count = 2000;
+    for (int i = 0; i < count; i++)
+    {
+      const size_t len = (i % 100) + 1;
+      fwrite(line + sizeof(line) - len, 1, len, fp);
+    }
+
+    struct LineIndex *li = lindex_new(fp);
+    TEST_CHECK(li != NULL);
+    TEST_CHECK(li->num_lines == count);
+    TEST_CHECK(li->last_nl);
+
+    LOFF_T offset = 0;
+    bool ok = true;
+    for (int i = 0; i < count; i++)
+    {
+      ok &= (li->offsets[i] == offset);
+      ok &= (lindex_find(li, offset) == i);
+      ok &= (lindex_plain_width(li, i) == (i % 100));
+      offset += (i % 100) + 1;
+    }
+    TEST_CHECK(ok);
+    TEST_CHECK(li->offsets[count] == offset);
+
+    lindex_free(&li);
+    fclose(fp);
+  }
+}
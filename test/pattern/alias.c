@@ -0,0 +1,79 @@
+/**
+ * @file
+ * Test code for matching Patterns against Aliases
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include "mutt/lib.h"
+#include "alias/alias.h" // IWYU pragma: keep
+#include "alias/gui.h"   // IWYU pragma: keep
+#include "pattern/lib.h"
+#include "test_common.h"
+
+static bool alias_matches(struct AliasView *av, const char *str)
+{
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, str, MUTT_PC_NO_FLAGS, err);
+  TEST_CHECK(pat != NULL);
+  TEST_MSG("%s: %s", str, buf_string(err));
+  buf_pool_release(&err);
+  if (!pat)
+    return false;
+
+  bool rc = mutt_pattern_alias_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, av, NULL);
+  mutt_pattern_free(&pat);
+  return rc;
+}
+
+void test_mutt_pattern_alias_exec(void)
+{
+  // bool mutt_pattern_alias_exec(struct Pattern *pat, PatternExecFlags flags, struct AliasView *av, struct PatternCache *cache);
+
+  MuttLogger = log_disp_null;
+
+  struct Alias alias = { 0 };
+  TAILQ_INIT(&alias.addr);
+  STAILQ_INIT(&alias.tags);
+  alias.name = "bob";
+  alias.comment = "builder";
+
+  struct AliasView av = { 0 };
+  av.alias = &alias;
+
+  {
+    TEST_CHECK(alias_matches(&av, "~f bob"));
+    TEST_CHECK(!alias_matches(&av, "~f alice"));
+    TEST_CHECK(alias_matches(&av, "~c builder"));
+    TEST_CHECK(alias_matches(&av, "~f bob ~c builder"));
+  }
+
+  {
+    // These are folded into a constant
+    TEST_CHECK(alias_matches(&av, "~A"));
+    TEST_CHECK(alias_matches(&av, "~f alice | ~A"));
+    TEST_CHECK(alias_matches(&av, "~A | ~f alice"));
+    TEST_CHECK(!alias_matches(&av, "!~A"));
+    TEST_CHECK(!alias_matches(&av, "~f bob !~A"));
+    TEST_CHECK(!alias_matches(&av, "!(~f alice | ~A)"));
+  }
+}
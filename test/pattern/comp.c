@@ -720,5 +720,82 @@ void test_mutt_pattern_comp(void)
     mutt_pattern_free(&pat);
   }
 
+  { /* cheap patterns are moved first */
+    char *s = "=b foo =s bar ~N";
+
+    buf_reset(err);
+    struct PatternList *pat = mutt_pattern_comp(NULL, NULL, s, MUTT_PC_FULL_MSG, err);
+    TEST_CHECK(pat != NULL);
+
+    struct Pattern *root = SLIST_FIRST(pat);
+    TEST_CHECK(root->op == MUTT_PAT_AND);
+    struct Pattern *np = SLIST_FIRST(root->child);
+    TEST_CHECK(np->op == MUTT_NEW);
+    np = SLIST_NEXT(np, entries);
+    TEST_CHECK((np->op == MUTT_PAT_SUBJECT) && mutt_str_equal(np->p.str, "bar"));
+    np = SLIST_NEXT(np, entries);
+    TEST_CHECK((np->op == MUTT_PAT_BODY) && mutt_str_equal(np->p.str, "foo"));
+    TEST_CHECK(SLIST_NEXT(np, entries) == NULL);
+
+    mutt_pattern_free(&pat);
+  }
+
+  { /* nested lists are merged */
+    char *s = "=s foo (=s bar =s quux)";
+
+    buf_reset(err);
+    struct PatternList *pat = mutt_pattern_comp(NULL, NULL, s, 0, err);
+    TEST_CHECK(pat != NULL);
+
+    struct Pattern *root = SLIST_FIRST(pat);
+    TEST_CHECK(root->op == MUTT_PAT_AND);
+    int count = 0;
+    struct Pattern *np = NULL;
+    SLIST_FOREACH(np, root->child, entries)
+    {
+      TEST_CHECK(np->op == MUTT_PAT_SUBJECT);
+      count++;
+    }
+    TEST_CHECK(count == 3);
+
+    mutt_pattern_free(&pat);
+  }
+
+  { /* constants are folded */
+    static const struct
+    {
+      const char *str;
+      short op;
+      bool pat_not;
+    } tests[] = {
+      // clang-format off
+      { "~A =s foo",           MUTT_PAT_SUBJECT, false },
+      { "=s foo | ~A",         MUTT_ALL,         false },
+      { "!~A =s foo",          MUTT_ALL,         true  },
+      { "!(~A =s foo) | ~A",   MUTT_ALL,         false },
+      { "!(=s foo | ~A)",      MUTT_ALL,         true  },
+      { "!(=s foo ~A)",        MUTT_PAT_AND,     true  },
+      { "~(~A =s foo)",        MUTT_PAT_THREAD,  false },
+      // clang-format on
+    };
+
+    for (size_t i = 0; i < mutt_array_size(tests); i++)
+    {
+      TEST_CASE(tests[i].str);
+      buf_reset(err);
+      struct PatternList *pat = mutt_pattern_comp(NULL, NULL, tests[i].str, 0, err);
+      TEST_CHECK(pat != NULL);
+
+      struct Pattern *root = SLIST_FIRST(pat);
+      TEST_CHECK(root->op == tests[i].op);
+      TEST_CHECK(root->pat_not == tests[i].pat_not);
+      TEST_CHECK(SLIST_NEXT(root, entries) == NULL);
+      if (root->op == MUTT_ALL)
+        TEST_CHECK(root->child == NULL);
+
+      mutt_pattern_free(&pat);
+    }
+  }
+
   buf_pool_release(&err);
 }
@@ -0,0 +1,184 @@
+/**
+ * @file
+ * Test code for matching Patterns in worker threads
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#include "pattern/private.h" // IWYU pragma: keep
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "thorough_search", DT_BOOL, false, 0, NULL },
+  { NULL },
+  // clang-format on
+};
+
+static const char *Head = "From: alice@example.com\n"
+                          "Subject: hello\n"
+                          "\n";
+static const char *Text = "apple\n"
+                          "banana\n";
+
+static struct PatternList *compile(const char *str)
+{
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, str, MUTT_PC_FULL_MSG, err);
+  TEST_CHECK(pat != NULL);
+  TEST_MSG("%s: %s", str, buf_string(err));
+  buf_pool_release(&err);
+  return pat;
+}
+
+static bool is_thread_safe(struct Mailbox *m, const char *str)
+{
+  struct PatternList *pat = compile(str);
+  bool rc = pattern_is_thread_safe(m, SLIST_FIRST(pat));
+  mutt_pattern_free(&pat);
+  return rc;
+}
+
+static int exec_worker(struct Mailbox *m, struct Email *e, const char *str)
+{
+  struct PatternList *pat = compile(str);
+  struct PatternCache cache = { 0 };
+  int rc = pattern_exec_worker(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, &cache);
+  mutt_pattern_free(&pat);
+  return rc;
+}
+
+static bool msg_wanted(struct Mailbox *m, struct Email *e, const char *str)
+{
+  struct PatternList *pat = compile(str);
+  bool rc = pattern_msg_wanted(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e);
+  mutt_pattern_free(&pat);
+  return rc;
+}
+
+void test_mutt_pattern_worker(void)
+{
+  // bool pattern_is_thread_safe(const struct Mailbox *m, const struct Pattern *pat);
+  // int  pattern_exec_worker(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m, struct Email *e, struct PatternCache *cache);
+  // bool pattern_msg_wanted(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m, struct Email *e);
+
+  MuttLogger = log_disp_null;
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+
+  // Create a Maildir with one message
+  char dir[] = "/tmp/neomutt-worker-XXXXXX";
+  if (!TEST_CHECK(mkdtemp(dir) != NULL))
+    return;
+
+  char path[PATH_MAX] = { 0 };
+  snprintf(path, sizeof(path), "%s/cur", dir);
+  TEST_CHECK(mkdir(path, 0700) == 0);
+  snprintf(path, sizeof(path), "%s/cur/1:2,", dir);
+  FILE *fp = fopen(path, "w");
+  if (!TEST_CHECK(fp != NULL))
+    return;
+  fputs(Head, fp);
+  fputs(Text, fp);
+  fclose(fp);
+
+  struct Mailbox *m = mailbox_new();
+  m->type = MUTT_MAILDIR;
+  buf_strcpy(&m->pathbuf, dir);
+
+  struct Email *e = email_new();
+  e->path = mutt_str_dup("cur/1:2,");
+  e->env = mutt_env_new();
+  *(char **) &e->env->subject = mutt_str_dup("hello");
+  e->body = mutt_body_new();
+  e->body->offset = mutt_str_len(Head);
+  e->body->length = mutt_str_len(Text);
+
+  {
+    TEST_CHECK(is_thread_safe(m, "~b apple"));
+    TEST_CHECK(is_thread_safe(m, "~h hello"));
+    TEST_CHECK(is_thread_safe(m, "~N ~b apple | ~s hello"));
+    TEST_CHECK(!is_thread_safe(m, "~(~b apple)"));
+    TEST_CHECK(!is_thread_safe(m, "~v"));
+    TEST_CHECK(!is_thread_safe(m, "~l"));
+
+    cs_str_native_set(NeoMutt->sub->cs, "thorough_search", true, NULL);
+    TEST_CHECK(!is_thread_safe(m, "~b apple"));
+    TEST_CHECK(is_thread_safe(m, "~s hello"));
+    cs_str_native_set(NeoMutt->sub->cs, "thorough_search", false, NULL);
+
+    m->type = MUTT_MBOX;
+    TEST_CHECK(!is_thread_safe(m, "~b apple"));
+    m->type = MUTT_MAILDIR;
+  }
+
+  {
+    TEST_CHECK(exec_worker(m, e, "~b apple") == 1);
+    TEST_CHECK(exec_worker(m, e, "~b cherry") == 0);
+    TEST_CHECK(exec_worker(m, e, "~b hello") == 0);
+    TEST_CHECK(exec_worker(m, e, "~h hello") == 1);
+    TEST_CHECK(exec_worker(m, e, "~h banana") == 0);
+    TEST_CHECK(exec_worker(m, e, "~B banana") == 1);
+    TEST_CHECK(exec_worker(m, e, "!~b apple") == 0);
+    TEST_CHECK(exec_worker(m, e, "~s hello ~b banana") == 1);
+  }
+
+  {
+    // A cheap Pattern decides whether the Message is needed
+    e->read = true;
+    TEST_CHECK(msg_wanted(m, e, "~b apple"));
+    TEST_CHECK(!msg_wanted(m, e, "~N ~b apple"));
+    TEST_CHECK(!msg_wanted(m, e, "~R | ~b apple"));
+    TEST_CHECK(msg_wanted(m, e, "~N | ~b apple"));
+    TEST_CHECK(!msg_wanted(m, e, "~s hello"));
+    TEST_CHECK(exec_worker(m, e, "~N ~b apple") == 0);
+
+    e->read = false;
+    TEST_CHECK(msg_wanted(m, e, "~N ~b apple"));
+    TEST_CHECK(exec_worker(m, e, "~N ~b apple") == 1);
+  }
+
+  {
+    // A missing file is left for the main thread
+    FREE(&e->path);
+    e->path = mutt_str_dup("cur/2:2,");
+    TEST_CHECK(exec_worker(m, e, "~b apple") == -1);
+    TEST_CHECK(exec_worker(m, e, "~s hello") == 1);
+  }
+
+  email_free(&e);
+  mailbox_free(&m);
+
+  unlink(path);
+  snprintf(path, sizeof(path), "%s/cur", dir);
+  rmdir(path);
+  rmdir(dir);
+}
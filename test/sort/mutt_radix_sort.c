@@ -0,0 +1,104 @@
+/**
+ * @file
+ * Test code for mutt_radix_sort()
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+struct Record
+{
+  int id;
+  uint64_t key;
+};
+
+void test_mutt_radix_sort(void)
+{
+  // void mutt_radix_sort(void *base, size_t nmemb, size_t size, size_t offset, bool reverse);
+
+  {
+    struct Record r = { 0, 42 };
+    mutt_radix_sort(NULL, 5, sizeof(r), offsetof(struct Record, key), false);
+    mutt_radix_sort(&r, 1, sizeof(r), offsetof(struct Record, key), false);
+    TEST_CHECK((r.id == 0) && (r.key == 42));
+  }
+
+  // Reverse order input
+  {
+    struct Record recs[300];
+    for (int i = 0; i < 300; i++)
+    {
+      recs[i].id = i;
+      recs[i].key = (uint64_t) (299 - i) << 20;
+    }
+
+    mutt_radix_sort(recs, 300, sizeof(struct Record), offsetof(struct Record, key), false);
+    for (int i = 0; i < 300; i++)
+    {
+      TEST_CASE_("%d", i);
+      TEST_CHECK(recs[i].key == ((uint64_t) i << 20));
+      TEST_CHECK(recs[i].id == (299 - i));
+    }
+  }
+
+  // Equal keys keep their order, in both directions
+  {
+    static const uint64_t keys[] = { 5, UINT64_MAX, 0, 5, 1700000000, 0, 5, UINT64_MAX, 1700000000, 5 };
+    const int num = mutt_array_size(keys);
+
+    for (int reverse = 0; reverse < 2; reverse++)
+    {
+      struct Record recs[10];
+      for (int i = 0; i < num; i++)
+      {
+        recs[i].id = i;
+        recs[i].key = keys[i];
+      }
+
+      mutt_radix_sort(recs, num, sizeof(struct Record),
+                      offsetof(struct Record, key), reverse);
+
+      for (int i = 1; i < num; i++)
+      {
+        TEST_CASE_("reverse %d, %d", reverse, i);
+        if (reverse)
+          TEST_CHECK(recs[i - 1].key >= recs[i].key);
+        else
+          TEST_CHECK(recs[i - 1].key <= recs[i].key);
+        if (recs[i - 1].key == recs[i].key)
+          TEST_CHECK(recs[i - 1].id < recs[i].id);
+      }
+    }
+  }
+
+  // All keys the same
+  {
+    struct Record recs[4] = { { 0, 7 }, { 1, 7 }, { 2, 7 }, { 3, 7 } };
+    mutt_radix_sort(recs, 4, sizeof(struct Record), offsetof(struct Record, key), true);
+    for (int i = 0; i < 4; i++)
+      TEST_CHECK(recs[i].id == i);
+  }
+}
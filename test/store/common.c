@@ -70,6 +70,12 @@ bool test_store_degenerate(const struct StoreOps *store_ops, const char *name)
   if (!TEST_CHECK(store_ops->delete_record(NULL, NULL, 0) != 0))
     return false;
 
+  if (!TEST_CHECK(store_ops->begin_batch(NULL) != 0))
+    return false;
+
+  if (!TEST_CHECK(store_ops->commit_batch(NULL) != 0))
+    return false;
+
   store_ops->close(NULL);
   TEST_CHECK_(1, "store_ops->close(NULL)");
 
@@ -106,6 +112,36 @@ bool test_store_db(const struct StoreOps *store_ops, StoreHandle *store_handle)
   store_ops->free(store_handle, &data);
   TEST_CHECK_(1, "store_ops->free(store_handle, &data)");
 
+  rc = store_ops->delete_record(store_handle, key, klen);
+  if (!TEST_CHECK_NUM_EQ(rc, 0))
+    return false;
+
+  // Writes inside a batch are visible before, and after, the commit
+  rc = store_ops->begin_batch(store_handle);
+  if (!TEST_CHECK_NUM_EQ(rc, 0))
+    return false;
+
+  vlen = strlen(value);
+  rc = store_ops->store(store_handle, key, klen, value, vlen);
+  if (!TEST_CHECK_NUM_EQ(rc, 0))
+    return false;
+
+  vlen = 0;
+  data = store_ops->fetch(store_handle, key, klen, &vlen);
+  if (!TEST_CHECK(data != NULL))
+    return false;
+  store_ops->free(store_handle, &data);
+
+  rc = store_ops->commit_batch(store_handle);
+  if (!TEST_CHECK_NUM_EQ(rc, 0))
+    return false;
+
+  vlen = 0;
+  data = store_ops->fetch(store_handle, key, klen, &vlen);
+  if (!TEST_CHECK(data != NULL))
+    return false;
+  store_ops->free(store_handle, &data);
+
   rc = store_ops->delete_record(store_handle, key, klen);
   if (!TEST_CHECK_NUM_EQ(rc, 0))
     return false;
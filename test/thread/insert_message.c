@@ -51,4 +51,20 @@ void test_insert_message(void)
     insert_message(&tnew, &newparent, NULL);
     TEST_CHECK_(1, "insert_message(&tnew, &newparent, NULL)");
   }
+
+  {
+    struct MuttThread root = { 0 };
+    struct MuttThread parent = { 0 };
+    struct MuttThread cur = { 0 };
+    insert_message(&root.child, &root, &parent);
+    root.sort_dirty = false;
+    parent.sort_dirty = false;
+
+    insert_message(&parent.child, &parent, &cur);
+    TEST_CHECK(parent.child == &cur);
+    TEST_CHECK(cur.parent == &parent);
+    TEST_CHECK(cur.sort_dirty);
+    TEST_CHECK(parent.sort_dirty);
+    TEST_CHECK(root.sort_dirty);
+  }
 }
@@ -0,0 +1,66 @@
+/**
+ * @file
+ * Test code for mutt_worker_run()
+ *
+ * @authors
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+
+static void square_job(size_t index, void *data)
+{
+  size_t *results = data;
+  results[index] += index * index;
+}
+
+void test_mutt_worker_run(void)
+{
+  // void mutt_worker_run(size_t count, int threads, worker_job_t job, void *data);
+
+  {
+    mutt_worker_run(10, 4, NULL, NULL);
+    TEST_CHECK_(1, "mutt_worker_run(10, 4, NULL, NULL)");
+  }
+
+  {
+    size_t results[1] = { 42 };
+    mutt_worker_run(0, 4, square_job, results);
+    TEST_CHECK(results[0] == 42);
+  }
+
+  static const int threads[] = { -1, 0, 1, 2, 4, 8, 1000 };
+  for (size_t t = 0; t < mutt_array_size(threads); t++)
+  {
+    TEST_CASE_("threads = %d", threads[t]);
+
+    size_t results[1000] = { 0 };
+    mutt_worker_run(mutt_array_size(results), threads[t], square_job, results);
+
+    size_t bad = 0;
+    for (size_t i = 0; i < mutt_array_size(results); i++)
+    {
+      if (results[i] != (i * i))
+        bad++;
+    }
+    TEST_CHECK(bad == 0);
+  }
+}